@@ -215,7 +215,10 @@ int
 orc_array_compare (OrcArray *array1, OrcArray *array2, int flags)
 {
   if ((flags & ORC_TEST_FLAGS_FLOAT)) {
-    if (array1->element_size == 4) {
+    if (array1->element_size == 4 ||
+        (array1->element_size == 8 && (flags & ORC_TEST_FLAGS_COMPLEX))) {
+      /* complex values are compared as their two float parts */
+      int n = array1->n * (array1->element_size / 4);
       int j;
       for(j=0;j<array1->m;j++){
         float *a, *b;
@@ -224,10 +227,10 @@ orc_array_compare (OrcArray *array1, OrcArray *array2, int flags)
         a = ORC_PTR_OFFSET (array1->data, j*array1->stride);
         b = ORC_PTR_OFFSET (array2->data, j*array2->stride);
 
-        for (i=0;i<array1->n;i++){
+        for (i=0;i<n;i++){
           if (isnan(a[i]) && isnan(b[i])) continue;
           if (a[i] == b[i]) continue;
-          if ((a[i] < 0.0) == (b[i] < 0.0) && (*(orc_uint32 *)&a[i] - *(orc_uint32 *)&b[i]) <= 2) continue;
+          if ((a[i] < 0.0) == (b[i] < 0.0) && (orc_uint32)(*(orc_uint32 *)&a[i] - *(orc_uint32 *)&b[i] + 2) <= 4) continue;
           return FALSE;
         }
       }
@@ -244,11 +247,26 @@ orc_array_compare (OrcArray *array1, OrcArray *array2, int flags)
         for (i=0;i<array1->n;i++){
           if (isnan(a[i]) && isnan(b[i])) continue;
           if (a[i] == b[i]) continue;
-          if ((a[i] < 0.0) == (b[i] < 0.0) && (*(orc_uint64 *)&a[i] - *(orc_uint64 *)&b[i]) <= 2) continue;
+          if ((a[i] < 0.0) == (b[i] < 0.0) && (orc_uint64)(*(orc_uint64 *)&a[i] - *(orc_uint64 *)&b[i] + 2) <= 4) continue;
           return FALSE;
         }
       }
       return TRUE;
+    } else if (array1->element_size == 2) {
+      /* half and bfloat16 results, including NaNs, must match exactly */
+      int j;
+      for(j=0;j<array1->m;j++){
+        orc_uint16 *a, *b;
+        int i;
+
+        a = ORC_PTR_OFFSET (array1->data, j*array1->stride);
+        b = ORC_PTR_OFFSET (array2->data, j*array2->stride);
+
+        for (i=0;i<array1->n;i++){
+          if (a[i] != b[i]) return FALSE;
+        }
+      }
+      return TRUE;
     }
   } else {
     if (memcmp (array1->aligned_data, array2->aligned_data,
@@ -489,12 +489,15 @@ print_array_val_hex (OrcArray *array, int i, int j)
 }
 
 static void
-print_array_val_float (OrcArray *array, int i, int j)
+print_array_val_float (OrcArray *array, int i, int j, int flags)
 {
   void *ptr = ORC_PTR_OFFSET (array->data,
       i*array->element_size + j*array->stride);
 
   switch (array->element_size) {
+    case 2:
+      printf(" %04x", *(orc_uint16 *)ptr);
+      break;
     case 4:
       if (isnan(*(float *)ptr)) {
         printf(" nan %08x", *(orc_uint32 *)ptr);
@@ -503,7 +506,11 @@ print_array_val_float (OrcArray *array, int i, int j)
       }
       break;
     case 8:
-      printf(" %12.5g", *(double *)ptr);
+      if (flags & ORC_TEST_FLAGS_COMPLEX) {
+        printf(" %12.5g %12.5g", ((float *)ptr)[0], ((float *)ptr)[1]);
+      } else {
+        printf(" %12.5g", *(double *)ptr);
+      }
       break;
     default:
       printf(" ERROR");
@@ -511,7 +518,7 @@ print_array_val_float (OrcArray *array, int i, int j)
 }
 
 int
-float_compare (OrcArray *array1, OrcArray *array2, int i, int j)
+float_compare (OrcArray *array1, OrcArray *array2, int i, int j, int flags)
 {
   void *ptr1 = ORC_PTR_OFFSET (array1->data,
       i*array1->element_size + j*array1->stride);
@@ -519,20 +526,85 @@ float_compare (OrcArray *array1, OrcArray *array2, int i, int j)
       i*array2->element_size + j*array2->stride);
 
   switch (array1->element_size) {
+    case 2:
+      return (*(orc_uint16 *)ptr1 == *(orc_uint16 *)ptr2);
     case 4:
       if (isnan(*(float *)ptr1) && isnan(*(float *)ptr2)) return TRUE;
       if (*(float *)ptr1 == *(float *)ptr2) return TRUE;
-      if ((*(float *)ptr1 < 0.0) == (*(float *)ptr2 < 0.0) && (*(orc_uint32 *)ptr1 - *(orc_uint32 *)ptr2) <= 2) return TRUE;
+      if ((*(float *)ptr1 < 0.0) == (*(float *)ptr2 < 0.0) && (orc_uint32)(*(orc_uint32 *)ptr1 - *(orc_uint32 *)ptr2 + 2) <= 4) return TRUE;
       return FALSE;
     case 8:
+      if (flags & ORC_TEST_FLAGS_COMPLEX) {
+        /* the real and imaginary parts are floats */
+        float *a = ptr1, *b = ptr2;
+        int k;
+
+        for(k=0;k<2;k++){
+          if (isnan(a[k]) && isnan(b[k])) continue;
+          if (a[k] == b[k]) continue;
+          if ((a[k] < 0.0) == (b[k] < 0.0) && (orc_uint32)(((orc_uint32 *)a)[k] - ((orc_uint32 *)b)[k] + 2) <= 4) continue;
+          return FALSE;
+        }
+        return TRUE;
+      }
       if (isnan(*(double *)ptr1) && isnan(*(double *)ptr2)) return TRUE;
       if (*(double *)ptr1 == *(double *)ptr2) return TRUE;
-      if ((*(double *)ptr1 < 0.0) == (*(double *)ptr2 < 0.0) && (*(orc_uint64 *)ptr1 - *(orc_uint64 *)ptr2) <= 2) return TRUE;
+      if ((*(double *)ptr1 < 0.0) == (*(double *)ptr2 < 0.0) && (orc_uint64)(*(orc_uint64 *)ptr1 - *(orc_uint64 *)ptr2 + 2) <= 4) return TRUE;
       return FALSE;
   }
   return FALSE;
 }
 
+static int
+is_transposed (OrcProgram *program, int var)
+{
+  int i;
+
+  if (program->vars[var].transposed) return TRUE;
+  for(i=0;i<program->n_insns;i++){
+    if (strncmp (program->insns[i].opcode->name, "loadtr", 6) == 0 &&
+        program->insns[i].src_args[0] == var) return TRUE;
+  }
+  return FALSE;
+}
+
+/* element-strided arrays hold (n-1)*stride+1 elements per row,
+ * transposed ones m elements in each of n rows */
+static int
+get_array_n (OrcProgram *program, int var, int n, int m)
+{
+  if (program->vars[var].element_stride > 1) {
+    return n * program->vars[var].element_stride;
+  }
+  if (is_transposed (program, var)) {
+    return MAX(n, m);
+  }
+  return n;
+}
+
+static int
+get_array_m (OrcProgram *program, int var, int n, int m)
+{
+  if (is_transposed (program, var)) {
+    return MAX(n, m);
+  }
+  return m;
+}
+
+/* an in-place source is read from its destination, which starts out
+ * holding the source data */
+static void
+copy_array_data (OrcArray *dest, OrcArray *src)
+{
+  int j;
+
+  for(j=0;j<dest->m;j++){
+    memcpy (ORC_PTR_OFFSET (dest->data, dest->stride * j),
+        ORC_PTR_OFFSET (src->data, src->stride * j),
+        dest->n * dest->element_size);
+  }
+}
+
 OrcTestResult
 orc_test_compare_output (OrcProgram *program)
 {
@@ -587,6 +659,12 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
     }
   }
 
+  for(i=0;i<program->n_insns;i++){
+    if (program->insns[i].opcode->flags & ORC_STATIC_OPCODE_COMPLEX) {
+      flags |= ORC_TEST_FLAGS_COMPLEX;
+    }
+  }
+
   if (program->constant_n > 0) {
     n = program->constant_n;
   } else {
@@ -611,17 +689,22 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
   for(i=0;i<ORC_N_VARIABLES;i++){
     if (program->vars[i].name == NULL) continue;
 
+    if (program->vars[i].ring) {
+      /* wraps once, a third of the way in */
+      orc_executor_set_ring (ex, i, n, n / 3);
+    }
     if (program->vars[i].vartype == ORC_VAR_TYPE_SRC) {
-      src[i-ORC_VAR_S1] = orc_array_new (n, m, program->vars[i].size,
-          misalignment, program->vars[i].alignment);
+      src[i-ORC_VAR_S1] = orc_array_new (get_array_n (program, i, n, m),
+          get_array_m (program, i, n, m),
+          program->vars[i].size, misalignment, program->vars[i].alignment);
       orc_array_set_random (src[i-ORC_VAR_S1], &rand_context);
       misalignment++;
     } else if (program->vars[i].vartype == ORC_VAR_TYPE_DEST) {
-      dest_exec[i-ORC_VAR_D1] = orc_array_new (n, m, program->vars[i].size,
-          misalignment, program->vars[i].alignment);
+      dest_exec[i-ORC_VAR_D1] = orc_array_new (get_array_n (program, i, n, m), m,
+          program->vars[i].size, misalignment, program->vars[i].alignment);
       orc_array_set_pattern (dest_exec[i], ORC_OOB_VALUE);
-      dest_emul[i-ORC_VAR_D1] = orc_array_new (n, m, program->vars[i].size,
-          misalignment, program->vars[i].alignment);
+      dest_emul[i-ORC_VAR_D1] = orc_array_new (get_array_n (program, i, n, m), m,
+          program->vars[i].size, misalignment, program->vars[i].alignment);
       orc_array_set_pattern (dest_emul[i], ORC_OOB_VALUE);
       misalignment++;
     } else if (program->vars[i].vartype == ORC_VAR_TYPE_PARAM) {
@@ -642,13 +725,26 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
     }
   }
 
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    if (program->vars[i].inplace) {
+      int d = program->vars[i].inplace_dest - ORC_VAR_D1;
+      copy_array_data (dest_exec[d], src[i-ORC_VAR_S1]);
+      copy_array_data (dest_emul[d], src[i-ORC_VAR_S1]);
+    }
+  }
+
   for(i=0;i<ORC_N_VARIABLES;i++){
     if (program->vars[i].vartype == ORC_VAR_TYPE_DEST) {
       orc_executor_set_array (ex, i, dest_exec[i-ORC_VAR_D1]->data);
       orc_executor_set_stride (ex, i, dest_exec[i-ORC_VAR_D1]->stride);
       have_dest = TRUE;
     }
-    if (program->vars[i].vartype == ORC_VAR_TYPE_SRC) {
+    if (program->vars[i].vartype == ORC_VAR_TYPE_SRC &&
+        program->vars[i].inplace) {
+      int d = program->vars[i].inplace_dest - ORC_VAR_D1;
+      orc_executor_set_array (ex, i, dest_exec[d]->data);
+      orc_executor_set_stride (ex, i, dest_exec[d]->stride);
+    } else if (program->vars[i].vartype == ORC_VAR_TYPE_SRC) {
       orc_executor_set_array (ex, i, src[i-ORC_VAR_S1]->data);
       orc_executor_set_stride (ex, i, src[i-ORC_VAR_S1]->stride);
     }
@@ -672,7 +768,12 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
       orc_executor_set_array (ex, i, dest_emul[i]->data);
       orc_executor_set_stride (ex, i, dest_emul[i]->stride);
     }
-    if (program->vars[i].vartype == ORC_VAR_TYPE_SRC) {
+    if (program->vars[i].vartype == ORC_VAR_TYPE_SRC &&
+        program->vars[i].inplace) {
+      int d = program->vars[i].inplace_dest - ORC_VAR_D1;
+      orc_executor_set_array (ex, i, dest_emul[d]->data);
+      orc_executor_set_stride (ex, i, dest_emul[d]->stride);
+    } else if (program->vars[i].vartype == ORC_VAR_TYPE_SRC) {
       ORC_DEBUG("setting array %p", src[i-ORC_VAR_S1]->data);
       orc_executor_set_array (ex, i, src[i-ORC_VAR_S1]->data);
       orc_executor_set_stride (ex, i, src[i-ORC_VAR_S1]->stride);
@@ -710,7 +811,7 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
         for(l=ORC_VAR_S1;l<ORC_VAR_S1+8;l++){
           if (program->vars[l].size > 0) {
             if (flags & ORC_TEST_FLAGS_FLOAT) {
-              print_array_val_float (src[l-ORC_VAR_S1], i, j);
+              print_array_val_float (src[l-ORC_VAR_S1], i, j, flags);
             } else {
               print_array_val_hex (src[l-ORC_VAR_S1], i, j);
             }
@@ -721,9 +822,9 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
         for(l=ORC_VAR_D1;l<ORC_VAR_D1+4;l++){
           if (program->vars[l].size > 0) {
             if (flags & ORC_TEST_FLAGS_FLOAT) {
-              print_array_val_float (dest_emul[l-ORC_VAR_D1], i, j);
-              print_array_val_float (dest_exec[l-ORC_VAR_D1], i, j);
-              if (!float_compare (dest_emul[l-ORC_VAR_D1], dest_exec[l-ORC_VAR_D1], i, j)) {
+              print_array_val_float (dest_emul[l-ORC_VAR_D1], i, j, flags);
+              print_array_val_float (dest_exec[l-ORC_VAR_D1], i, j, flags);
+              if (!float_compare (dest_emul[l-ORC_VAR_D1], dest_exec[l-ORC_VAR_D1], i, j, flags)) {
                 line_bad = TRUE;
               }
             } else {
@@ -759,7 +860,7 @@ orc_test_compare_output_full (OrcProgram *program, int flags)
             if (program->vars[k].vartype == ORC_VAR_TYPE_SRC &&
                 program->vars[k].size > 0) {
               if (flags & ORC_TEST_FLAGS_FLOAT) {
-                print_array_val_float (src[k-ORC_VAR_S1], i, j);
+                print_array_val_float (src[k-ORC_VAR_S1], i, j, flags);
               } else {
                 print_array_val_signed (src[k-ORC_VAR_S1], i, j);
               }
@@ -834,6 +935,10 @@ orc_test_get_program_for_opcode (OrcStaticOpcode *opcode)
       orc_program_add_source (p, opcode->src_size[0], "s1");
     args[n_args++] =
       orc_program_add_source (p, opcode->src_size[1], "s2");
+    if (opcode->src_size[2] != 0) {
+      args[n_args++] =
+        orc_program_add_source (p, opcode->src_size[2], "s3");
+    }
   }
 
   if ((opcode->flags & ORC_STATIC_OPCODE_FLOAT_SRC) ||
@@ -1012,17 +1117,22 @@ orc_test_performance_full (OrcProgram *program, int flags,
   for(i=0;i<ORC_N_VARIABLES;i++){
     if (program->vars[i].name == NULL) continue;
 
+    if (program->vars[i].ring) {
+      /* wraps once, a third of the way in */
+      orc_executor_set_ring (ex, i, n, n / 3);
+    }
     if (program->vars[i].vartype == ORC_VAR_TYPE_SRC) {
-      src[i-ORC_VAR_S1] = orc_array_new (n, m, program->vars[i].size,
-          misalignment, program->vars[i].alignment);
+      src[i-ORC_VAR_S1] = orc_array_new (get_array_n (program, i, n, m),
+          get_array_m (program, i, n, m),
+          program->vars[i].size, misalignment, program->vars[i].alignment);
       orc_array_set_random (src[i-ORC_VAR_S1], &rand_context);
       misalignment++;
     } else if (program->vars[i].vartype == ORC_VAR_TYPE_DEST) {
-      dest_exec[i-ORC_VAR_D1] = orc_array_new (n, m, program->vars[i].size,
-          misalignment, program->vars[i].alignment);
+      dest_exec[i-ORC_VAR_D1] = orc_array_new (get_array_n (program, i, n, m), m,
+          program->vars[i].size, misalignment, program->vars[i].alignment);
       orc_array_set_pattern (dest_exec[i], ORC_OOB_VALUE);
-      dest_emul[i-ORC_VAR_D1] = orc_array_new (n, m, program->vars[i].size,
-          misalignment, program->vars[i].alignment);
+      dest_emul[i-ORC_VAR_D1] = orc_array_new (get_array_n (program, i, n, m), m,
+          program->vars[i].size, misalignment, program->vars[i].alignment);
       orc_array_set_pattern (dest_emul[i], ORC_OOB_VALUE);
       misalignment++;
     } else if (program->vars[i].vartype == ORC_VAR_TYPE_PARAM) {
@@ -1030,6 +1140,13 @@ orc_test_performance_full (OrcProgram *program, int flags,
     }
   }
 
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    if (program->vars[i].inplace) {
+      copy_array_data (dest_exec[program->vars[i].inplace_dest - ORC_VAR_D1],
+          src[i-ORC_VAR_S1]);
+    }
+  }
+
   ORC_DEBUG ("running");
   orc_profile_init (&prof);
   for(i=0;i<10;i++){
@@ -1040,7 +1157,12 @@ orc_test_performance_full (OrcProgram *program, int flags,
         orc_executor_set_array (ex, j, dest_exec[j-ORC_VAR_D1]->data);
         orc_executor_set_stride (ex, j, dest_exec[j-ORC_VAR_D1]->stride);
       }
-      if (program->vars[j].vartype == ORC_VAR_TYPE_SRC) {
+      if (program->vars[j].vartype == ORC_VAR_TYPE_SRC &&
+          program->vars[j].inplace) {
+        int d = program->vars[j].inplace_dest - ORC_VAR_D1;
+        orc_executor_set_array (ex, j, dest_exec[d]->data);
+        orc_executor_set_stride (ex, j, dest_exec[d]->stride);
+      } else if (program->vars[j].vartype == ORC_VAR_TYPE_SRC) {
         orc_executor_set_array (ex, j, src[j-ORC_VAR_S1]->data);
         orc_executor_set_stride (ex, j, src[j-ORC_VAR_S1]->stride);
       }
@@ -149,3 +149,15 @@ UNARY_D(sqrtd, "sqrt(%s)")
 BINARY_DQ(cmpeqd, "(%s == %s) ? ORC_UINT64_C(~0) : 0")
 BINARY_DQ(cmpltd, "(%s < %s) ? ORC_UINT64_C(~0) : 0")
 BINARY_DQ(cmpled, "(%s <= %s) ? ORC_UINT64_C(~0) : 0")
+
+TERNARY_F(fmaf, "fmaf(%s, %s, %s)")
+TERNARY_F(fmsf, "fmaf(%s, %s, -%s)")
+TERNARY_F(fnmaf, "fmaf(-%s, %s, %s)")
+TERNARY_D(fmad, "fma(%s, %s, %s)")
+
+UNARY_F(roundf, "rintf(%s)")
+UNARY_F(floorf, "floorf(%s)")
+UNARY_F(ceilf, "ceilf(%s)")
+UNARY_F(truncf, "truncf(%s)")
+UNARY_F(rcpf, "1.0f / %s")
+UNARY_F(rsqrtf, "1.0f / sqrtf(%s)")
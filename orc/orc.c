@@ -20,6 +20,7 @@
 void _orc_debug_init(void);
 void _orc_once_init(void);
 void _orc_compiler_init(void);
+void _orc_parallel_init(void);
 
 /**
  * orc_init:
@@ -40,6 +41,7 @@ orc_init (void)
 
       _orc_debug_init();
       _orc_compiler_init();
+      _orc_parallel_init();
       orc_opcode_init();
       orc_c_init();
 #ifdef ENABLE_BACKEND_C64X
@@ -100,6 +100,27 @@ orc_bytecode_from_program (OrcProgram *p)
       bytecode_append_int (bytecode, var->alignment);
     }
   }
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    var = &p->vars[i];
+    if (var->size && var->element_stride > 1) {
+      bytecode_append_code (bytecode, ORC_BC_SET_ELEMENT_STRIDE);
+      bytecode_append_int (bytecode, i);
+      bytecode_append_int (bytecode, var->element_stride);
+    }
+    if (var->size && var->transposed) {
+      bytecode_append_code (bytecode, ORC_BC_SET_TRANSPOSED);
+      bytecode_append_int (bytecode, i);
+    }
+    if (var->size && var->ring) {
+      bytecode_append_code (bytecode, ORC_BC_SET_RING);
+      bytecode_append_int (bytecode, i);
+    }
+    if (var->size && var->inplace) {
+      bytecode_append_code (bytecode, ORC_BC_SET_INPLACE);
+      bytecode_append_int (bytecode, var->inplace_dest);
+      bytecode_append_int (bytecode, i);
+    }
+  }
   for(i=0;i<4;i++){
     var = &p->vars[ORC_VAR_A1 + i];
     if (var->size) {
@@ -197,7 +218,8 @@ bytecode_append_byte (OrcBytecode *bytecode, int byte)
 void
 bytecode_append_code (OrcBytecode *bytecode, int code)
 {
-  bytecode_append_byte (bytecode, code);
+  /* opcodes past 254 are escaped like any other int */
+  bytecode_append_int (bytecode, code);
 #if 0
   OrcOpcodeSet *opcode_set = orc_opcode_set_get ("sys");
 
@@ -483,6 +505,30 @@ orc_bytecode_parse_function (OrcProgram *program, const orc_uint8 *bytecode)
         case ORC_BC_INSTRUCTION_FLAGS:
           instruction_flags = orc_bytecode_parse_get_int (parse);
           break;
+        case ORC_BC_SET_ELEMENT_STRIDE:
+          {
+            int var;
+            var = orc_bytecode_parse_get_int (parse);
+            size = orc_bytecode_parse_get_int (parse);
+            orc_program_set_var_element_stride (program, var, size);
+          }
+          break;
+        case ORC_BC_SET_TRANSPOSED:
+          orc_program_set_var_transposed (program,
+              orc_bytecode_parse_get_int (parse));
+          break;
+        case ORC_BC_SET_RING:
+          orc_program_set_var_ring (program,
+              orc_bytecode_parse_get_int (parse));
+          break;
+        case ORC_BC_SET_INPLACE:
+          {
+            int dest;
+            dest = orc_bytecode_parse_get_int (parse);
+            orc_program_set_inplace (program, dest,
+                orc_bytecode_parse_get_int (parse));
+          }
+          break;
         default:
           break;
       }
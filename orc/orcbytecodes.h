@@ -27,10 +27,10 @@ typedef enum {
   ORC_BC_ADD_PARAMETER_DOUBLE,
   ORC_BC_ADD_TEMPORARY,
   ORC_BC_INSTRUCTION_FLAGS,
-  ORC_BC_RESERVED_22,
-  ORC_BC_RESERVED_23,
-  ORC_BC_RESERVED_24,
-  ORC_BC_RESERVED_25,
+  ORC_BC_SET_ELEMENT_STRIDE,
+  ORC_BC_SET_TRANSPOSED,
+  ORC_BC_SET_RING,
+  ORC_BC_SET_INPLACE,
   ORC_BC_RESERVED_26,
   ORC_BC_RESERVED_27,
   ORC_BC_RESERVED_28,
@@ -250,6 +250,81 @@ typedef enum {
   ORC_BC_convld,
   ORC_BC_convfd,
   ORC_BC_convdf,
-  /* 226 */
+  ORC_BC_fmaf,
+  ORC_BC_fmsf,
+  ORC_BC_fnmaf,
+  ORC_BC_fmad,
+  /* 230 */
+  ORC_BC_convhf,
+  ORC_BC_convfh,
+  ORC_BC_convbf,
+  ORC_BC_convfb,
+  ORC_BC_roundf,
+  ORC_BC_floorf,
+  ORC_BC_ceilf,
+  ORC_BC_truncf,
+  ORC_BC_rcpf,
+  ORC_BC_rsqrtf,
+  /* 240 */
+  ORC_BC_expf,
+  ORC_BC_logf,
+  ORC_BC_sinf,
+  ORC_BC_cosf,
+  ORC_BC_powf,
+  ORC_BC_loadch3b,
+  ORC_BC_loadch4b,
+  ORC_BC_loadch3w,
+  ORC_BC_loadch4w,
+  ORC_BC_storech3b,
+  /* 250 */
+  ORC_BC_storech3w,
+  ORC_BC_loadstrb,
+  ORC_BC_loadstrw,
+  ORC_BC_loadstrl,
+  ORC_BC_loadstrq,
+  ORC_BC_storestrb,
+  ORC_BC_storestrw,
+  ORC_BC_storestrl,
+  ORC_BC_storestrq,
+  ORC_BC_scanaddw,
+  /* 260 */
+  ORC_BC_scanaddl,
+  ORC_BC_scanaddf,
+  ORC_BC_maddswl,
+  ORC_BC_maddusbw,
+  ORC_BC_ldresbilinb,
+  ORC_BC_ldresbilinl,
+  ORC_BC_selectb,
+  ORC_BC_selectw,
+  ORC_BC_selectl,
+  ORC_BC_selectf,
+  /* 270 */
+  ORC_BC_selectd,
+  ORC_BC_unpacklb,
+  ORC_BC_unpacklw,
+  ORC_BC_packbl,
+  ORC_BC_packwl,
+  ORC_BC_popcntb,
+  ORC_BC_popcntw,
+  ORC_BC_popcntl,
+  ORC_BC_clzw,
+  ORC_BC_clzl,
+  /* 280 */
+  ORC_BC_bitrevb,
+  ORC_BC_shufflel,
+  ORC_BC_shuffleq,
+  ORC_BC_loadtrb,
+  ORC_BC_loadtrw,
+  ORC_BC_loadtrl,
+  ORC_BC_loadtrq,
+  ORC_BC_findb,
+  ORC_BC_findw,
+  ORC_BC_findl,
+  /* 290 */
+  ORC_BC_mulcf,
+  ORC_BC_mulconjcf,
+  ORC_BC_magsqcf,
+  ORC_BC_matrowlb,
+  /* 294 */
   ORC_BC_LAST
 } OrcBytecodes;
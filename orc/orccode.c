@@ -40,3 +40,57 @@ orc_code_free (OrcCode *code)
 
 
 
+/**
+ * orc_code_run_batch:
+ * @code: the OrcCode
+ * @ex: an #OrcExecutor holding the parameters
+ * @jobs: array of jobs
+ * @n_jobs: number of jobs
+ *
+ * Runs @code once for each job in @jobs.  Each job supplies its own
+ * n and array pointers; parameters are taken from @ex, and are the same
+ * for all jobs.  When the target generated a batch entry point, all
+ * jobs run in a single call, so that constants and loop invariants are
+ * loaded only once.  Otherwise the jobs are run one at a time.
+ *
+ * For two-dimensional code, m and the strides are also taken from @ex.
+ * On return, the accumulators in @ex hold the sum over all jobs.  The
+ * n and array fields of @ex are overwritten.
+ */
+void
+orc_code_run_batch (OrcCode *code, OrcExecutor *ex,
+    const OrcBatchJob *jobs, int n_jobs)
+{
+  unsigned int acc[4] = { 0, 0, 0, 0 };
+  int i, j;
+
+  if (n_jobs <= 0) return;
+
+  ex->arrays[ORC_VAR_A2] = code;
+
+  if (code->exec_batch) {
+    void (*func) (OrcExecutor *, const OrcBatchJob *, int);
+
+    func = (void (*)(OrcExecutor *, const OrcBatchJob *, int))code->exec_batch;
+    func (ex, jobs, n_jobs);
+    return;
+  }
+
+  for(j=0;j<n_jobs;j++){
+    ex->n = jobs[j].n;
+    for(i=0;i<ORC_N_ARRAYS;i++){
+      ex->arrays[ORC_VAR_D1 + i] = jobs[j].arrays[i];
+    }
+    code->exec (ex);
+    for(i=0;i<4;i++){
+      acc[i] += ex->accumulators[i];
+    }
+  }
+
+  for(i=0;i<4;i++){
+    if (code->vars && code->vars[ORC_VAR_A1 + i].size == 2) {
+      acc[i] &= 0xffff;
+    }
+    ex->accumulators[i] = acc[i];
+  }
+}
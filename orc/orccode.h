@@ -17,6 +17,9 @@ struct _OrcCodeVariable {
   int vartype;
   int size;
   orc_union64 value;
+  int ring;
+  int inplace;
+  int inplace_dest;
 };
 
 struct _OrcCode {
@@ -39,6 +42,24 @@ struct _OrcCode {
   int is_2d;
   int constant_n;
   int constant_m;
+
+  void *exec_batch;
+  OrcExecutorFunc exec_serial;
+  int tile_n;
+};
+
+/**
+ * OrcBatchJob:
+ * @n: number of elements to process
+ * @arrays: destination and source pointers, indexed by ORC_VAR_D1
+ *   through ORC_VAR_S8
+ *
+ * One independent call of an #OrcCode, used by orc_code_run_batch().
+ */
+typedef struct _OrcBatchJob OrcBatchJob;
+struct _OrcBatchJob {
+  int n;
+  void *arrays[ORC_N_ARRAYS];
 };
 
 
@@ -47,6 +68,9 @@ ORC_API void orc_code_allocate_codemem (OrcCode *code, int size);
 ORC_API OrcCode * orc_code_new (void);
 ORC_API void      orc_code_free (OrcCode *code);
 
+ORC_API void      orc_code_run_batch (OrcCode *code, OrcExecutor *ex,
+    const OrcBatchJob *jobs, int n_jobs);
+
 ORC_END_DECLS
 
 #endif
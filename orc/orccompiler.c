@@ -39,7 +39,19 @@ static void orc_compiler_rewrite_vars (OrcCompiler *compiler);
 static void orc_compiler_rewrite_vars2 (OrcCompiler *compiler);
 static int orc_compiler_dup_temporary (OrcCompiler *compiler, int var, int j);
 static int orc_compiler_new_temporary (OrcCompiler *compiler, int size);
+static int orc_compiler_new_constant (OrcCompiler *compiler, int size,
+    int value);
 static void orc_compiler_check_sizes (OrcCompiler *compiler);
+static void orc_compiler_choose_tile_n (OrcCompiler *compiler);
+static void orc_compiler_check_transposed (OrcCompiler *compiler);
+static void orc_compiler_check_ring (OrcCompiler *compiler);
+static void orc_compiler_check_inplace (OrcCompiler *compiler);
+static void orc_compiler_check_find (OrcCompiler *compiler);
+static void orc_compiler_check_bilinear (OrcCompiler *compiler);
+static void orc_compiler_group_taps (OrcCompiler *compiler);
+
+void _orc_parallel_setup (OrcCompiler *compiler, OrcCode *code);
+void _orc_ring_setup (OrcCompiler *compiler, OrcCode *code);
 
 static char **_orc_compiler_flag_list;
 int _orc_compiler_flag_backup;
@@ -269,9 +281,27 @@ orc_program_compile_full (OrcProgram *program, OrcTarget *target,
   orc_compiler_rewrite_insns (compiler);
   if (compiler->error) goto error;
 
+  orc_compiler_check_transposed (compiler);
+  if (compiler->error) goto error;
+
+  orc_compiler_check_ring (compiler);
+  if (compiler->error) goto error;
+
+  orc_compiler_check_inplace (compiler);
+  if (compiler->error) goto error;
+
+  orc_compiler_check_find (compiler);
+  if (compiler->error) goto error;
+
+  orc_compiler_check_bilinear (compiler);
+  if (compiler->error) goto error;
+
   orc_compiler_rewrite_vars (compiler);
   if (compiler->error) goto error;
 
+  orc_compiler_choose_tile_n (compiler);
+  orc_compiler_group_taps (compiler);
+
 #if 0
   {
     ORC_ERROR("variables");
@@ -302,6 +332,7 @@ orc_program_compile_full (OrcProgram *program, OrcTarget *target,
   program->orccode->is_2d = program->is_2d;
   program->orccode->constant_n = program->constant_n;
   program->orccode->constant_m = program->constant_m;
+  program->orccode->tile_n = compiler->tile_n;
   program->orccode->exec = program->code_exec;
 
   program->orccode->n_insns = compiler->n_insns;
@@ -316,6 +347,9 @@ orc_program_compile_full (OrcProgram *program, OrcTarget *target,
     program->orccode->vars[i].vartype = compiler->vars[i].vartype;
     program->orccode->vars[i].size = compiler->vars[i].size;
     program->orccode->vars[i].value = compiler->vars[i].value;
+    program->orccode->vars[i].ring = compiler->vars[i].ring;
+    program->orccode->vars[i].inplace = compiler->vars[i].inplace;
+    program->orccode->vars[i].inplace_dest = compiler->vars[i].inplace_dest;
   }
 
   if (program->backup_func && (_orc_compiler_flag_backup || target == NULL)) {
@@ -359,6 +393,10 @@ orc_program_compile_full (OrcProgram *program, OrcTarget *target,
   orc_code_allocate_codemem (program->orccode, program->orccode->code_size);
 
   memcpy (program->orccode->code, compiler->code, program->orccode->code_size);
+  if (compiler->batch_entry > 0) {
+    program->orccode->exec_batch = ORC_PTR_OFFSET(program->orccode->exec,
+        compiler->batch_entry);
+  }
 
 #ifdef VALGRIND_DISCARD_TRANSLATIONS
   VALGRIND_DISCARD_TRANSLATIONS (program->orccode->exec,
@@ -369,6 +407,9 @@ orc_program_compile_full (OrcProgram *program, OrcTarget *target,
     compiler->target->flush_cache (program->orccode);
   }
 
+  _orc_parallel_setup (compiler, program->orccode);
+  _orc_ring_setup (compiler, program->orccode);
+
   program->code_exec = program->orccode->exec;
 
   program->asm_code = compiler->asm_code;
@@ -416,6 +457,143 @@ error:
   return result;
 }
 
+static void
+orc_compiler_choose_tile_n (OrcCompiler *compiler)
+{
+  OrcProgram *program = compiler->program;
+  int element_bytes = 0;
+  int level1;
+  int i;
+
+  compiler->tile_n = 0;
+
+  if (!program->is_2d || program->constant_m == 1) return;
+  if (program->constant_n > 0) return;
+  if (program->tiling == ORC_TILING_NONE) return;
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcStaticOpcode *opcode = compiler->insns[i].opcode;
+
+    /* these depend on the position within the row */
+    if (opcode->flags & ORC_STATIC_OPCODE_ITERATOR) return;
+    /* running sums follow the whole row */
+    if (opcode->flags & ORC_STATIC_OPCODE_SCAN) return;
+    if (strncmp (opcode->name, "ldres", 5) == 0) return;
+    /* strips would have to advance by the element stride */
+    if (strncmp (opcode->name, "loadstr", 7) == 0 ||
+        strncmp (opcode->name, "storestr", 8) == 0) return;
+    /* these read neighboring columns, which may alias another row */
+    if (program->tiling == ORC_TILING_AUTO &&
+        strncmp (opcode->name, "loadoff", 7) == 0) return;
+  }
+
+  if (program->tiling > 0) {
+    compiler->tile_n = program->tiling;
+    return;
+  }
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    /* a transposed source keeps a cache line of each row it reads */
+    if (compiler->vars[i].transposed) {
+      element_bytes += 64;
+      continue;
+    }
+    element_bytes += compiler->vars[i].size;
+  }
+  orc_get_data_cache_sizes (&level1, NULL, NULL);
+  if (element_bytes == 0 || level1 == 0) return;
+
+  /* leave room for the previous row of each array */
+  compiler->tile_n = (level1 / (2 * element_bytes)) & ~63;
+  if (compiler->tile_n < 64) compiler->tile_n = 64;
+}
+
+static int
+get_tap_offset (OrcCompiler *compiler, OrcInstruction *insn, int src,
+    int *offset)
+{
+  const char *name = insn->opcode->name;
+
+  if (insn->src_args[0] != src) return FALSE;
+  if (!(insn->opcode->flags & ORC_STATIC_OPCODE_LOAD)) return FALSE;
+
+  if (strncmp (name, "loadoff", 7) == 0 &&
+      compiler->vars[insn->src_args[1]].vartype == ORC_VAR_TYPE_CONST) {
+    *offset = compiler->vars[insn->src_args[1]].value.i;
+    return TRUE;
+  }
+  if (strcmp (name, "loadb") == 0 || strcmp (name, "loadw") == 0 ||
+      strcmp (name, "loadl") == 0) {
+    *offset = 0;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+/* Three or more loads of one source at nearby constant offsets, by
+ * loadoff or a plain load, are the taps of a filter.  When the target
+ * can shift across a pair of registers, the taps are built from the
+ * vector at the highest offset and the vector below it instead of one
+ * load each.  The pair is kept in two hidden temps, src_args[2] and
+ * src_args[3]; their values hold the lowest and highest offset.  The
+ * vector below is the one at the highest offset in the iteration
+ * before, so src_args[2] is live through the whole loop. */
+static void
+orc_compiler_group_taps (OrcCompiler *compiler)
+{
+  int i;
+  int j;
+
+  if (compiler->tap_window == 0) return;
+
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    OrcVariable *var = compiler->vars + i;
+    int n_taps = 0;
+    int first = 0, last = 0;
+    int min = 0, max = 0;
+    int lo, hi;
+
+    if (var->name == NULL || var->element_stride > 1 ||
+        var->transposed) continue;
+
+    for(j=0;j<compiler->n_insns;j++){
+      int offset;
+
+      if (!get_tap_offset (compiler, compiler->insns + j, i, &offset))
+        continue;
+      if (n_taps == 0) {
+        first = j;
+        min = max = offset;
+      }
+      if (offset < min) min = offset;
+      if (offset > max) max = offset;
+      last = j;
+      n_taps++;
+    }
+    if (n_taps < 3) continue;
+    if ((max - min) * var->size >= compiler->tap_window) continue;
+
+    lo = orc_compiler_new_temporary (compiler, var->size);
+    hi = orc_compiler_new_temporary (compiler, var->size);
+    compiler->vars[lo].first_use = 0;
+    compiler->vars[lo].last_use = compiler->n_insns - 1;
+    compiler->vars[lo].value.i = min;
+    compiler->vars[hi].first_use = first;
+    compiler->vars[hi].last_use = last;
+    compiler->vars[hi].value.i = max;
+
+    for(j=first;j<=last;j++){
+      OrcInstruction *insn = compiler->insns + j;
+      int offset;
+
+      if (!get_tap_offset (compiler, insn, i, &offset)) continue;
+      insn->flags |= ORC_INSN_FLAG_TAP_WINDOW;
+      insn->src_args[2] = lo;
+      insn->src_args[3] = hi;
+    }
+  }
+}
+
 static void
 orc_compiler_check_sizes (OrcCompiler *compiler)
 {
@@ -444,6 +622,11 @@ orc_compiler_check_sizes (OrcCompiler *compiler)
         compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
         return;
       }
+      /* the array side of a store may hold several channels per
+       * element, the vector width follows the register side */
+      if (opcode->flags & ORC_STATIC_OPCODE_STORE) continue;
+      /* nor is the index a find returns */
+      if (opcode->flags & ORC_STATIC_OPCODE_FIND) continue;
       max_size = MAX(max_size, multiplier * opcode->dest_size[j]);
     }
     for(j=0;j<ORC_STATIC_OPCODE_N_SRC;j++){
@@ -466,6 +649,11 @@ orc_compiler_check_sizes (OrcCompiler *compiler)
         compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
         return;
       }
+      /* neither the array of a load nor a broadcast operand, like the
+       * offset of loadoff or the matrix row of matrowlb, is vector data */
+      if (opcode->flags & ORC_STATIC_OPCODE_LOAD && j == 0) continue;
+      if (opcode->flags & ORC_STATIC_OPCODE_SCALAR && j >= 1 &&
+          !(opcode->flags & ORC_STATIC_OPCODE_STORE)) continue;
       max_size = MAX(max_size, multiplier * opcode->src_size[j]);
     }
     if (opcode->flags & ORC_STATIC_OPCODE_SCALAR &&
@@ -535,6 +723,277 @@ get_store_opcode_for_size (int size)
   return NULL;
 }
 
+static OrcStaticOpcode *
+get_strided_opcode (OrcStaticOpcode *opcode, int transposed)
+{
+  static const char *names[][3] = {
+    { "loadb", "loadstrb", "loadtrb" }, { "loadw", "loadstrw", "loadtrw" },
+    { "loadl", "loadstrl", "loadtrl" }, { "loadq", "loadstrq", "loadtrq" },
+    { "storeb", "storestrb", NULL }, { "storew", "storestrw", NULL },
+    { "storel", "storestrl", NULL }, { "storeq", "storestrq", NULL },
+  };
+  int i;
+
+  for(i=0;i<sizeof(names)/sizeof(names[0]);i++){
+    if (strcmp (opcode->name, names[i][0]) == 0) {
+      if (names[i][transposed ? 2 : 1] == NULL) return NULL;
+      return orc_opcode_find_by_name (names[i][transposed ? 2 : 1]);
+    }
+  }
+  return NULL;
+}
+
+/* Loads and stores of element-strided arrays are replaced by loadstr
+ * and storestr, with the stride as a constant in the last source.
+ * Loads of transposed sources are replaced by loadtr. */
+static void
+orc_compiler_stride_insn (OrcCompiler *compiler, OrcInstruction *insn)
+{
+  OrcStaticOpcode *opcode = insn->opcode;
+  OrcStaticOpcode *strided;
+  OrcVariable *var;
+
+  if (opcode->flags & ORC_STATIC_OPCODE_LOAD) {
+    var = compiler->vars + insn->src_args[0];
+  } else if (opcode->flags & ORC_STATIC_OPCODE_STORE) {
+    var = compiler->vars + insn->dest_args[0];
+  } else {
+    return;
+  }
+  if (var->element_stride <= 1 && !var->transposed) return;
+  if (strncmp (opcode->name, "loadstr", 7) == 0 ||
+      strncmp (opcode->name, "storestr", 8) == 0 ||
+      strncmp (opcode->name, "loadtr", 6) == 0) return;
+
+  if (var->transposed && !compiler->program->is_2d) {
+    ORC_COMPILER_ERROR(compiler, "transposed variable %s in 1D program",
+        var->name);
+    compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+    return;
+  }
+
+  strided = get_strided_opcode (opcode, var->transposed);
+  if (strided == NULL) {
+    ORC_COMPILER_ERROR(compiler, "opcode %s not supported on %s "
+        "variable %s at line %d", opcode->name,
+        var->transposed ? "transposed" : "strided", var->name, insn->line);
+    compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+    return;
+  }
+  insn->opcode = strided;
+  if (!var->transposed) {
+    insn->src_args[1] = orc_compiler_new_constant (compiler, 4,
+        var->element_stride);
+  }
+}
+
+/* Sources read with loadtr move one element per row instead of one
+ * stride, so every read of them has to be a loadtr. */
+static void
+orc_compiler_check_transposed (OrcCompiler *compiler)
+{
+  int i;
+  int j;
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+    OrcVariable *var = compiler->vars + insn->src_args[0];
+
+    if (strncmp (insn->opcode->name, "loadtr", 6) != 0) continue;
+    if (var->vartype != ORC_VAR_TYPE_SRC) {
+      orc_compiler_error (compiler, "%s on non-source variable %s",
+          insn->opcode->name, var->name);
+      return;
+    }
+    var->transposed = TRUE;
+  }
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+
+    if (strncmp (insn->opcode->name, "loadtr", 6) == 0) continue;
+    for(j=0;j<ORC_STATIC_OPCODE_N_SRC;j++){
+      OrcVariable *var = compiler->vars + insn->src_args[j];
+
+      if (insn->opcode->src_size[j] == 0) continue;
+      if (var->vartype == ORC_VAR_TYPE_SRC && var->transposed) {
+        orc_compiler_error (compiler, "transposed source %s read by %s",
+            var->name, insn->opcode->name);
+        return;
+      }
+    }
+  }
+}
+
+/* Bilinear loads read the second row one source stride below the
+ * first, and only 2D programs have strides. */
+static void
+orc_compiler_check_bilinear (OrcCompiler *compiler)
+{
+  int i;
+
+  if (compiler->program->is_2d) return;
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+
+    if (strncmp (insn->opcode->name, "ldresbilin", 10) != 0) continue;
+    ORC_COMPILER_ERROR(compiler, "%s in 1D program at line %d",
+        insn->opcode->name, insn->line);
+    compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+    return;
+  }
+}
+
+/* Calls of programs with ring buffers are split where a ring wraps, so
+ * no element may depend on where a call starts, and ring buffers can
+ * only be read and written an element at a time. */
+static void
+orc_compiler_check_ring (OrcCompiler *compiler)
+{
+  int has_ring = FALSE;
+  int i;
+  int j;
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].ring) has_ring = TRUE;
+  }
+  if (!has_ring) return;
+
+  if (compiler->program->is_2d) {
+    ORC_COMPILER_ERROR(compiler, "ring buffer variables in 2D program");
+    compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+    return;
+  }
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+    OrcStaticOpcode *opcode = insn->opcode;
+    int bad = FALSE;
+
+    if (opcode->flags & (ORC_STATIC_OPCODE_ITERATOR|ORC_STATIC_OPCODE_SCAN) ||
+        strncmp (opcode->name, "ldres", 5) == 0) {
+      bad = TRUE;
+    }
+    if (opcode->flags & ORC_STATIC_OPCODE_SCALAR) {
+      for(j=0;j<ORC_STATIC_OPCODE_N_SRC;j++){
+        if (opcode->src_size[j] == 0) continue;
+        if (compiler->vars[insn->src_args[j]].ring) bad = TRUE;
+      }
+      for(j=0;j<ORC_STATIC_OPCODE_N_DEST;j++){
+        if (opcode->dest_size[j] == 0) continue;
+        if (compiler->vars[insn->dest_args[j]].ring) bad = TRUE;
+      }
+    }
+    if (bad) {
+      ORC_COMPILER_ERROR(compiler, "opcode %s not supported in program with "
+          "ring buffers at line %d", opcode->name, insn->line);
+      compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+      return;
+    }
+  }
+}
+
+/* An in-place source shares its array with the destination, so each
+ * element must be read with a plain load before the destination is
+ * stored. */
+static void
+orc_compiler_check_inplace (OrcCompiler *compiler)
+{
+  int stored[ORC_N_COMPILER_VARIABLES] = { 0 };
+  int i;
+  int j;
+
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    OrcVariable *var = compiler->vars + i;
+
+    if (!var->inplace) continue;
+    if (var->element_stride > 1 || var->transposed || var->ring ||
+        compiler->vars[var->inplace_dest].element_stride > 1 ||
+        compiler->vars[var->inplace_dest].ring) {
+      ORC_COMPILER_ERROR(compiler, "in-place variable %s is strided",
+          var->name);
+      compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+      return;
+    }
+  }
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+    OrcStaticOpcode *opcode = insn->opcode;
+
+    for(j=0;j<ORC_STATIC_OPCODE_N_SRC;j++){
+      OrcVariable *var;
+
+      if (opcode->src_size[j] == 0) continue;
+      var = compiler->vars + insn->src_args[j];
+      if (!var->inplace) continue;
+      if (opcode->flags != ORC_STATIC_OPCODE_LOAD ||
+          strncmp (opcode->name, "loadtr", 6) == 0 ||
+          stored[var->inplace_dest]) {
+        ORC_COMPILER_ERROR(compiler, "opcode %s reads in-place variable %s "
+            "out of order at line %d", opcode->name, var->name, insn->line);
+        compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+        return;
+      }
+    }
+    for(j=0;j<ORC_STATIC_OPCODE_N_DEST;j++){
+      if (opcode->dest_size[j] == 0) continue;
+      if (compiler->vars[insn->dest_args[j]].vartype == ORC_VAR_TYPE_DEST) {
+        stored[insn->dest_args[j]] = TRUE;
+      }
+    }
+  }
+}
+
+/* A find stops the loop at its match, so nothing else may depend on
+ * how many elements are processed: no destinations, no other
+ * accumulators, and a single row of elements read in order. */
+static void
+orc_compiler_check_find (OrcCompiler *compiler)
+{
+  int n_find = 0;
+  int i;
+
+  for(i=0;i<compiler->n_insns;i++){
+    if (compiler->insns[i].opcode->flags & ORC_STATIC_OPCODE_FIND) n_find++;
+  }
+  if (n_find == 0) return;
+
+  if (n_find > 1) {
+    ORC_COMPILER_ERROR(compiler, "more than one find opcode in program");
+    compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+    return;
+  }
+  if (compiler->program->is_2d) {
+    ORC_COMPILER_ERROR(compiler, "find opcode in 2D program");
+    compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+    return;
+  }
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].ring) {
+      ORC_COMPILER_ERROR(compiler, "find opcode in program with ring buffers");
+      compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+      return;
+    }
+  }
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+    OrcStaticOpcode *opcode = insn->opcode;
+
+    if ((opcode->flags & ORC_STATIC_OPCODE_STORE) ||
+        ((opcode->flags & ORC_STATIC_OPCODE_ACCUMULATOR) &&
+         !(opcode->flags & ORC_STATIC_OPCODE_FIND))) {
+      ORC_COMPILER_ERROR(compiler, "opcode %s not supported in program with "
+          "find opcode at line %d", opcode->name, insn->line);
+      compiler->result = ORC_COMPILE_RESULT_UNKNOWN_PARSE;
+      return;
+    }
+  }
+}
+
 static void
 orc_compiler_rewrite_insns (OrcCompiler *compiler)
 {
@@ -549,6 +1008,7 @@ orc_compiler_rewrite_insns (OrcCompiler *compiler)
     OrcInstruction *xinsn;
 
     memcpy (&insn, program->insns + j, sizeof(OrcInstruction));
+    orc_compiler_stride_insn (compiler, &insn);
     opcode = insn.opcode;
 
     if (!(opcode->flags & ORC_STATIC_OPCODE_LOAD)) {
@@ -577,6 +1037,7 @@ orc_compiler_rewrite_insns (OrcCompiler *compiler)
               var->size);
           cinsn->src_args[0] = insn.src_args[i];
           insn.src_args[i] = cinsn->dest_args[0];
+          orc_compiler_stride_insn (compiler, cinsn);
         } else if (var->vartype == ORC_VAR_TYPE_CONST ||
             var->vartype == ORC_VAR_TYPE_PARAM) {
           OrcInstruction *cinsn;
@@ -627,6 +1088,12 @@ orc_compiler_rewrite_insns (OrcCompiler *compiler)
     memcpy (xinsn, &insn, sizeof(OrcInstruction));
     compiler->n_insns++;
 
+    /* the running value of a scan is kept in a hidden second dest */
+    if (opcode->flags & ORC_STATIC_OPCODE_SCAN) {
+      xinsn->dest_args[1] = orc_compiler_new_temporary (compiler,
+          opcode->dest_size[0]);
+    }
+
     if (!(opcode->flags & ORC_STATIC_OPCODE_STORE)) {
       for(i=0;i<ORC_STATIC_OPCODE_N_DEST;i++){
         OrcVariable *var;
@@ -647,6 +1114,7 @@ orc_compiler_rewrite_insns (OrcCompiler *compiler)
           cinsn->src_args[0] = orc_compiler_new_temporary (compiler, var->size);
           cinsn->dest_args[0] = xinsn->dest_args[i];
           xinsn->dest_args[i] = cinsn->src_args[0];
+          orc_compiler_stride_insn (compiler, cinsn);
         }
       }
     }
@@ -846,7 +1314,13 @@ orc_compiler_global_reg_alloc (OrcCompiler *compiler)
       case ORC_VAR_TYPE_PARAM:
         break;
       case ORC_VAR_TYPE_SRC:
-        var->ptr_register = orc_compiler_allocate_register (compiler, FALSE);
+        if (var->inplace && compiler->share_inplace_ptr &&
+            compiler->vars[var->inplace_dest].ptr_register) {
+          /* the destination pointer addresses both */
+          var->ptr_register = compiler->vars[var->inplace_dest].ptr_register;
+        } else {
+          var->ptr_register = orc_compiler_allocate_register (compiler, FALSE);
+        }
         if (compiler->need_mask_regs) {
           var->mask_alloc = orc_compiler_allocate_register (compiler, TRUE);
           var->ptr_offset = orc_compiler_allocate_register (compiler, FALSE);
@@ -855,6 +1329,10 @@ orc_compiler_global_reg_alloc (OrcCompiler *compiler)
         if (var->need_offset_reg) {
           var->ptr_offset = orc_compiler_allocate_register (compiler, FALSE);
         }
+        if (var->need_stride_reg) {
+          var->stride_register = orc_compiler_allocate_register (compiler,
+              FALSE);
+        }
         break;
       case ORC_VAR_TYPE_DEST:
         var->ptr_register = orc_compiler_allocate_register (compiler, FALSE);
@@ -891,6 +1369,14 @@ orc_compiler_global_reg_alloc (OrcCompiler *compiler)
     if (opcode->flags & ORC_STATIC_OPCODE_ITERATOR) {
       compiler->has_iterator_opcode = TRUE;
     }
+
+    if (opcode->flags & ORC_STATIC_OPCODE_SCAN) {
+      var = compiler->vars + insn->dest_args[1];
+
+      var->first_use = -1;
+      var->last_use = -1;
+      var->alloc = orc_compiler_allocate_register (compiler, TRUE);
+    }
   }
 
   if (compiler->alloc_loop_counter && !compiler->error) {
@@ -901,6 +1387,16 @@ orc_compiler_global_reg_alloc (OrcCompiler *compiler)
       compiler->result = ORC_COMPILE_RESULT_OK;
     }
   }
+
+  /* a find records where its loop pass started and which part of the
+   * pass matched */
+  if (compiler->alloc_loop_counter && !compiler->error) {
+    for(i=0;i<compiler->n_insns;i++){
+      if (!(compiler->insns[i].opcode->flags & ORC_STATIC_OPCODE_FIND)) continue;
+      compiler->find_counter = orc_compiler_allocate_register (compiler, FALSE);
+      compiler->find_offset = orc_compiler_allocate_register (compiler, FALSE);
+    }
+  }
 }
 
 static void
@@ -997,6 +1493,28 @@ orc_compiler_new_temporary (OrcCompiler *compiler, int size)
   return i;
 }
 
+static int
+orc_compiler_new_constant (OrcCompiler *compiler, int size, int value)
+{
+  int i;
+
+  for(i=ORC_VAR_T1;i<ORC_VAR_T1+compiler->n_temp_vars+compiler->n_dup_vars;i++){
+    if (compiler->vars[i].vartype == ORC_VAR_TYPE_CONST &&
+        compiler->vars[i].size == size && compiler->vars[i].value.i == value) {
+      return i;
+    }
+  }
+
+  compiler->vars[i].vartype = ORC_VAR_TYPE_CONST;
+  compiler->vars[i].size = size;
+  compiler->vars[i].value.i = value;
+  compiler->vars[i].name = malloc (12);
+  sprintf(compiler->vars[i].name, "const%d", i);
+  compiler->n_dup_vars++;
+
+  return i;
+}
+
 #if 0
 static void
 orc_compiler_dump_asm (OrcCompiler *compiler)
@@ -1090,6 +1608,9 @@ orc_compiler_get_constant (OrcCompiler *compiler, int size, int value)
     }
   }
   if (i == compiler->n_constants) {
+    if (compiler->n_constants == ORC_N_CONSTANTS) {
+      return orc_compiler_get_temp_constant (compiler, size, value);
+    }
     compiler->n_constants++;
     compiler->constants[i].value = v;
     compiler->constants[i].alloc_reg = 0;
@@ -1115,9 +1636,17 @@ orc_compiler_get_constant_long (OrcCompiler *compiler,
 
   tmp = orc_compiler_try_get_constant_long (compiler, a, b, c, d);
   if (tmp == ORC_REG_INVALID) {
+    OrcConstant constant;
+
+    memset (&constant, 0, sizeof(constant));
+    constant.full_value[0] = a;
+    constant.full_value[1] = b;
+    constant.full_value[2] = c;
+    constant.full_value[3] = d;
+    constant.is_long = TRUE;
+
     tmp = orc_compiler_get_temp_reg (compiler);
-    orc_compiler_load_constant_long (compiler, tmp,
-        &compiler->constants[compiler->n_constants - 1]);
+    orc_compiler_load_constant_long (compiler, tmp, &constant);
   }
   return tmp;
 }
@@ -1138,6 +1667,7 @@ orc_compiler_try_get_constant_long (OrcCompiler *compiler,
     }
   }
   if (i == compiler->n_constants) {
+    if (compiler->n_constants == ORC_N_CONSTANTS) return ORC_REG_INVALID;
     compiler->n_constants++;
     compiler->constants[i].full_value[0] = a;
     compiler->constants[i].full_value[1] = b;
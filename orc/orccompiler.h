@@ -119,6 +119,7 @@ struct _OrcCompiler {
   int unroll_shift;
 
   int alloc_loop_counter;
+  int share_inplace_ptr;
   int allow_gp_on_stack;
   int loop_counter;
   int size_region;
@@ -135,6 +136,17 @@ struct _OrcCompiler {
   void *output_insns;
   int n_output_insns;
   int n_output_insns_alloc;
+  int batch_entry; /* code offset of the batch entry point */
+  int tile_n; /* 2D column strip width, or 0 */
+  int tap_window; /* bytes the taps of one source may span, or 0 */
+  int tap_carry; /* taps reuse the vector loaded by the last iteration */
+  int transpose_rows; /* rows of a loadtr block transposed in registers */
+  int transpose_row; /* row of the block the loop body is emitted for */
+  int transpose_regs[9]; /* columns of the block, then a spare */
+  int find_label; /* jump target of a find match, or 0 */
+  int find_counter; /* elements done before the current loop pass */
+  int find_offset; /* offset in the loop pass of the find that matched */
+  int ring_wrap; /* ring buffers the loop wraps itself, or 0 */
 };
 
 
@@ -50,6 +50,8 @@ static int orc_x86_microarchitecture;
 
 
 #if defined(_MSC_VER)
+#include <intrin.h>
+
 static void
 get_cpuid (orc_uint32 op, orc_uint32 *a, orc_uint32 *b, orc_uint32 *c, orc_uint32 *d)
 {
@@ -78,6 +80,16 @@ get_cpuid_ecx (orc_uint32 op, orc_uint32 init_ecx, orc_uint32 *a, orc_uint32 *b,
   *d = 0;
 #endif
 }
+
+static orc_uint32
+orc_x86_get_xcr0 (void)
+{
+#if _MSC_FULL_VER >= 160040219
+  return (orc_uint32)_xgetbv (0);
+#else
+  return 0;
+#endif
+}
 #elif defined(__GNUC__) || defined (__SUNPRO_C)
 
 static void
@@ -107,6 +119,20 @@ get_cpuid (orc_uint32 op, orc_uint32 *a, orc_uint32 *b,
   get_cpuid_ecx (op, 0, a, b, c, d);
 }
 
+/* only valid when cpuid reports OSXSAVE */
+static orc_uint32
+orc_x86_get_xcr0 (void)
+{
+  orc_uint32 eax, edx;
+
+  /* xgetbv, spelled out for older assemblers */
+  __asm__ (
+      "  .byte 0x0f, 0x01, 0xd0\n"
+      : "=a" (eax), "=d" (edx) : "c" (0));
+
+  return eax;
+}
+
 #else
 
 /* FIXME generate a get_cpuid() function at runtime. */
@@ -265,6 +291,12 @@ orc_x86_detect_cpuid (void)
   if (orc_compiler_flag_check ("-sse5")) {
     orc_x86_sse_flags &= ~ORC_TARGET_SSE_SSE5;
   }
+  if (orc_compiler_flag_check ("-fma")) {
+    orc_x86_sse_flags &= ~ORC_TARGET_SSE_FMA;
+  }
+  if (orc_compiler_flag_check ("-f16c")) {
+    orc_x86_sse_flags &= ~ORC_TARGET_SSE_F16C;
+  }
 
 }
 
@@ -322,6 +354,15 @@ orc_x86_cpuid_handle_standard_flags (void)
   if (ecx & (1<<20)) {
     orc_x86_sse_flags |= ORC_TARGET_SSE_SSE4_2;
   }
+  /* FMA3 is VEX encoded, so the OS must also save the AVX state */
+  if ((ecx & (1<<12)) && (ecx & (1<<27)) &&
+      (orc_x86_get_xcr0 () & 0x6) == 0x6) {
+    orc_x86_sse_flags |= ORC_TARGET_SSE_FMA;
+  }
+  if ((ecx & (1<<29)) && (ecx & (1<<27)) &&
+      (orc_x86_get_xcr0 () & 0x6) == 0x6) {
+    orc_x86_sse_flags |= ORC_TARGET_SSE_F16C;
+  }
 }
 
 static void
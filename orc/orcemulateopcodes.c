@@ -5371,3 +5371,2236 @@ emulate_convdf (OrcOpcodeExecutor *ex, int offset, int n)
 
 }
 
+void
+emulate_fmaf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  const orc_union32 * ORC_RESTRICT ptr6;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+  ptr6 = (orc_union32 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: loadl */
+    var34 = ptr6[i];
+    /* 3: fmaf */
+    {
+       orc_union32 _src1;
+       orc_union32 _src2;
+       orc_union32 _src3;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _src2.i = ORC_DENORMAL(var33.i);
+       _src3.i = ORC_DENORMAL(var34.i);
+       _dest1.f = fmaf(_src1.f, _src2.f, _src3.f);
+       var35.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_fmsf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  const orc_union32 * ORC_RESTRICT ptr6;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+  ptr6 = (orc_union32 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: loadl */
+    var34 = ptr6[i];
+    /* 3: fmsf */
+    {
+       orc_union32 _src1;
+       orc_union32 _src2;
+       orc_union32 _src3;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _src2.i = ORC_DENORMAL(var33.i);
+       _src3.i = ORC_DENORMAL(var34.i);
+       _dest1.f = fmaf(_src1.f, _src2.f, -_src3.f);
+       var35.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_fnmaf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  const orc_union32 * ORC_RESTRICT ptr6;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+  ptr6 = (orc_union32 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: loadl */
+    var34 = ptr6[i];
+    /* 3: fnmaf */
+    {
+       orc_union32 _src1;
+       orc_union32 _src2;
+       orc_union32 _src3;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _src2.i = ORC_DENORMAL(var33.i);
+       _src3.i = ORC_DENORMAL(var34.i);
+       _dest1.f = fmaf(-_src1.f, _src2.f, _src3.f);
+       var35.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_fmad (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  const orc_union64 * ORC_RESTRICT ptr5;
+  const orc_union64 * ORC_RESTRICT ptr6;
+  orc_union64 var32;
+  orc_union64 var33;
+  orc_union64 var34;
+  orc_union64 var35;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+  ptr5 = (orc_union64 *)ex->src_ptrs[1];
+  ptr6 = (orc_union64 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: loadq */
+    var33 = ptr5[i];
+    /* 2: loadq */
+    var34 = ptr6[i];
+    /* 3: fmad */
+    {
+       orc_union64 _src1;
+       orc_union64 _src2;
+       orc_union64 _src3;
+       orc_union64 _dest1;
+       _src1.i = ORC_DENORMAL_DOUBLE(var32.i);
+       _src2.i = ORC_DENORMAL_DOUBLE(var33.i);
+       _src3.i = ORC_DENORMAL_DOUBLE(var34.i);
+       _dest1.f = fma(_src1.f, _src2.f, _src3.f);
+       var35.i = ORC_DENORMAL_DOUBLE(_dest1.i);
+    }
+    /* 4: storeq */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_convhf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: convhf */
+    {
+       orc_union32 _dest;
+       orc_uint32 _h = (orc_uint16)var32.i;
+       orc_uint32 _e = (_h >> 10) & 0x1f;
+       orc_uint32 _m = _h & 0x3ff;
+       if (_e == 0x1f) {
+         _dest.i = 0x7f800000 | (_m << 13) | (_m ? 0x00400000 : 0);
+       } else if (_e != 0) {
+         _dest.i = ((_e + 112) << 23) | (_m << 13);
+       } else {
+         _dest.f = _m * (1.0f/16777216.0f);
+       }
+       var33.i = _dest.i | ((_h & 0x8000) << 16);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_convfh (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union16 var33;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: convfh */
+    {
+       orc_union32 _src1;
+       orc_uint32 _a;
+       orc_uint32 _r;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _a = _src1.i & 0x7fffffff;
+       if (_a > 0x7f800000) {
+         _r = 0x7e00 | ((_a >> 13) & 0x3ff);
+       } else if (_a >= 0x47800000) {
+         _r = 0x7c00;
+       } else if (_a < 0x38800000) {
+         orc_union32 _t;
+         _t.i = _a;
+         _t.f += 0.5f;
+         _r = _t.i - 0x3f000000;
+       } else {
+         _r = (_a - 0x37fff001 + ((_a >> 13) & 1)) >> 13;
+       }
+       var33.i = _r | ((_src1.i >> 16) & 0x8000);
+    }
+    /* 2: storew */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_convbf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: convbf */
+    var33.i = ORC_DENORMAL((orc_uint32)(orc_uint16)var32.i << 16);
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_convfb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union16 var33;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: convfb */
+    {
+       orc_uint32 _x = ORC_DENORMAL(var32.i);
+       if (ORC_ISNAN(_x)) {
+         var33.i = (_x >> 16) | 0x0040;
+       } else {
+         var33.i = (_x + 0x7fff + ((_x >> 16) & 1)) >> 16;
+       }
+    }
+    /* 2: storew */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_roundf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: roundf */
+    {
+       orc_union32 _src1;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _dest1.f = rintf(_src1.f);
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_floorf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: floorf */
+    {
+       orc_union32 _src1;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _dest1.f = floorf(_src1.f);
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_ceilf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: ceilf */
+    {
+       orc_union32 _src1;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _dest1.f = ceilf(_src1.f);
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_truncf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: truncf */
+    {
+       orc_union32 _src1;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _dest1.f = truncf(_src1.f);
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_rcpf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: rcpf */
+    {
+       orc_union32 _src1;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _dest1.f = 1.0f / _src1.f;
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_rsqrtf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: rsqrtf */
+    {
+       orc_union32 _src1;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var32.i);
+       _dest1.f = 1.0f / sqrtf(_src1.f);
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_expf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: expf */
+    {
+       orc_union32 _x;
+       orc_union32 _t;
+       orc_union32 _s1;
+       orc_union32 _s2;
+       float _k, _r, _z;
+       orc_int32 _n;
+       _x.i = ORC_DENORMAL(var32.i);
+       _x.f = (89.0f < _x.f) ? 89.0f : _x.f;
+       _x.f = (-104.0f > _x.f) ? -104.0f : _x.f;
+       _t.f = _x.f * 1.44269504f + 12582912.0f;
+       _k = _t.f - 12582912.0f;
+       _n = _t.i - 0x4b400000;
+       _r = _x.f - _k * 0.693359375f;
+       _r = _r - _k * -2.12194440e-4f;
+       _z = _r * _r;
+       _x.f = 1.9875691500e-4f * _r + 1.3981999507e-3f;
+       _x.f = _x.f * _r + 8.3334519073e-3f;
+       _x.f = _x.f * _r + 4.1665795894e-2f;
+       _x.f = _x.f * _r + 1.6666665459e-1f;
+       _x.f = _x.f * _r + 5.0000001201e-1f;
+       _x.f = _x.f * _z + _r + 1.0f;
+       _s1.i = (orc_uint32)((_n >> 1) + 127) << 23;
+       _s2.i = (orc_uint32)(_n - (_n >> 1) + 127) << 23;
+       _x.f = _x.f * _s1.f * _s2.f;
+       var33.i = ORC_DENORMAL(_x.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_logf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: logf */
+    {
+       orc_union32 _x;
+       orc_union32 _m;
+       float _e, _f, _y;
+       _x.i = ORC_DENORMAL(var32.i);
+       if ((orc_uint32)_x.i - 0x00800000 < 0x7f000000) {
+         _m.i = _x.i - 0x3f3504f3;
+         _e = (float)(_m.i >> 23);
+         _m.i = (_m.i & 0x007fffff) + 0x3f3504f3;
+         _f = _m.f - 1.0f;
+         _y = 7.0376836292e-2f * _f - 1.1514610310e-1f;
+         _y = _y * _f + 1.1676998740e-1f;
+         _y = _y * _f - 1.2420140846e-1f;
+         _y = _y * _f + 1.4249322787e-1f;
+         _y = _y * _f - 1.6668057665e-1f;
+         _y = _y * _f + 2.0000714765e-1f;
+         _y = _y * _f - 2.4999993993e-1f;
+         _y = _y * _f + 3.3333331174e-1f;
+         _y = _y * _f * (_f * _f);
+         _y = _y + _e * -2.12194440e-4f;
+         _y = _y - 0.5f * (_f * _f);
+         _x.f = _f + _y + _e * 0.693359375f;
+       } else if (_x.f == 0.0f) {
+         _x.i = 0xff800000;
+       } else if (_x.f < 0.0f) {
+         _x.i = 0x7fc00000;
+       }
+       var33.i = _x.i;
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_sinf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: sinf */
+    {
+       orc_union32 _x;
+       orc_union64 _t;
+       double _k, _r;
+       float _y, _z, _s, _c;
+       orc_uint32 _q;
+       _x.i = ORC_DENORMAL(var32.i);
+       _t.f = (double)_x.f * 0.63661977236758134 + 6755399441055744.0;
+       _k = _t.f - 6755399441055744.0;
+       _r = (double)_x.f - _k * 1.5707963267341256;
+       _r = _r - _k * 6.077100506506192e-11;
+       _y = (float)_r;
+       _q = (orc_uint32)_t.i + 0;
+       _z = _y * _y;
+       _s = -1.9515295891e-4f * _z + 8.3321608736e-3f;
+       _s = _s * _z - 1.6666654611e-1f;
+       _s = _s * _z * _y + _y;
+       _c = 2.443315711809948e-5f * _z - 1.388731625493765e-3f;
+       _c = _c * _z + 4.166664568298827e-2f;
+       _c = _c * _z * _z - 0.5f * _z + 1.0f;
+       _x.f = (_q & 1) ? _c : _s;
+       if (_q & 2) _x.f = -_x.f;
+       var33.i = ORC_DENORMAL(_x.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_cosf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: cosf */
+    {
+       orc_union32 _x;
+       orc_union64 _t;
+       double _k, _r;
+       float _y, _z, _s, _c;
+       orc_uint32 _q;
+       _x.i = ORC_DENORMAL(var32.i);
+       _t.f = (double)_x.f * 0.63661977236758134 + 6755399441055744.0;
+       _k = _t.f - 6755399441055744.0;
+       _r = (double)_x.f - _k * 1.5707963267341256;
+       _r = _r - _k * 6.077100506506192e-11;
+       _y = (float)_r;
+       _q = (orc_uint32)_t.i + 1;
+       _z = _y * _y;
+       _s = -1.9515295891e-4f * _z + 8.3321608736e-3f;
+       _s = _s * _z - 1.6666654611e-1f;
+       _s = _s * _z * _y + _y;
+       _c = 2.443315711809948e-5f * _z - 1.388731625493765e-3f;
+       _c = _c * _z + 4.166664568298827e-2f;
+       _c = _c * _z * _z - 0.5f * _z + 1.0f;
+       _x.f = (_q & 1) ? _c : _s;
+       if (_q & 2) _x.f = -_x.f;
+       var33.i = ORC_DENORMAL(_x.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_powf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: powf */
+    {
+       orc_union32 _x;
+       orc_union32 _y;
+       orc_union32 _m;
+       orc_union32 _s1;
+       orc_union32 _s2;
+       orc_union64 _k;
+       double _e, _s, _z, _t;
+       orc_int32 _n;
+       _x.i = ORC_DENORMAL(var32.i);
+       _y.i = ORC_DENORMAL(var33.i);
+       if ((orc_uint32)_x.i - 0x00800000 < 0x7f000000) {
+         _m.i = _x.i - 0x3f3504f3;
+         _e = (double)(_m.i >> 23);
+         _m.i = (_m.i & 0x007fffff) + 0x3f3504f3;
+       } else {
+         if (_x.f == 0.0f) {
+           _x.i = 0xff800000;
+         } else if (_x.f < 0.0f) {
+           _x.i = 0x7fc00000;
+         }
+         _e = (double)_x.f;
+         _m.f = 1.0f;
+       }
+       _s = ((double)_m.f - 1.0) / ((double)_m.f + 1.0);
+       _z = _s * _s;
+       _t = _z * (1.0/13) + (1.0/11);
+       _t = _t * _z + (1.0/9);
+       _t = _t * _z + (1.0/7);
+       _t = _t * _z + (1.0/5);
+       _t = _t * _z + (1.0/3);
+       _t = _t * _z + 1.0;
+       _t = _t * _s * 2.8853900817779268 + _e;
+       _t = (double)_y.f * _t;
+       _t = (130.0 < _t) ? 130.0 : _t;
+       _t = (-160.0 > _t) ? -160.0 : _t;
+       _k.f = _t + 6755399441055744.0;
+       _n = (orc_int32)(orc_uint32)_k.i;
+       _t = _t - (_k.f - 6755399441055744.0);
+       _e = 1.3215486790144307e-06 * _t + 1.525273380405984e-05;
+       _e = _e * _t + 1.5403530393381608e-04;
+       _e = _e * _t + 1.3333558146428443e-03;
+       _e = _e * _t + 9.618129107628477e-03;
+       _e = _e * _t + 5.550410866482158e-02;
+       _e = _e * _t + 2.402265069591007e-01;
+       _e = _e * _t + 6.931471805599453e-01;
+       _e = _e * _t + 1.0;
+       _s1.i = (orc_uint32)((_n >> 1) + 127) << 23;
+       _s2.i = (orc_uint32)(_n - (_n >> 1) + 127) << 23;
+       _x.f = (float)_e * _s1.f * _s2.f;
+       var34.i = ORC_DENORMAL(_x.i);
+    }
+    /* 3: storel */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+emulate_loadch3b (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadch3b */
+    var32 = ((const orc_int8 *)ptr4)[3*(offset + i) + ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storeb */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadch4b (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadch4b */
+    var32 = ((const orc_int8 *)ptr4)[4*(offset + i) + ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storeb */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadch3w (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadch3w */
+    var32 = ((const orc_union16 *)ptr4)[3*(offset + i) + ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storew */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadch4w (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadch4w */
+    var32 = ((const orc_union16 *)ptr4)[4*(offset + i) + ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storew */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_storech3b (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  const orc_int8 * ORC_RESTRICT ptr5;
+  const orc_int8 * ORC_RESTRICT ptr6;
+  orc_int8 var32;
+  orc_int8 var33;
+  orc_int8 var34;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+  ptr5 = (orc_int8 *)ex->src_ptrs[1];
+  ptr6 = (orc_int8 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: loadb */
+    var33 = ptr5[i];
+    /* 2: loadb */
+    var34 = ptr6[i];
+    /* 3: storech3b */
+    ((orc_int8 *)ptr0)[3*(offset + i) + 0] = var32;
+    ((orc_int8 *)ptr0)[3*(offset + i) + 1] = var33;
+    ((orc_int8 *)ptr0)[3*(offset + i) + 2] = var34;
+  }
+
+}
+
+void
+emulate_storech3w (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  const orc_union16 * ORC_RESTRICT ptr5;
+  const orc_union16 * ORC_RESTRICT ptr6;
+  orc_union16 var32;
+  orc_union16 var33;
+  orc_union16 var34;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+  ptr5 = (orc_union16 *)ex->src_ptrs[1];
+  ptr6 = (orc_union16 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: loadw */
+    var33 = ptr5[i];
+    /* 2: loadw */
+    var34 = ptr6[i];
+    /* 3: storech3w */
+    ((orc_union16 *)ptr0)[3*(offset + i) + 0] = var32;
+    ((orc_union16 *)ptr0)[3*(offset + i) + 1] = var33;
+    ((orc_union16 *)ptr0)[3*(offset + i) + 2] = var34;
+  }
+
+}
+
+void
+emulate_loadstrb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadstrb */
+    var32 = ptr4[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storeb */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadstrw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadstrw */
+    var32 = ptr4[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storew */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadstrl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadstrl */
+    var32 = ptr4[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storel */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadstrq (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadstrq */
+    var32 = ptr4[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i];
+    /* 1: storeq */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_storestrb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: storestrb */
+    ptr0[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i] = var32;
+  }
+
+}
+
+void
+emulate_storestrw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: storestrw */
+    ptr0[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i] = var32;
+  }
+
+}
+
+void
+emulate_storestrl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: storestrl */
+    ptr0[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i] = var32;
+  }
+
+}
+
+void
+emulate_storestrq (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: storestrq */
+    ptr0[(offset + i) * ((orc_union64 *)(ex->src_ptrs[1]))->i] = var32;
+  }
+
+}
+
+void
+emulate_scanaddw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_union16 var33;
+  orc_union16 var34;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+  var33.i = (offset == 0) ? 0 : ex->dest_values[0];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: scanaddw */
+    var33.i = var33.i + var32.i;
+    var34.i = var33.i;
+    /* 2: storew */
+    ptr0[i] = var34;
+  }
+  ex->dest_values[0] = var33.i;
+
+}
+
+void
+emulate_scanaddl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+  var33.i = (offset == 0) ? 0 : ex->dest_values[0];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: scanaddl */
+    var33.i = ((orc_uint32)var33.i) + ((orc_uint32)var32.i);
+    var34.i = var33.i;
+    /* 2: storel */
+    ptr0[i] = var34;
+  }
+  ex->dest_values[0] = var33.i;
+
+}
+
+void
+emulate_scanaddf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+  var33.i = (offset == 0) ? 0 : ex->dest_values[0];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: scanaddf */
+    {
+       orc_union32 _src1;
+       orc_union32 _src2;
+       orc_union32 _dest1;
+       _src1.i = ORC_DENORMAL(var33.i);
+       _src2.i = ORC_DENORMAL(var32.i);
+       _dest1.f = _src1.f + _src2.f;
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    var34.i = var33.i;
+    /* 2: storel */
+    ptr0[i] = var34;
+  }
+  ex->dest_values[0] = var33.i;
+
+}
+
+void
+emulate_maddswl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: maddswl */
+    {
+       orc_union32 _src1;
+       orc_union32 _src2;
+       _src1.i = var32.i;
+       _src2.i = var33.i;
+       var34.i = (orc_uint32)(_src1.x2[0] * _src2.x2[0]) + (orc_uint32)(_src1.x2[1] * _src2.x2[1]);
+    }
+    /* 3: storel */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+emulate_maddusbw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  const orc_union16 * ORC_RESTRICT ptr5;
+  orc_union16 var32;
+  orc_union16 var33;
+  orc_union16 var34;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+  ptr5 = (orc_union16 *)ex->src_ptrs[1];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: loadw */
+    var33 = ptr5[i];
+    /* 2: maddusbw */
+    {
+       orc_union16 _src1;
+       orc_union16 _src2;
+       _src1.i = var32.i;
+       _src2.i = var33.i;
+       var34.i = ORC_CLAMP_SW((orc_uint8)_src1.x2[0] * _src2.x2[0] + (orc_uint8)_src1.x2[1] * _src2.x2[1]);
+    }
+    /* 3: storew */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+emulate_ldresbilinb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: ldresbilinb */
+    {
+    int tmp = (int)(((orc_union64 *)(ex->src_ptrs[1]))->i) + (offset + i) * ((orc_union64 *)(ex->src_ptrs[2]))->i;
+    int x = (tmp>>8)&0xff;
+    int y = ((int)((((orc_union64 *)(ex->src_ptrs[1]))->i) >> 32)>>8)&0xff;
+    const orc_int8 *r0 = ptr4 + (tmp>>16);
+    const orc_int8 *r1 = (const orc_int8 *)ORC_PTR_OFFSET(r0, ex->src_values[0]);
+    var32 = ((((orc_uint8)r0[0] * (256-x) + (orc_uint8)r0[1] * x)>>8) * (256-y) + (((orc_uint8)r1[0] * (256-x) + (orc_uint8)r1[1] * x)>>8) * y)>>8;
+    }
+    /* 1: storeb */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_ldresbilinl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: ldresbilinl */
+    {
+    int tmp = (int)(((orc_union64 *)(ex->src_ptrs[1]))->i) + (offset + i) * ((orc_union64 *)(ex->src_ptrs[2]))->i;
+    int x = (tmp>>8)&0xff;
+    int y = ((int)((((orc_union64 *)(ex->src_ptrs[1]))->i) >> 32)>>8)&0xff;
+    const orc_union32 *r0 = ptr4 + (tmp>>16);
+    const orc_union32 *r1 = (const orc_union32 *)ORC_PTR_OFFSET(r0, ex->src_values[0]);
+    var32.x4[0] = ((((orc_uint8)r0[0].x4[0] * (256-x) + (orc_uint8)r0[1].x4[0] * x)>>8) * (256-y) + (((orc_uint8)r1[0].x4[0] * (256-x) + (orc_uint8)r1[1].x4[0] * x)>>8) * y)>>8;
+    var32.x4[1] = ((((orc_uint8)r0[0].x4[1] * (256-x) + (orc_uint8)r0[1].x4[1] * x)>>8) * (256-y) + (((orc_uint8)r1[0].x4[1] * (256-x) + (orc_uint8)r1[1].x4[1] * x)>>8) * y)>>8;
+    var32.x4[2] = ((((orc_uint8)r0[0].x4[2] * (256-x) + (orc_uint8)r0[1].x4[2] * x)>>8) * (256-y) + (((orc_uint8)r1[0].x4[2] * (256-x) + (orc_uint8)r1[1].x4[2] * x)>>8) * y)>>8;
+    var32.x4[3] = ((((orc_uint8)r0[0].x4[3] * (256-x) + (orc_uint8)r0[1].x4[3] * x)>>8) * (256-y) + (((orc_uint8)r1[0].x4[3] * (256-x) + (orc_uint8)r1[1].x4[3] * x)>>8) * y)>>8;
+    }
+    /* 1: storel */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_selectb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  const orc_int8 * ORC_RESTRICT ptr5;
+  const orc_int8 * ORC_RESTRICT ptr6;
+  orc_int8 var32;
+  orc_int8 var33;
+  orc_int8 var34;
+  orc_int8 var35;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+  ptr5 = (orc_int8 *)ex->src_ptrs[1];
+  ptr6 = (orc_int8 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: loadb */
+    var33 = ptr5[i];
+    /* 2: loadb */
+    var34 = ptr6[i];
+    /* 3: selectb */
+    var35 = ((orc_int8)var32 < 0) ? var33 : var34;
+    /* 4: storeb */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_selectw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  const orc_union16 * ORC_RESTRICT ptr5;
+  const orc_union16 * ORC_RESTRICT ptr6;
+  orc_union16 var32;
+  orc_union16 var33;
+  orc_union16 var34;
+  orc_union16 var35;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+  ptr5 = (orc_union16 *)ex->src_ptrs[1];
+  ptr6 = (orc_union16 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: loadw */
+    var33 = ptr5[i];
+    /* 2: loadw */
+    var34 = ptr6[i];
+    /* 3: selectw */
+    var35.i = ((orc_int16)var32.i < 0) ? var33.i : var34.i;
+    /* 4: storew */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_selectl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  const orc_union32 * ORC_RESTRICT ptr6;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+  ptr6 = (orc_union32 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: loadl */
+    var34 = ptr6[i];
+    /* 3: selectl */
+    var35.i = ((orc_int32)var32.i < 0) ? var33.i : var34.i;
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_selectf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  const orc_union32 * ORC_RESTRICT ptr5;
+  const orc_union32 * ORC_RESTRICT ptr6;
+  orc_union32 var32;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+  ptr5 = (orc_union32 *)ex->src_ptrs[1];
+  ptr6 = (orc_union32 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: loadl */
+    var33 = ptr5[i];
+    /* 2: loadl */
+    var34 = ptr6[i];
+    /* 3: selectf */
+    var35.i = ((orc_int32)var32.i < 0) ? var33.i : var34.i;
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_selectd (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  const orc_union64 * ORC_RESTRICT ptr5;
+  const orc_union64 * ORC_RESTRICT ptr6;
+  orc_union64 var32;
+  orc_union64 var33;
+  orc_union64 var34;
+  orc_union64 var35;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+  ptr5 = (orc_union64 *)ex->src_ptrs[1];
+  ptr6 = (orc_union64 *)ex->src_ptrs[2];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: loadq */
+    var33 = ptr5[i];
+    /* 2: loadq */
+    var34 = ptr6[i];
+    /* 3: selectd */
+    var35.i = ((orc_int64)var32.i < 0) ? var33.i : var34.i;
+    /* 4: storeq */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+emulate_unpacklb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union64 var33;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: unpacklb */
+    {
+       orc_union64 _dest;
+       orc_union32 _lo;
+       orc_union32 _hi;
+       orc_uint64 _src = (orc_uint32)var32.i;
+       int _width = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       orc_uint32 _mask = (1u << _width) - 1;
+       _lo.x4[0] = (_src >> (0 * _width)) & _mask;
+       _lo.x4[1] = (_src >> (1 * _width)) & _mask;
+       _lo.x4[2] = (_src >> (2 * _width)) & _mask;
+       _lo.x4[3] = (_src >> (3 * _width)) & _mask;
+       _hi.x4[0] = (_src >> (4 * _width)) & _mask;
+       _hi.x4[1] = (_src >> (5 * _width)) & _mask;
+       _hi.x4[2] = (_src >> (6 * _width)) & _mask;
+       _hi.x4[3] = (_src >> (7 * _width)) & _mask;
+       _dest.x2[0] = _lo.i;
+       _dest.x2[1] = _hi.i;
+       var33.i = _dest.i;
+    }
+    /* 2: storeq */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_unpacklw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union64 var33;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: unpacklw */
+    {
+       orc_union64 _dest;
+       orc_uint64 _src = (orc_uint32)var32.i;
+       int _width = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       orc_uint32 _mask = (1u << _width) - 1;
+       _dest.x4[0] = (_src >> (0 * _width)) & _mask;
+       _dest.x4[1] = (_src >> (1 * _width)) & _mask;
+       _dest.x4[2] = (_src >> (2 * _width)) & _mask;
+       _dest.x4[3] = (_src >> (3 * _width)) & _mask;
+       var33.i = _dest.i;
+    }
+    /* 2: storeq */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_packbl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: packbl */
+    {
+       orc_union64 _src;
+       orc_union32 _lo;
+       orc_union32 _hi;
+       orc_uint64 _dest = 0;
+       int _width = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       orc_uint32 _mask = (1u << _width) - 1;
+       _src.i = var32.i;
+       _lo.i = _src.x2[0];
+       _hi.i = _src.x2[1];
+       _dest |= (orc_uint64)((orc_uint8)_lo.x4[0] & _mask) << (0 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_lo.x4[1] & _mask) << (1 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_lo.x4[2] & _mask) << (2 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_lo.x4[3] & _mask) << (3 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_hi.x4[0] & _mask) << (4 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_hi.x4[1] & _mask) << (5 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_hi.x4[2] & _mask) << (6 * _width);
+       _dest |= (orc_uint64)((orc_uint8)_hi.x4[3] & _mask) << (7 * _width);
+       var33.i = (orc_uint32)_dest;
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_packwl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: packwl */
+    {
+       orc_union64 _src;
+       orc_uint64 _dest = 0;
+       int _width = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       orc_uint32 _mask = (1u << _width) - 1;
+       _src.i = var32.i;
+       _dest |= (orc_uint64)((orc_uint16)_src.x4[0] & _mask) << (0 * _width);
+       _dest |= (orc_uint64)((orc_uint16)_src.x4[1] & _mask) << (1 * _width);
+       _dest |= (orc_uint64)((orc_uint16)_src.x4[2] & _mask) << (2 * _width);
+       _dest |= (orc_uint64)((orc_uint16)_src.x4[3] & _mask) << (3 * _width);
+       var33.i = (orc_uint32)_dest;
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_popcntb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: popcntb */
+    {
+       orc_uint32 _x = (orc_uint8)var32;
+       _x = _x - ((_x >> 1) & 0x55555555);
+       _x = (_x & 0x33333333) + ((_x >> 2) & 0x33333333);
+       _x = (_x + (_x >> 4)) & 0x0f0f0f0f;
+       var33 = (_x * 0x01010101) >> 24;
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_popcntw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_union16 var33;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: popcntw */
+    {
+       orc_uint32 _x = (orc_uint16)var32.i;
+       _x = _x - ((_x >> 1) & 0x55555555);
+       _x = (_x & 0x33333333) + ((_x >> 2) & 0x33333333);
+       _x = (_x + (_x >> 4)) & 0x0f0f0f0f;
+       var33.i = (_x * 0x01010101) >> 24;
+    }
+    /* 2: storew */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_popcntl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: popcntl */
+    {
+       orc_uint32 _x = (orc_uint32)var32.i;
+       _x = _x - ((_x >> 1) & 0x55555555);
+       _x = (_x & 0x33333333) + ((_x >> 2) & 0x33333333);
+       _x = (_x + (_x >> 4)) & 0x0f0f0f0f;
+       var33.i = (_x * 0x01010101) >> 24;
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_clzw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_union16 var33;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: clzw */
+    {
+       orc_uint32 _x = ((orc_uint32)(orc_uint16)var32.i << 16) | 0x8000;
+       int _n = 0;
+       if (_x == 0) _n = 32;
+       if (_x && !(_x & 0xffff0000)) { _n += 16; _x <<= 16; }
+       if (_x && !(_x & 0xff000000)) { _n += 8; _x <<= 8; }
+       if (_x && !(_x & 0xf0000000)) { _n += 4; _x <<= 4; }
+       if (_x && !(_x & 0xc0000000)) { _n += 2; _x <<= 2; }
+       if (_x && !(_x & 0x80000000)) { _n += 1; }
+       var33.i = _n;
+    }
+    /* 2: storew */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_clzl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: clzl */
+    {
+       orc_uint32 _x = (orc_uint32)var32.i;
+       int _n = 0;
+       if (_x == 0) _n = 32;
+       if (_x && !(_x & 0xffff0000)) { _n += 16; _x <<= 16; }
+       if (_x && !(_x & 0xff000000)) { _n += 8; _x <<= 8; }
+       if (_x && !(_x & 0xf0000000)) { _n += 4; _x <<= 4; }
+       if (_x && !(_x & 0xc0000000)) { _n += 2; _x <<= 2; }
+       if (_x && !(_x & 0x80000000)) { _n += 1; }
+       var33.i = _n;
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_bitrevb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: bitrevb */
+    {
+       orc_uint32 _x = (orc_uint8)var32;
+       _x = ((_x & 0x0f) << 4) | (_x >> 4);
+       _x = ((_x & 0x33) << 2) | ((_x >> 2) & 0x33);
+       _x = ((_x & 0x55) << 1) | ((_x >> 1) & 0x55);
+       var33 = _x;
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_shufflel (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: shufflel */
+    {
+       orc_union32 _src[2];
+       orc_union32 _dest[2];
+       int _perm = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       int _j;
+       _src[0].i = var32.i;
+       _j = (_perm >> 0) & 0xf;
+       _dest[0].x4[0] = (_j < 4) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 4) & 0xf;
+       _dest[0].x4[1] = (_j < 4) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 8) & 0xf;
+       _dest[0].x4[2] = (_j < 4) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 12) & 0xf;
+       _dest[0].x4[3] = (_j < 4) ? _src[_j >> 2].x4[_j & 3] : 0;
+       var33.i = _dest[0].i;
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_shuffleq (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+  orc_union64 var33;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: shuffleq */
+    {
+       orc_union32 _src[2];
+       orc_union32 _dest[2];
+       int _perm = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       int _j;
+       orc_union64 _tmp;
+       _tmp.i = var32.i;
+       _src[0].i = _tmp.x2[0];
+       _src[1].i = _tmp.x2[1];
+       _j = (_perm >> 0) & 0xf;
+       _dest[0].x4[0] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 4) & 0xf;
+       _dest[0].x4[1] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 8) & 0xf;
+       _dest[0].x4[2] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 12) & 0xf;
+       _dest[0].x4[3] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 16) & 0xf;
+       _dest[1].x4[0] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 20) & 0xf;
+       _dest[1].x4[1] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 24) & 0xf;
+       _dest[1].x4[2] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _j = (_perm >> 28) & 0xf;
+       _dest[1].x4[3] = (_j < 8) ? _src[_j >> 2].x4[_j & 3] : 0;
+       _tmp.x2[0] = _dest[0].i;
+       _tmp.x2[1] = _dest[1].i;
+       var33.i = _tmp.i;
+    }
+    /* 2: storeq */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_loadtrb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_int8 var32;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadtrb */
+    var32 = *(const orc_int8 *)ORC_PTR_OFFSET(ptr4, (offset + i) * ex->src_values[0]);
+    /* 1: storeb */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadtrw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union16 * ORC_RESTRICT ptr0;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union16 var32;
+
+  ptr0 = (orc_union16 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadtrw */
+    var32 = *(const orc_union16 *)ORC_PTR_OFFSET(ptr4, (offset + i) * ex->src_values[0]);
+    /* 1: storew */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadtrl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadtrl */
+    var32 = *(const orc_union32 *)ORC_PTR_OFFSET(ptr4, (offset + i) * ex->src_values[0]);
+    /* 1: storel */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_loadtrq (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadtrq */
+    var32 = *(const orc_union64 *)ORC_PTR_OFFSET(ptr4, (offset + i) * ex->src_values[0]);
+    /* 1: storeq */
+    ptr0[i] = var32;
+  }
+
+}
+
+void
+emulate_findb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  const orc_int8 * ORC_RESTRICT ptr4;
+  orc_union32 var12 =  { 0 };
+  orc_int8 var32;
+
+  ptr4 = (orc_int8 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: findb */
+    if (var32 != 0) break;
+    var12.i = var12.i + 1;
+  }
+  ((orc_union32 *)ex->dest_ptrs[0])->i += (orc_uint32)var12.i;
+
+}
+
+void
+emulate_findw (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  const orc_union16 * ORC_RESTRICT ptr4;
+  orc_union32 var12 =  { 0 };
+  orc_union16 var32;
+
+  ptr4 = (orc_union16 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: findw */
+    if (var32.i != 0) break;
+    var12.i = var12.i + 1;
+  }
+  ((orc_union32 *)ex->dest_ptrs[0])->i += (orc_uint32)var12.i;
+
+}
+
+void
+emulate_findl (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var12 =  { 0 };
+  orc_union32 var32;
+
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: findl */
+    if (var32.i != 0) break;
+    var12.i = var12.i + 1;
+  }
+  ((orc_union32 *)ex->dest_ptrs[0])->i += (orc_uint32)var12.i;
+
+}
+
+void
+emulate_mulcf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  const orc_union64 * ORC_RESTRICT ptr5;
+  orc_union64 var32;
+  orc_union64 var33;
+  orc_union64 var34;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+  ptr5 = (orc_union64 *)ex->src_ptrs[1];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: loadq */
+    var33 = ptr5[i];
+    /* 2: mulcf */
+    {
+       orc_union64 _src1;
+       orc_union64 _src2;
+       orc_union64 _dest1;
+       orc_union32 _rr, _ir, _ii, _ri;
+       _src1.i = var32.i;
+       _src2.i = var33.i;
+       _src1.x2[0] = ORC_DENORMAL(_src1.x2[0]);
+       _src1.x2[1] = ORC_DENORMAL(_src1.x2[1]);
+       _src2.x2[0] = ORC_DENORMAL(_src2.x2[0]);
+       _src2.x2[1] = ORC_DENORMAL(_src2.x2[1]);
+       _rr.f = _src1.x2f[0] * _src2.x2f[0];
+       _ir.f = _src1.x2f[1] * _src2.x2f[0];
+       _ii.f = _src1.x2f[1] * _src2.x2f[1];
+       _ri.f = _src1.x2f[0] * _src2.x2f[1];
+       _rr.i = ORC_DENORMAL(_rr.i);
+       _ir.i = ORC_DENORMAL(_ir.i);
+       _ii.i = ORC_DENORMAL(_ii.i);
+       _ri.i = ORC_DENORMAL(_ri.i);
+       _dest1.x2f[0] = _rr.f - _ii.f;
+       _dest1.x2f[1] = _ir.f + _ri.f;
+       _dest1.x2[0] = ORC_DENORMAL(_dest1.x2[0]);
+       _dest1.x2[1] = ORC_DENORMAL(_dest1.x2[1]);
+       var34.i = _dest1.i;
+    }
+    /* 3: storeq */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+emulate_mulconjcf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union64 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  const orc_union64 * ORC_RESTRICT ptr5;
+  orc_union64 var32;
+  orc_union64 var33;
+  orc_union64 var34;
+
+  ptr0 = (orc_union64 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+  ptr5 = (orc_union64 *)ex->src_ptrs[1];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: loadq */
+    var33 = ptr5[i];
+    /* 2: mulconjcf */
+    {
+       orc_union64 _src1;
+       orc_union64 _src2;
+       orc_union64 _dest1;
+       orc_union32 _rr, _ir, _ii, _ri;
+       _src1.i = var32.i;
+       _src2.i = var33.i;
+       _src1.x2[0] = ORC_DENORMAL(_src1.x2[0]);
+       _src1.x2[1] = ORC_DENORMAL(_src1.x2[1]);
+       _src2.x2[0] = ORC_DENORMAL(_src2.x2[0]);
+       _src2.x2[1] = ORC_DENORMAL(_src2.x2[1]);
+       _rr.f = _src1.x2f[0] * _src2.x2f[0];
+       _ir.f = _src1.x2f[1] * _src2.x2f[0];
+       _ii.f = _src1.x2f[1] * _src2.x2f[1];
+       _ri.f = _src1.x2f[0] * _src2.x2f[1];
+       _rr.i = ORC_DENORMAL(_rr.i);
+       _ir.i = ORC_DENORMAL(_ir.i);
+       _ii.i = ORC_DENORMAL(_ii.i);
+       _ri.i = ORC_DENORMAL(_ri.i);
+       _dest1.x2f[0] = _rr.f + _ii.f;
+       _dest1.x2f[1] = _ir.f - _ri.f;
+       _dest1.x2[0] = ORC_DENORMAL(_dest1.x2[0]);
+       _dest1.x2[1] = ORC_DENORMAL(_dest1.x2[1]);
+       var34.i = _dest1.i;
+    }
+    /* 3: storeq */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+emulate_magsqcf (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_union32 * ORC_RESTRICT ptr0;
+  const orc_union64 * ORC_RESTRICT ptr4;
+  orc_union64 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union64 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: magsqcf */
+    {
+       orc_union64 _src1;
+       orc_union32 _rr, _ii, _dest1;
+       _src1.i = var32.i;
+       _src1.x2[0] = ORC_DENORMAL(_src1.x2[0]);
+       _src1.x2[1] = ORC_DENORMAL(_src1.x2[1]);
+       _rr.f = _src1.x2f[0] * _src1.x2f[0];
+       _ii.f = _src1.x2f[1] * _src1.x2f[1];
+       _rr.i = ORC_DENORMAL(_rr.i);
+       _ii.i = ORC_DENORMAL(_ii.i);
+       _dest1.f = _rr.f + _ii.f;
+       var33.i = ORC_DENORMAL(_dest1.i);
+    }
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+emulate_matrowlb (OrcOpcodeExecutor *ex, int offset, int n)
+{
+  int i;
+  orc_int8 * ORC_RESTRICT ptr0;
+  const orc_union32 * ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *)ex->dest_ptrs[0];
+  ptr4 = (orc_union32 *)ex->src_ptrs[0];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: matrowlb */
+    {
+       orc_union32 _src1;
+       orc_union64 _src2;
+       int _sum;
+       _src1.i = var32.i;
+       _src2.i = ((orc_union64 *)(ex->src_ptrs[1]))->i;
+       _sum = 4 * _src2.x4[0] + (orc_uint8)_src1.x4[1] * _src2.x4[1] + (orc_uint8)_src1.x4[2] * _src2.x4[2] + (orc_uint8)_src1.x4[3] * _src2.x4[3];
+       var33 = ORC_CLAMP_UB(_sum >> 8);
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
@@ -198,6 +198,74 @@ void emulate_convdl (OrcOpcodeExecutor *ex, int i, int n);
 void emulate_convld (OrcOpcodeExecutor *ex, int i, int n);
 void emulate_convfd (OrcOpcodeExecutor *ex, int i, int n);
 void emulate_convdf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_fmaf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_fmsf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_fnmaf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_fmad (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_convhf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_convfh (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_convbf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_convfb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_roundf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_floorf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_ceilf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_truncf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_rcpf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_rsqrtf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_expf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_logf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_sinf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_cosf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_powf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadch3b (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadch4b (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadch3w (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadch4w (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_storech3b (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_storech3w (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadstrb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadstrw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadstrl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadstrq (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_storestrb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_storestrw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_storestrl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_storestrq (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_scanaddw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_scanaddl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_scanaddf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_maddswl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_maddusbw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_ldresbilinb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_ldresbilinl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_selectb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_selectw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_selectl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_selectf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_selectd (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_unpacklb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_unpacklw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_packbl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_packwl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_popcntb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_popcntw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_popcntl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_clzw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_clzl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_bitrevb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_shufflel (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_shuffleq (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadtrb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadtrw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadtrl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_loadtrq (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_findb (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_findw (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_findl (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_mulcf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_mulconjcf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_magsqcf (OrcOpcodeExecutor *ex, int i, int n);
+void emulate_matrowlb (OrcOpcodeExecutor *ex, int i, int n);
 
 #endif
 
@@ -15,6 +15,8 @@
  */
 
 #define CHUNK_SIZE 16
+/* arrays of 3-channel elements only need the alignment of one channel */
+#define ALIGNMENT_MASK(size) (((size) & -(size)) - 1)
 
 OrcExecutor *
 orc_executor_new (OrcProgram *program)
@@ -36,17 +38,45 @@ orc_executor_free (OrcExecutor *ex)
   free (ex);
 }
 
+/* Compiled code may address an in-place source through its
+ * destination's pointer, so a call with different arrays would read the
+ * wrong data.  The emulator always uses both arrays. */
+static int
+orc_executor_check_inplace (OrcExecutor *ex, OrcCode *code)
+{
+  int i;
+
+  if (code == NULL || code->vars == NULL) return TRUE;
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    int dest = code->vars[i].inplace_dest;
+
+    if (!code->vars[i].inplace) continue;
+    if (ex->arrays[i] != ex->arrays[dest] ||
+        (code->is_2d && ex->params[i] != ex->params[dest])) {
+      ORC_ERROR("in-place arrays %d and %d differ, emulating", dest, i);
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
 void
 orc_executor_run (OrcExecutor *ex)
 {
   void (*func) (OrcExecutor *);
+  OrcCode *code;
 
   if (ex->program) {
     func = ex->program->code_exec;
+    code = ex->program->orccode;
   } else {
-    OrcCode *code = (OrcCode *)ex->arrays[ORC_VAR_A2];
+    code = (OrcCode *)ex->arrays[ORC_VAR_A2];
     func = code->exec;
   }
+  if (func && orc_debug_get_level () >= ORC_DEBUG_WARNING &&
+      !orc_executor_check_inplace (ex, code)) {
+    func = NULL;
+  }
   if (func) {
     func (ex);
     /* ORC_ERROR("counters %d %d %d", ex->counter1, ex->counter2, ex->counter3); */
@@ -97,6 +127,26 @@ orc_executor_set_stride (OrcExecutor *ex, int var, int stride)
   ex->params[var] = stride;
 }
 
+/**
+ * orc_executor_set_ring:
+ * @ex: the OrcExecutor
+ * @var: a source or destination variable marked with
+ *   orc_program_set_var_ring()
+ * @size: number of elements in the ring buffer
+ * @start: element of the ring buffer where the call starts
+ *
+ * Sets the size of the ring buffer set with orc_executor_set_array()
+ * and the element that the first element of the call maps to.  @start
+ * must be less than @size.  The call may be longer than the ring, in
+ * which case it wraps more than once.
+ */
+void
+orc_executor_set_ring (OrcExecutor *ex, int var, int size, int start)
+{
+  ORC_EXECUTOR_RING_SIZE(ex, var) = size;
+  ORC_EXECUTOR_RING_START(ex, var) = start;
+}
+
 void
 orc_executor_set_array_str (OrcExecutor *ex, const char *name, void *ptr)
 {
@@ -222,18 +272,144 @@ load_constant (void *data, int size, orc_uint64 value)
 }
 
 
+static int
+orc_code_has_ring (OrcCode *code)
+{
+  int i;
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (code->vars[i].ring) return TRUE;
+  }
+  return FALSE;
+}
+
+/* Runs func once for each range of the call that does not cross the
+ * end of a ring buffer.  Other arrays advance as they would in a single
+ * call, and accumulators are summed over the ranges. */
+static void
+orc_executor_run_ring (OrcExecutor *ex, OrcCode *code, OrcExecutorFunc func)
+{
+  OrcExecutor tmp;
+  unsigned int acc[4] = { 0, 0, 0, 0 };
+  int pos[ORC_N_ARRAYS];
+  int done;
+  int n;
+  int i;
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (!code->vars[i].ring) continue;
+    if (ORC_EXECUTOR_RING_SIZE(ex, i) <= 0 ||
+        ORC_EXECUTOR_RING_START(ex, i) < 0 ||
+        ORC_EXECUTOR_RING_START(ex, i) >= ORC_EXECUTOR_RING_SIZE(ex, i)) {
+      ORC_ERROR("bad ring buffer size %d start %d for array %d",
+          ORC_EXECUTOR_RING_SIZE(ex, i), ORC_EXECUTOR_RING_START(ex, i), i);
+      return;
+    }
+    pos[i] = ORC_EXECUTOR_RING_START(ex, i);
+  }
+
+  memcpy (&tmp, ex, sizeof(OrcExecutor));
+  for(done=0;done<ex->n;done+=n){
+    n = ex->n - done;
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      if (code->vars[i].ring && n > ORC_EXECUTOR_RING_SIZE(ex, i) - pos[i]) {
+        n = ORC_EXECUTOR_RING_SIZE(ex, i) - pos[i];
+      }
+    }
+
+    tmp.n = n;
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      if (code->vars[i].size == 0) continue;
+      tmp.arrays[i] = ORC_PTR_OFFSET(ex->arrays[i],
+          (code->vars[i].ring ? pos[i] : done) * code->vars[i].size);
+    }
+    func (&tmp);
+    for(i=0;i<4;i++){
+      acc[i] += tmp.accumulators[i];
+    }
+
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      if (!code->vars[i].ring) continue;
+      pos[i] += n;
+      if (pos[i] == ORC_EXECUTOR_RING_SIZE(ex, i)) pos[i] = 0;
+    }
+  }
+
+  for(i=0;i<4;i++){
+    if (code->vars[ORC_VAR_A1 + i].size == 2) {
+      acc[i] &= 0xffff;
+    }
+    ex->accumulators[i] = acc[i];
+  }
+}
+
+/* Installed as OrcCode.exec for programs with ring buffers the
+ * compiled code does not wrap itself.  The compiled code is in
+ * OrcCode.exec_serial. */
+static void
+orc_executor_ring_exec (OrcExecutor *ex)
+{
+  OrcCode *code;
+
+  if (ex->program) {
+    code = ex->program->orccode;
+  } else {
+    code = (OrcCode *)ex->arrays[ORC_VAR_A2];
+  }
+  if (code == NULL || code->exec_serial == NULL) {
+    orc_executor_emulate (ex);
+    return;
+  }
+  orc_executor_run_ring (ex, code, code->exec_serial);
+}
+
+/* Called by the compiler once the code is generated.  Targets that
+ * wrap the rings in the generated loop need no split. */
+void
+_orc_ring_setup (OrcCompiler *compiler, OrcCode *code)
+{
+  if (!orc_code_has_ring (code) || compiler->ring_wrap) return;
+
+  code->exec_serial = code->exec;
+  code->exec = orc_executor_ring_exec;
+  /* a batch entry would call the code without the split */
+  code->exec_batch = NULL;
+}
+
+static void orc_executor_emulate_serial (OrcExecutor *ex);
+
 void
 orc_executor_emulate (OrcExecutor *ex)
+{
+  OrcCode *code;
+
+  if (ex->program) {
+    code = ex->program->orccode;
+  } else {
+    code = (OrcCode *)ex->arrays[ORC_VAR_A2];
+  }
+
+  if (code && orc_code_has_ring (code)) {
+    orc_executor_run_ring (ex, code, orc_executor_emulate_serial);
+  } else {
+    orc_executor_emulate_serial (ex);
+  }
+}
+
+static void
+orc_executor_emulate_serial (OrcExecutor *ex)
 {
   int i;
   int j;
   int k;
   int m, m_index;
+  int tile_start, tile_end;
   OrcCode *code;
   OrcInstruction *insn;
   OrcStaticOpcode *opcode;
   OrcOpcodeExecutor *opcode_ex;
   void *tmpspace[ORC_N_COMPILER_VARIABLES] = { 0 };
+  int *find_acc = NULL;
 
   if (ex->program) {
     code = ex->program->orccode;
@@ -307,13 +483,15 @@ orc_executor_emulate (OrcExecutor *ex)
       } else if (var->vartype == ORC_VAR_TYPE_TEMP) {
         opcode_ex[j].src_ptrs[k] = tmpspace[insn->src_args[k]];
       } else if (var->vartype == ORC_VAR_TYPE_SRC) {
-        if (ORC_PTR_TO_INT(ex->arrays[insn->src_args[k]]) & (var->size - 1)) {
+        if (ORC_PTR_TO_INT(ex->arrays[insn->src_args[k]]) & ALIGNMENT_MASK(var->size)) {
           ORC_ERROR("Unaligned array for src%d, program %s",
               (insn->src_args[k]-ORC_VAR_S1), ex->program->name);
         }
         opcode_ex[j].src_ptrs[k] = ex->arrays[insn->src_args[k]];
+        /* the stride, for opcodes that read the next row */
+        opcode_ex[j].src_values[k] = ex->params[insn->src_args[k]];
       } else if (var->vartype == ORC_VAR_TYPE_DEST) {
-        if (ORC_PTR_TO_INT(ex->arrays[insn->src_args[k]]) & (var->size - 1)) {
+        if (ORC_PTR_TO_INT(ex->arrays[insn->src_args[k]]) & ALIGNMENT_MASK(var->size)) {
           ORC_ERROR("Unaligned array for dest%d, program %s",
               (insn->src_args[k]-ORC_VAR_D1), ex->program->name);
         }
@@ -330,8 +508,11 @@ orc_executor_emulate (OrcExecutor *ex)
       } else if (var->vartype == ORC_VAR_TYPE_ACCUMULATOR) {
         opcode_ex[j].dest_ptrs[k] =
           &ex->accumulators[insn->dest_args[k] - ORC_VAR_A1];
+        if (opcode->flags & ORC_STATIC_OPCODE_FIND) {
+          find_acc = &ex->accumulators[insn->dest_args[k] - ORC_VAR_A1];
+        }
       } else if (var->vartype == ORC_VAR_TYPE_DEST) {
-        if (ORC_PTR_TO_INT(ex->arrays[insn->dest_args[k]]) & (var->size - 1)) {
+        if (ORC_PTR_TO_INT(ex->arrays[insn->dest_args[k]]) & ALIGNMENT_MASK(var->size)) {
           ORC_ERROR("Unaligned array for dest%d, program %s",
               (insn->dest_args[k]-ORC_VAR_D1), ex->program->name);
         }
@@ -344,46 +525,62 @@ orc_executor_emulate (OrcExecutor *ex)
   }
   
   ORC_DEBUG("src ptr %p stride %d", ex->arrays[ORC_VAR_S1], ex->params[ORC_VAR_S1]);
-  for(m_index=0;m_index<m;m_index++){
-    ORC_DEBUG("m_index %d m %d", m_index, m);
-
-    for(j=0;j<code->n_insns;j++){
-      insn = code->insns + j;
-      opcode = insn->opcode;
-
-      for(k=0;k<ORC_STATIC_OPCODE_N_SRC;k++) {
-        OrcCodeVariable *var = code->vars + insn->src_args[k];
-        if (opcode->src_size[k] == 0) continue;
-
-        if (var->vartype == ORC_VAR_TYPE_SRC) {
-          opcode_ex[j].src_ptrs[k] =
-            ORC_PTR_OFFSET(ex->arrays[insn->src_args[k]],
-                ex->params[insn->src_args[k]]*m_index);
-        } else if (var->vartype == ORC_VAR_TYPE_DEST) {
-          opcode_ex[j].src_ptrs[k] =
-            ORC_PTR_OFFSET(ex->arrays[insn->src_args[k]],
-                ex->params[insn->src_args[k]]*m_index);
+  /* with tiling, each column strip is done for all rows in turn */
+  for(tile_start=0;tile_start<ex->n;tile_start=tile_end){
+    tile_end = ex->n;
+    if (code->tile_n > 0 && tile_end - tile_start > code->tile_n) {
+      tile_end = tile_start + code->tile_n;
+    }
+    for(m_index=0;m_index<m;m_index++){
+      ORC_DEBUG("m_index %d m %d", m_index, m);
+
+      for(j=0;j<code->n_insns;j++){
+        insn = code->insns + j;
+        opcode = insn->opcode;
+
+        for(k=0;k<ORC_STATIC_OPCODE_N_SRC;k++) {
+          OrcCodeVariable *var = code->vars + insn->src_args[k];
+          if (opcode->src_size[k] == 0) continue;
+
+          if (var->vartype == ORC_VAR_TYPE_SRC &&
+              strncmp (opcode->name, "loadtr", 6) == 0) {
+            /* transposed sources move one element per row */
+            opcode_ex[j].src_ptrs[k] =
+              ORC_PTR_OFFSET(ex->arrays[insn->src_args[k]],
+                  var->size*m_index);
+          } else if (var->vartype == ORC_VAR_TYPE_SRC) {
+            opcode_ex[j].src_ptrs[k] =
+              ORC_PTR_OFFSET(ex->arrays[insn->src_args[k]],
+                  ex->params[insn->src_args[k]]*m_index);
+          } else if (var->vartype == ORC_VAR_TYPE_DEST) {
+            opcode_ex[j].src_ptrs[k] =
+              ORC_PTR_OFFSET(ex->arrays[insn->src_args[k]],
+                  ex->params[insn->src_args[k]]*m_index);
+          }
         }
-      }
-      for(k=0;k<ORC_STATIC_OPCODE_N_DEST;k++) {
-        OrcCodeVariable *var = code->vars + insn->dest_args[k];
-        if (opcode->dest_size[k] == 0) continue;
-
-        if (var->vartype == ORC_VAR_TYPE_DEST) {
-          opcode_ex[j].dest_ptrs[k] =
-            ORC_PTR_OFFSET(ex->arrays[insn->dest_args[k]],
-                ex->params[insn->dest_args[k]]*m_index);
+        for(k=0;k<ORC_STATIC_OPCODE_N_DEST;k++) {
+          OrcCodeVariable *var = code->vars + insn->dest_args[k];
+          if (opcode->dest_size[k] == 0) continue;
+
+          if (var->vartype == ORC_VAR_TYPE_DEST) {
+            opcode_ex[j].dest_ptrs[k] =
+              ORC_PTR_OFFSET(ex->arrays[insn->dest_args[k]],
+                  ex->params[insn->dest_args[k]]*m_index);
+          }
         }
       }
-    }
 
-    for(i=0;i<ex->n;i+=CHUNK_SIZE){
-      for(j=0;j<code->n_insns;j++){
-        if (ex->n - i >= CHUNK_SIZE) {
-          opcode_ex[j].emulateN (opcode_ex + j, i, CHUNK_SIZE << opcode_ex[j].shift);
-        } else {
-          opcode_ex[j].emulateN (opcode_ex + j, i, (ex->n - i) << opcode_ex[j].shift);
+      for(i=tile_start;i<tile_end;i+=CHUNK_SIZE){
+        for(j=0;j<code->n_insns;j++){
+          if (tile_end - i >= CHUNK_SIZE) {
+            opcode_ex[j].emulateN (opcode_ex + j, i, CHUNK_SIZE << opcode_ex[j].shift);
+          } else {
+            opcode_ex[j].emulateN (opcode_ex + j, i, (tile_end - i) << opcode_ex[j].shift);
+          }
         }
+        /* a find counts the elements before its match, so it stops
+         * counting short of the end of the chunk holding it */
+        if (find_acc && *find_acc < MIN (i + CHUNK_SIZE, tile_end)) break;
       }
     }
   }
@@ -58,6 +58,8 @@ struct _OrcExecutor {
   /* m_index is stored in params[ORC_VAR_A2] */
   /* elapsed time is stored in params[ORC_VAR_A3] */
   /* high half of params is stored in params[ORC_VAR_T1..] */
+  /* ring size for arrays[x] is stored in params[ORC_VAR_T9+x] */
+  /* ring start for arrays[x] is stored in params[ORC_VAR_T9+ORC_N_ARRAYS+x] */
 };
 
 /* the alternate view of OrcExecutor */
@@ -81,13 +83,17 @@ struct _OrcExecutorAlt {
   int unused4[8];
   int params[ORC_VAR_T1-ORC_VAR_P1];
   int params_hi[ORC_VAR_T1-ORC_VAR_P1];
-  int unused3[ORC_N_VARIABLES - ORC_VAR_T9];
+  int ring_sizes[ORC_N_ARRAYS];
+  int ring_starts[ORC_N_ARRAYS];
   int accumulators[4];
 };
 #define ORC_EXECUTOR_EXEC(ex) ((OrcExecutorFunc)((ex)->arrays[ORC_VAR_A1]))
 #define ORC_EXECUTOR_M(ex) ((ex)->params[ORC_VAR_A1])
 #define ORC_EXECUTOR_M_INDEX(ex) ((ex)->params[ORC_VAR_A2])
 #define ORC_EXECUTOR_TIME(ex) ((ex)->params[ORC_VAR_A3])
+#define ORC_EXECUTOR_RING_SIZE(ex,var) ((ex)->params[ORC_VAR_T9+(var)])
+#define ORC_EXECUTOR_RING_START(ex,var) \
+  ((ex)->params[ORC_VAR_T9+ORC_N_ARRAYS+(var)])
 
 
 
@@ -102,6 +108,8 @@ ORC_API void orc_executor_set_array (OrcExecutor *ex, int var, void *ptr);
 
 ORC_API void orc_executor_set_stride (OrcExecutor *ex, int var, int stride);
 
+ORC_API void orc_executor_set_ring (OrcExecutor *ex, int var, int size, int start);
+
 ORC_API void orc_executor_set_array_str (OrcExecutor *ex, const char *name, void *ptr);
 
 ORC_API void orc_executor_set_param (OrcExecutor *ex, int var, int value);
@@ -128,6 +136,10 @@ ORC_API void orc_executor_run (OrcExecutor *ex);
 
 ORC_API void orc_executor_run_backup (OrcExecutor *ex);
 
+ORC_API void orc_parallel_set_n_threads (int n_threads);
+
+ORC_API int  orc_parallel_get_n_threads (void);
+
 
 ORC_END_DECLS
 
@@ -31,6 +31,7 @@ struct _OrcInstruction {
 
 #define ORC_INSN_FLAG_INVARIANT (1<<2)
 #define ORC_INSN_FLAG_ADDED (1<<3)
+#define ORC_INSN_FLAG_TAP_WINDOW (1<<4)
 
 
 ORC_END_DECLS
@@ -35,6 +35,9 @@ struct _OrcOpcodeSet {
 #define ORC_STATIC_OPCODE_INVARIANT (1<<6)
 #define ORC_STATIC_OPCODE_ITERATOR (1<<7)
 #define ORC_STATIC_OPCODE_COPY (1<<8)
+#define ORC_STATIC_OPCODE_SCAN (1<<9)
+#define ORC_STATIC_OPCODE_FIND (1<<10)
+#define ORC_STATIC_OPCODE_COMPLEX (1<<11)
 
 
 struct _OrcStaticOpcode {
@@ -499,6 +499,108 @@ static OrcStaticOpcode opcodes[] = {
   { "convfd", ORC_STATIC_OPCODE_FLOAT, { 8 }, { 4 }, emulate_convfd },
   { "convdf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 8 }, emulate_convdf },
 
+  /* fused multiply-add, single rounding */
+  { "fmaf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4, 4, 4 }, emulate_fmaf },
+  { "fmsf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4, 4, 4 }, emulate_fmsf },
+  { "fnmaf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4, 4, 4 }, emulate_fnmaf },
+  { "fmad", ORC_STATIC_OPCODE_FLOAT, { 8 }, { 8, 8, 8 }, emulate_fmad },
+
+  /* half (IEEE binary16) and bfloat16 conversions */
+  { "convhf", ORC_STATIC_OPCODE_FLOAT_DEST, { 4 }, { 2 }, emulate_convhf },
+  { "convfh", ORC_STATIC_OPCODE_FLOAT_SRC, { 2 }, { 4 }, emulate_convfh },
+  { "convbf", ORC_STATIC_OPCODE_FLOAT_DEST, { 4 }, { 2 }, emulate_convbf },
+  { "convfb", ORC_STATIC_OPCODE_FLOAT_SRC, { 2 }, { 4 }, emulate_convfb },
+
+  /* rounding to integer values; roundf rounds halfway cases to even */
+  { "roundf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_roundf },
+  { "floorf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_floorf },
+  { "ceilf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_ceilf },
+  { "truncf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_truncf },
+  /* may differ from the emulated result by 2 ulp */
+  { "rcpf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_rcpf },
+  { "rsqrtf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_rsqrtf },
+
+  /* polynomial approximations, see orcprogram-c.c for accuracy */
+  { "expf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_expf },
+  { "logf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_logf },
+  { "sinf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_sinf },
+  { "cosf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4 }, emulate_cosf },
+  { "powf", ORC_STATIC_OPCODE_FLOAT, { 4 }, { 4, 4 }, emulate_powf },
+
+  /* arrays of 3- and 4-channel elements, one channel per register */
+  { "loadch3b", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 1 }, { 3, 4 }, emulate_loadch3b },
+  { "loadch4b", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 1 }, { 4, 4 }, emulate_loadch4b },
+  { "loadch3w", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 2 }, { 6, 4 }, emulate_loadch3w },
+  { "loadch4w", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 2 }, { 8, 4 }, emulate_loadch4w },
+  { "storech3b", ORC_STATIC_OPCODE_STORE, { 3 }, { 1, 1, 1 }, emulate_storech3b },
+  { "storech3w", ORC_STATIC_OPCODE_STORE, { 6 }, { 2, 2, 2 }, emulate_storech3w },
+
+  /* every n-th element of an array, n in the last source */
+  { "loadstrb", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 1 }, { 1, 4 }, emulate_loadstrb },
+  { "loadstrw", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 2 }, { 2, 4 }, emulate_loadstrw },
+  { "loadstrl", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 4 }, { 4, 4 }, emulate_loadstrl },
+  { "loadstrq", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 8 }, { 8, 4 }, emulate_loadstrq },
+  { "storestrb", ORC_STATIC_OPCODE_STORE|ORC_STATIC_OPCODE_SCALAR, { 1 }, { 1, 4 }, emulate_storestrb },
+  { "storestrw", ORC_STATIC_OPCODE_STORE|ORC_STATIC_OPCODE_SCALAR, { 2 }, { 2, 4 }, emulate_storestrw },
+  { "storestrl", ORC_STATIC_OPCODE_STORE|ORC_STATIC_OPCODE_SCALAR, { 4 }, { 4, 4 }, emulate_storestrl },
+  { "storestrq", ORC_STATIC_OPCODE_STORE|ORC_STATIC_OPCODE_SCALAR, { 8 }, { 8, 4 }, emulate_storestrq },
+
+  /* running sums, restarting at each row */
+  { "scanaddw", ORC_STATIC_OPCODE_SCAN, { 2 }, { 2 }, emulate_scanaddw },
+  { "scanaddl", ORC_STATIC_OPCODE_SCAN, { 4 }, { 4 }, emulate_scanaddl },
+  { "scanaddf", ORC_STATIC_OPCODE_FLOAT|ORC_STATIC_OPCODE_SCAN, { 4 }, { 4 }, emulate_scanaddf },
+
+  /* pairwise multiply-add */
+  { "maddswl", 0, { 4 }, { 4, 4 }, emulate_maddswl },
+  { "maddusbw", 0, { 2 }, { 2, 2 }, emulate_maddusbw },
+
+  /* bilinear resampling of a row and the row one stride below */
+  { "ldresbilinb", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 1 }, { 1, 8, 4 }, emulate_ldresbilinb },
+  { "ldresbilinl", ORC_STATIC_OPCODE_LOAD|ORC_STATIC_OPCODE_SCALAR, { 4 }, { 4, 8, 4 }, emulate_ldresbilinl },
+
+  /* select b where the sign bit of a is set, else c */
+  { "selectb", 0, { 1 }, { 1, 1, 1 }, emulate_selectb },
+  { "selectw", 0, { 2 }, { 2, 2, 2 }, emulate_selectw },
+  { "selectl", 0, { 4 }, { 4, 4, 4 }, emulate_selectl },
+  { "selectf", 0, { 4 }, { 4, 4, 4 }, emulate_selectf },
+  { "selectd", 0, { 8 }, { 8, 8, 8 }, emulate_selectd },
+
+  /* b-bit fields of a 32-bit lane to and from byte or word lanes */
+  { "unpacklb", ORC_STATIC_OPCODE_SCALAR, { 8 }, { 4, 4 }, emulate_unpacklb },
+  { "unpacklw", ORC_STATIC_OPCODE_SCALAR, { 8 }, { 4, 4 }, emulate_unpacklw },
+  { "packbl", ORC_STATIC_OPCODE_SCALAR, { 4 }, { 8, 4 }, emulate_packbl },
+  { "packwl", ORC_STATIC_OPCODE_SCALAR, { 4 }, { 8, 4 }, emulate_packwl },
+
+  /* bit counting */
+  { "popcntb", 0, { 1 }, { 1 }, emulate_popcntb },
+  { "popcntw", 0, { 2 }, { 2 }, emulate_popcntw },
+  { "popcntl", 0, { 4 }, { 4 }, emulate_popcntl },
+  { "clzw", 0, { 2 }, { 2 }, emulate_clzw },
+  { "clzl", 0, { 4 }, { 4 }, emulate_clzl },
+  { "bitrevb", 0, { 1 }, { 1 }, emulate_bitrevb },
+
+  /* byte k of the element is byte (b >> 4k) & 15 of a, or 0 if out of range */
+  { "shufflel", ORC_STATIC_OPCODE_SCALAR, { 4 }, { 4, 4 }, emulate_shufflel },
+  { "shuffleq", ORC_STATIC_OPCODE_SCALAR, { 8 }, { 8, 4 }, emulate_shuffleq },
+
+  /* element j of row i of a transposed source, in row j */
+  { "loadtrb", ORC_STATIC_OPCODE_LOAD, { 1 }, { 1 }, emulate_loadtrb },
+  { "loadtrw", ORC_STATIC_OPCODE_LOAD, { 2 }, { 2 }, emulate_loadtrw },
+  { "loadtrl", ORC_STATIC_OPCODE_LOAD, { 4 }, { 4 }, emulate_loadtrl },
+  { "loadtrq", ORC_STATIC_OPCODE_LOAD, { 8 }, { 8 }, emulate_loadtrq },
+
+  /* index of the first nonzero element, or n; the loop stops there */
+  { "findb", ORC_STATIC_OPCODE_ACCUMULATOR|ORC_STATIC_OPCODE_FIND, { 4 }, { 1 }, emulate_findb },
+  { "findw", ORC_STATIC_OPCODE_ACCUMULATOR|ORC_STATIC_OPCODE_FIND, { 4 }, { 2 }, emulate_findw },
+  { "findl", ORC_STATIC_OPCODE_ACCUMULATOR|ORC_STATIC_OPCODE_FIND, { 4 }, { 4 }, emulate_findl },
+
+  /* complex floats, the real part first: a * b, a * conj(b) and |a|^2 */
+  { "mulcf", ORC_STATIC_OPCODE_FLOAT|ORC_STATIC_OPCODE_COMPLEX, { 8 }, { 8, 8 }, emulate_mulcf },
+  { "mulconjcf", ORC_STATIC_OPCODE_FLOAT|ORC_STATIC_OPCODE_COMPLEX, { 8 }, { 8, 8 }, emulate_mulconjcf },
+  { "magsqcf", ORC_STATIC_OPCODE_FLOAT|ORC_STATIC_OPCODE_COMPLEX, { 4 }, { 8 }, emulate_magsqcf },
+  /* one row of a fixed-point color matrix applied to bytes 1-3 */
+  { "matrowlb", ORC_STATIC_OPCODE_SCALAR, { 1 }, { 4, 8 }, emulate_matrowlb },
+
   { "" }
 };
 
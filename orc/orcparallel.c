@@ -0,0 +1,320 @@
+
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <orc/orcprogram.h>
+#include <orc/orcdebug.h>
+#include <orc/orcinternal.h>
+
+#if defined(HAVE_THREAD_PTHREAD)
+#include <pthread.h>
+#endif
+
+/**
+ * SECTION:orcparallel
+ * @title: Parallel execution
+ * @short_description: Running long 1D calls on several threads
+ *
+ * When enabled with orc_parallel_set_n_threads() or the ORC_THREADS
+ * environment variable, programs compiled afterwards split calls with
+ * a large n into ranges, which run on a pool of worker threads.  Each
+ * range is sized to fit in the level 2 data cache.  Accumulators are
+ * summed across ranges.
+ *
+ * Only one-dimensional programs without a constant n are split.
+ * Programs using iterator opcodes (loadupdb, loadupib) or resampling
+ * loads (ldresnearb, ldreslinb, ...) always run on the calling thread,
+ * since their element positions depend on the start of the call.
+ * Element-strided arrays (loadstrb, storestrb, ...) are not split
+ * either, as the slices would have to advance by the element stride,
+ * and neither are running sums (scanaddw, ...), which depend on all
+ * elements before them, or searches (findb, ...), which stop at the
+ * first match.  Programs with ring buffers are already split where the
+ * rings wrap and run on the calling thread.
+ */
+
+#define ORC_PARALLEL_MAX_THREADS 64
+/* below this many bytes per call, thread wakeup costs more than it saves */
+#define ORC_PARALLEL_MIN_BYTES (1<<20)
+#define ORC_PARALLEL_MIN_RANGE_BYTES (64*1024)
+
+static int _orc_parallel_n_threads = 1;
+
+void
+_orc_parallel_init (void)
+{
+  const char *envvar;
+
+  envvar = getenv ("ORC_THREADS");
+  if (envvar != NULL) {
+    orc_parallel_set_n_threads (strtol (envvar, NULL, 0));
+  }
+}
+
+/**
+ * orc_parallel_set_n_threads:
+ * @n_threads: number of threads, including the calling thread
+ *
+ * Sets the number of threads used to run long one-dimensional calls.
+ * A value of 0 or 1 disables parallel execution, which is the default.
+ * Only programs compiled after this call are affected.
+ */
+void
+orc_parallel_set_n_threads (int n_threads)
+{
+  if (n_threads < 1) n_threads = 1;
+  if (n_threads > ORC_PARALLEL_MAX_THREADS) {
+    n_threads = ORC_PARALLEL_MAX_THREADS;
+  }
+#if !defined(HAVE_THREAD_PTHREAD)
+  n_threads = 1;
+#endif
+  _orc_parallel_n_threads = n_threads;
+}
+
+/**
+ * orc_parallel_get_n_threads:
+ *
+ * Returns: the number of threads used to run long one-dimensional
+ * calls, or 1 if parallel execution is disabled.
+ */
+int
+orc_parallel_get_n_threads (void)
+{
+  return _orc_parallel_n_threads;
+}
+
+static int
+orc_parallel_element_bytes (OrcCode *code)
+{
+  int bytes = 0;
+  int i;
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    bytes += code->vars[i].size;
+  }
+  return bytes;
+}
+
+static void
+orc_parallel_run_range (OrcCode *code, OrcExecutor *ex, int start, int n,
+    int *accumulators)
+{
+  OrcExecutor tmp;
+  int i;
+
+  memcpy (&tmp, ex, sizeof(OrcExecutor));
+  tmp.n = n;
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (code->vars[i].size == 0) continue;
+    tmp.arrays[i] = ORC_PTR_OFFSET(ex->arrays[i], start * code->vars[i].size);
+  }
+  code->exec_serial (&tmp);
+  for(i=0;i<4;i++){
+    accumulators[i] = tmp.accumulators[i];
+  }
+}
+
+#if defined(HAVE_THREAD_PTHREAD)
+
+typedef struct _OrcParallelJob OrcParallelJob;
+struct _OrcParallelJob {
+  OrcCode *code;
+  OrcExecutor *ex;
+  int range_size;
+  int n_ranges;
+  int next_range;
+  int n_done;
+  unsigned int accumulators[4];
+};
+
+static pthread_mutex_t pool_run_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done_cond = PTHREAD_COND_INITIALIZER;
+static OrcParallelJob *pool_job;
+static int pool_n_workers;
+
+/* called with pool_mutex held, returns with it held */
+static void
+orc_parallel_do_range (OrcParallelJob *job, int range)
+{
+  int acc[4];
+  int start;
+  int n;
+  int i;
+
+  start = range * job->range_size;
+  n = job->ex->n - start;
+  if (n > job->range_size) n = job->range_size;
+
+  pthread_mutex_unlock (&pool_mutex);
+  orc_parallel_run_range (job->code, job->ex, start, n, acc);
+  pthread_mutex_lock (&pool_mutex);
+
+  for(i=0;i<4;i++){
+    job->accumulators[i] += acc[i];
+  }
+  job->n_done++;
+  if (job->n_done == job->n_ranges) {
+    pthread_cond_broadcast (&pool_done_cond);
+  }
+}
+
+static void *
+orc_parallel_worker (void *data)
+{
+  pthread_mutex_lock (&pool_mutex);
+  for(;;){
+    OrcParallelJob *job = pool_job;
+
+    if (job == NULL || job->next_range >= job->n_ranges) {
+      pthread_cond_wait (&pool_work_cond, &pool_mutex);
+      continue;
+    }
+    orc_parallel_do_range (job, job->next_range++);
+  }
+  pthread_mutex_unlock (&pool_mutex);
+
+  return NULL;
+}
+
+/* called with pool_mutex held */
+static void
+orc_parallel_start_workers (int n_workers)
+{
+  while (pool_n_workers < n_workers) {
+    pthread_t thread;
+    pthread_attr_t attr;
+    int ret;
+
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    ret = pthread_create (&thread, &attr, orc_parallel_worker, NULL);
+    pthread_attr_destroy (&attr);
+    if (ret != 0) {
+      ORC_WARNING("failed to create worker thread");
+      break;
+    }
+    pool_n_workers++;
+  }
+}
+
+static int
+orc_parallel_run (OrcCode *code, OrcExecutor *ex, int range_size)
+{
+  OrcParallelJob job;
+  int i;
+
+  /* another thread owns the pool, run on this one */
+  if (pthread_mutex_trylock (&pool_run_mutex) != 0) return FALSE;
+
+  memset (&job, 0, sizeof(job));
+  job.code = code;
+  job.ex = ex;
+  job.range_size = range_size;
+  job.n_ranges = (ex->n + range_size - 1) / range_size;
+
+  pthread_mutex_lock (&pool_mutex);
+  orc_parallel_start_workers (_orc_parallel_n_threads - 1);
+  pool_job = &job;
+  pthread_cond_broadcast (&pool_work_cond);
+
+  while (job.next_range < job.n_ranges) {
+    orc_parallel_do_range (&job, job.next_range++);
+  }
+  while (job.n_done < job.n_ranges) {
+    pthread_cond_wait (&pool_done_cond, &pool_mutex);
+  }
+  pool_job = NULL;
+  pthread_mutex_unlock (&pool_mutex);
+
+  pthread_mutex_unlock (&pool_run_mutex);
+
+  for(i=0;i<4;i++){
+    if (code->vars[ORC_VAR_A1 + i].size == 2) {
+      job.accumulators[i] &= 0xffff;
+    }
+    ex->accumulators[i] = job.accumulators[i];
+  }
+
+  return TRUE;
+}
+
+#else
+
+static int
+orc_parallel_run (OrcCode *code, OrcExecutor *ex, int range_size)
+{
+  return FALSE;
+}
+
+#endif
+
+/* Installed as OrcCode.exec for programs that can be split.  The
+ * compiled code itself is in OrcCode.exec_serial. */
+void
+_orc_parallel_exec (OrcExecutor *ex)
+{
+  OrcCode *code;
+  int element_bytes;
+  int range_size;
+
+  if (ex->program) {
+    code = ex->program->orccode;
+  } else {
+    code = (OrcCode *)ex->arrays[ORC_VAR_A2];
+  }
+  if (code == NULL || code->exec_serial == NULL) {
+    /* nothing to split, let the emulator run it (or report it) */
+    orc_executor_emulate (ex);
+    return;
+  }
+
+  element_bytes = orc_parallel_element_bytes (code);
+  if (_orc_parallel_n_threads <= 1 ||
+      (orc_int64)ex->n * element_bytes < ORC_PARALLEL_MIN_BYTES) {
+    code->exec_serial (ex);
+    return;
+  }
+
+  range_size = _orc_data_cache_size_level2 / 2;
+  if (range_size < ORC_PARALLEL_MIN_RANGE_BYTES) {
+    range_size = ORC_PARALLEL_MIN_RANGE_BYTES;
+  }
+  /* keep range starts on the same alignment as the start of the call */
+  range_size = (range_size / element_bytes) & ~63;
+
+  if (!orc_parallel_run (code, ex, range_size)) {
+    code->exec_serial (ex);
+  }
+}
+
+/* Called by the compiler once the code is generated. */
+void
+_orc_parallel_setup (OrcCompiler *compiler, OrcCode *code)
+{
+  OrcProgram *program = compiler->program;
+  int i;
+
+  if (_orc_parallel_n_threads <= 1) return;
+  if (program->is_2d || program->constant_n > 0) return;
+  if (compiler->has_iterator_opcode) return;
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].ring) return;
+  }
+  for(i=0;i<compiler->n_insns;i++){
+    if (compiler->insns[i].opcode->flags &
+        (ORC_STATIC_OPCODE_SCAN|ORC_STATIC_OPCODE_FIND)) return;
+    if (strncmp (compiler->insns[i].opcode->name, "ldres", 5) == 0) return;
+    if (strncmp (compiler->insns[i].opcode->name, "loadstr", 7) == 0) return;
+    if (strncmp (compiler->insns[i].opcode->name, "storestr", 8) == 0) return;
+  }
+  if (orc_parallel_element_bytes (code) == 0) return;
+
+  code->exec_serial = code->exec;
+  code->exec = _orc_parallel_exec;
+}
@@ -219,6 +219,19 @@ orc_parse_full (const char *code, OrcProgram ***programs, char **log)
               orc_program_set_var_alignment (parser->program, var, alignment);
               i++;
             }
+          } else if (strcmp (token[i], "stride") == 0) {
+            if (i == n_tokens - 1) {
+              orc_parse_log (parser, "error: line %d: .source stride requires stride value\n",
+                  parser->line_number);
+            } else {
+              int stride = strtol (token[i+1], NULL, 0);
+              orc_program_set_var_element_stride (parser->program, var, stride);
+              i++;
+            }
+          } else if (strcmp (token[i], "transposed") == 0) {
+            orc_program_set_var_transposed (parser->program, var);
+          } else if (strcmp (token[i], "ring") == 0) {
+            orc_program_set_var_ring (parser->program, var);
           } else if (i == n_tokens - 1) {
             orc_program_set_type_name (parser->program, var, token[i]);
           } else {
@@ -241,6 +254,17 @@ orc_parse_full (const char *code, OrcProgram ***programs, char **log)
               orc_program_set_var_alignment (parser->program, var, alignment);
               i++;
             }
+          } else if (strcmp (token[i], "stride") == 0) {
+            if (i == n_tokens - 1) {
+              orc_parse_log (parser, "error: line %d: .dest stride requires stride value\n",
+                  parser->line_number);
+            } else {
+              int stride = strtol (token[i+1], NULL, 0);
+              orc_program_set_var_element_stride (parser->program, var, stride);
+              i++;
+            }
+          } else if (strcmp (token[i], "ring") == 0) {
+            orc_program_set_var_ring (parser->program, var);
           } else if (i == n_tokens - 1) {
             orc_program_set_type_name (parser->program, var, token[i]);
           } else {
@@ -248,6 +272,21 @@ orc_parse_full (const char *code, OrcProgram ***programs, char **log)
                 parser->line_number, token[i]);
           }
         }
+      } else if (strcmp (token[0], ".inplace") == 0) {
+        int dest, src;
+        if (n_tokens < 3) {
+          orc_parse_log (parser, "error: line %d: .inplace requires destination and source\n",
+              parser->line_number);
+        } else {
+          dest = orc_program_find_var_by_name (parser->program, token[1]);
+          src = orc_program_find_var_by_name (parser->program, token[2]);
+          if (dest < 0 || src < 0) {
+            orc_parse_log (parser, "error: line %d: unknown variable in .inplace\n",
+                parser->line_number);
+          } else {
+            orc_program_set_inplace (parser->program, dest, src);
+          }
+        }
       } else if (strcmp (token[0], ".accumulator") == 0) {
         int size = strtol (token[1], NULL, 0);
         int var;
@@ -195,11 +195,39 @@ get_varname_stride (char *s, OrcCompiler *compiler, int var)
     /* https://bugzilla.gnome.org/show_bug.cgi?id=759840 */
     ORC_ASSERT (var < 48);
     sprintf(s, "%s_stride", varnames[var]);
+  } else if (compiler->target_flags & ORC_TARGET_C_OPCODE) {
+    /* see orc_executor_emulate() */
+    sprintf(s, "ex->src_values[%d]", var-ORC_VAR_S1);
   } else {
     sprintf(s, "ex->params[%d]", var);
   }
 }
 
+static void
+get_varname_ring (char *size, char *start, OrcCompiler *compiler, int var)
+{
+  if (compiler->target_flags & ORC_TARGET_C_NOEXEC) {
+    sprintf(size, "%s_ring_size", varnames[var]);
+    sprintf(start, "%s_ring_start", varnames[var]);
+  } else {
+    sprintf(size, "ex->params[%d]", ORC_VAR_T9 + var);
+    sprintf(start, "ex->params[%d]", ORC_VAR_T9 + ORC_N_ARRAYS + var);
+  }
+}
+
+static int
+c_has_ring (OrcCompiler *compiler)
+{
+  int i;
+
+  /* the emulator splits calls itself */
+  if (compiler->target_flags & ORC_TARGET_C_OPCODE) return FALSE;
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name && compiler->vars[i].ring) return TRUE;
+  }
+  return FALSE;
+}
+
 static void
 orc_compiler_c_assemble (OrcCompiler *compiler)
 {
@@ -209,6 +237,7 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
   OrcStaticOpcode *opcode;
   OrcRule *rule;
   int prefix = 0;
+  int has_ring = c_has_ring (compiler);
 
   if (!(compiler->target_flags & ORC_TARGET_C_BARE)) {
     ORC_ASM_CODE(compiler,"void\n");
@@ -220,6 +249,15 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
   if (compiler->program->is_2d) {
     ORC_ASM_CODE(compiler,"  int j;\n");
   }
+  if (has_ring) {
+    ORC_ASM_CODE(compiler,"  int k;\n");
+    ORC_ASM_CODE(compiler,"  int n_seg;\n");
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      if (compiler->vars[i].name && compiler->vars[i].ring) {
+        ORC_ASM_CODE(compiler,"  int ring%d;\n", i);
+      }
+    }
+  }
   if (compiler->program->constant_n == 0) {
     if (!(compiler->target_flags & ORC_TARGET_C_NOEXEC) &&
         !(compiler->target_flags & ORC_TARGET_C_OPCODE)) {
@@ -261,6 +299,13 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
         }
         break;
       case ORC_VAR_TYPE_SRC:
+        if (var->inplace) {
+          /* reads through the destination pointer */
+          ORC_ASM_CODE(compiler,"  const %s * ptr%d;\n",
+              c_get_type_name (var->size),
+              i);
+          break;
+        }
         ORC_ASM_CODE(compiler,"  const %s * ORC_RESTRICT ptr%d;\n",
             c_get_type_name (var->size),
             i);
@@ -303,9 +348,19 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
             char s1[40], s2[40];
             get_varname(s1, compiler, i);
             get_varname_stride(s2, compiler, i);
-            ORC_ASM_CODE(compiler,
-                "    ptr%d = ORC_PTR_OFFSET(%s, %s * j);\n",
-                i, s1, s2);
+            if (var->inplace) {
+              ORC_ASM_CODE(compiler,"    ptr%d = ptr%d;\n",
+                  i, var->inplace_dest);
+            } else if (var->transposed) {
+              /* row j starts at column j, loadtr steps by the stride */
+              ORC_ASM_CODE(compiler,
+                  "    ptr%d = ORC_PTR_OFFSET(%s, %d * j);\n",
+                  i, s1, var->size);
+            } else {
+              ORC_ASM_CODE(compiler,
+                  "    ptr%d = ORC_PTR_OFFSET(%s, %s * j);\n",
+                  i, s1, s2);
+            }
           }
           break;
         case ORC_VAR_TYPE_DEST:
@@ -322,6 +377,38 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
           break;
       }
     }
+  } else if (has_ring) {
+    /* one pass for each range that does not cross the end of a ring */
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      char s1[40], s2[40];
+      if (compiler->vars[i].name == NULL || !compiler->vars[i].ring) continue;
+      get_varname_ring(s1, s2, compiler, i);
+      ORC_ASM_CODE(compiler,"  ring%d = %s;\n", i, s2);
+    }
+    ORC_ASM_CODE(compiler,"  for (k = 0; k < n; k += n_seg) {\n");
+    ORC_ASM_CODE(compiler,"    n_seg = n - k;\n");
+    prefix = 2;
+
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      char s1[40], s2[40];
+      if (compiler->vars[i].name == NULL || !compiler->vars[i].ring) continue;
+      get_varname_ring(s1, s2, compiler, i);
+      ORC_ASM_CODE(compiler,"    if (n_seg > %s - ring%d) n_seg = %s - ring%d;\n",
+          s1, i, s1, i);
+    }
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      OrcVariable *var = compiler->vars + i;
+      char s[40];
+      if (var->name == NULL) continue;
+      get_varname(s, compiler, i);
+      if (var->ring) {
+        ORC_ASM_CODE(compiler,"    ptr%d = ORC_PTR_OFFSET(%s, %d * ring%d);\n",
+            i, s, var->size, i);
+      } else {
+        ORC_ASM_CODE(compiler,"    ptr%d = ORC_PTR_OFFSET(%s, %d * k);\n",
+            i, s, var->size);
+      }
+    }
   } else {
     for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
       OrcVariable *var = compiler->vars + i;
@@ -330,6 +417,11 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
       get_varname(s, compiler, i);
       switch (var->vartype) {
         case ORC_VAR_TYPE_SRC:
+          if (var->inplace) {
+            ORC_ASM_CODE(compiler,"  ptr%d = ptr%d;\n", i,
+                var->inplace_dest);
+            break;
+          }
           ORC_ASM_CODE(compiler,"  ptr%d = (%s *)%s;\n", i,
               c_get_type_name (var->size), s);
           break;
@@ -378,8 +470,25 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
     }
   }
 
+  /* running sums restart with each row */
+  for(j=0;j<compiler->n_insns;j++){
+    char varname[40];
+
+    insn = compiler->insns + j;
+    if (!(insn->opcode->flags & ORC_STATIC_OPCODE_SCAN)) continue;
+
+    c_get_name_int (varname, compiler, NULL, insn->dest_args[1]);
+    if (compiler->target_flags & ORC_TARGET_C_OPCODE) {
+      ORC_ASM_CODE(compiler,"%*s  %s = (offset == 0) ? 0 : ex->dest_values[0];\n",
+          prefix, "", varname);
+    } else {
+      ORC_ASM_CODE(compiler,"%*s  %s = 0;\n", prefix, "", varname);
+    }
+  }
+
   ORC_ASM_CODE(compiler,"\n");
-  ORC_ASM_CODE(compiler,"%*s  for (i = 0; i < n; i++) {\n", prefix, "");
+  ORC_ASM_CODE(compiler,"%*s  for (i = 0; i < %s; i++) {\n", prefix, "",
+      has_ring ? "n_seg" : "n");
 
   /* Emit instructions */
   for(j=0;j<compiler->n_insns;j++){
@@ -419,6 +528,16 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
   if (compiler->program->is_2d) {
     ORC_ASM_CODE(compiler,"  }\n");
   }
+  if (has_ring) {
+    for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+      char s1[40], s2[40];
+      if (compiler->vars[i].name == NULL || !compiler->vars[i].ring) continue;
+      get_varname_ring(s1, s2, compiler, i);
+      ORC_ASM_CODE(compiler,"    ring%d += n_seg;\n", i);
+      ORC_ASM_CODE(compiler,"    if (ring%d == %s) ring%d = 0;\n", i, s1, i);
+    }
+    ORC_ASM_CODE(compiler,"  }\n");
+  }
 
   for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
     char varname[40];
@@ -456,6 +575,17 @@ orc_compiler_c_assemble (OrcCompiler *compiler)
         break;
     }
   }
+  if (compiler->target_flags & ORC_TARGET_C_OPCODE) {
+    for(j=0;j<compiler->n_insns;j++){
+      char varname[40];
+
+      insn = compiler->insns + j;
+      if (!(insn->opcode->flags & ORC_STATIC_OPCODE_SCAN)) continue;
+
+      c_get_name_int (varname, compiler, NULL, insn->dest_args[1]);
+      ORC_ASM_CODE(compiler,"  ex->dest_values[0] = %s;\n", varname);
+    }
+  }
 
   if (!(compiler->target_flags & ORC_TARGET_C_BARE)) {
     ORC_ASM_CODE(compiler,"}\n");
@@ -502,7 +632,9 @@ c_get_name_int (char *name, OrcCompiler *p, OrcInstruction *insn, int var)
       if (p->vars[var].value.i == (int)p->vars[var].value.i) {
         sprintf(name, "%d", (int)p->vars[var].value.i);
       } else {
-        ORC_ASSERT(0);
+        sprintf(name, "ORC_UINT64_C(0x%08x%08x)",
+            (orc_uint32)(((orc_uint64)p->vars[var].value.i)>>32),
+            (orc_uint32)p->vars[var].value.i);
       }
     }
   } else {
@@ -559,6 +691,11 @@ c_get_type_name (int size)
       return "orc_union32";
     case 8:
       return "orc_union64";
+    /* arrays of 3-channel elements are addressed by channel */
+    case 3:
+      return "orc_int8";
+    case 6:
+      return "orc_union16";
     default:
       return "ERROR";
   }
@@ -629,6 +766,30 @@ c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
   ORC_ASM_CODE(p, "    }\n"); \
 }
 
+#define TERNARYF(name,op) \
+static void \
+c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  char dest[40], src1[40], src2[40], src3[40]; \
+\
+  c_get_name_int (dest, p, insn, insn->dest_args[0]); \
+  c_get_name_int (src1, p, insn, insn->src_args[0]); \
+  c_get_name_int (src2, p, insn, insn->src_args[1]); \
+  c_get_name_int (src3, p, insn, insn->src_args[2]); \
+ \
+  ORC_ASM_CODE(p, "    {\n"); \
+  ORC_ASM_CODE(p,"       orc_union32 _src1;\n"); \
+  ORC_ASM_CODE(p,"       orc_union32 _src2;\n"); \
+  ORC_ASM_CODE(p,"       orc_union32 _src3;\n"); \
+  ORC_ASM_CODE(p,"       orc_union32 _dest1;\n"); \
+  ORC_ASM_CODE(p,"       _src1.i = ORC_DENORMAL(%s);\n", src1); \
+  ORC_ASM_CODE(p,"       _src2.i = ORC_DENORMAL(%s);\n", src2); \
+  ORC_ASM_CODE(p,"       _src3.i = ORC_DENORMAL(%s);\n", src3); \
+  ORC_ASM_CODE(p,"       _dest1.f = " op ";\n", "_src1.f", "_src2.f", "_src3.f"); \
+  ORC_ASM_CODE(p,"       %s = ORC_DENORMAL(_dest1.i);\n", dest); \
+  ORC_ASM_CODE(p, "    }\n"); \
+}
+
 #define BINARYFL(name,op) \
 static void \
 c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
@@ -687,6 +848,30 @@ c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
   ORC_ASM_CODE(p, "    }\n"); \
 }
 
+#define TERNARYD(name,op) \
+static void \
+c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  char dest[40], src1[40], src2[40], src3[40]; \
+\
+  c_get_name_int (dest, p, insn, insn->dest_args[0]); \
+  c_get_name_int (src1, p, insn, insn->src_args[0]); \
+  c_get_name_int (src2, p, insn, insn->src_args[1]); \
+  c_get_name_int (src3, p, insn, insn->src_args[2]); \
+ \
+  ORC_ASM_CODE(p, "    {\n"); \
+  ORC_ASM_CODE(p,"       orc_union64 _src1;\n"); \
+  ORC_ASM_CODE(p,"       orc_union64 _src2;\n"); \
+  ORC_ASM_CODE(p,"       orc_union64 _src3;\n"); \
+  ORC_ASM_CODE(p,"       orc_union64 _dest1;\n"); \
+  ORC_ASM_CODE(p,"       _src1.i = ORC_DENORMAL_DOUBLE(%s);\n", src1); \
+  ORC_ASM_CODE(p,"       _src2.i = ORC_DENORMAL_DOUBLE(%s);\n", src2); \
+  ORC_ASM_CODE(p,"       _src3.i = ORC_DENORMAL_DOUBLE(%s);\n", src3); \
+  ORC_ASM_CODE(p,"       _dest1.f = " op ";\n", "_src1.f", "_src2.f", "_src3.f"); \
+  ORC_ASM_CODE(p,"       %s = ORC_DENORMAL_DOUBLE(_dest1.i);\n", dest); \
+  ORC_ASM_CODE(p, "    }\n"); \
+}
+
 #define BINARYDQ(name,op) \
 static void \
 c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
@@ -736,12 +921,14 @@ c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
 #define UNARY_WB(a,b) UNARY(a,b)
 
 #define BINARY_F(a,b) BINARYF(a,b)
+#define TERNARY_F(a,b) TERNARYF(a,b)
 #define BINARY_FL(a,b) BINARYFL(a,b)
 #define UNARY_F(a,b) UNARYF(a,b)
 #define UNARY_FL(a,b) UNARYFL(a,b)
 #define UNARY_LF(a,b) UNARYLF(a,b)
 
 #define BINARY_D(a,b) BINARYD(a,b)
+#define TERNARY_D(a,b) TERNARYD(a,b)
 #define BINARY_DQ(a,b) BINARYDQ(a,b)
 #define UNARY_D(a,b) UNARYD(a,b)
 #define UNARY_DL(a,b) UNARYFL(a,b)
@@ -761,6 +948,8 @@ c_rule_ ## name (OrcCompiler *p, void *user, OrcInstruction *insn) \
 #undef BINARY_UQ
 #undef BINARY_F
 #undef BINARY_D
+#undef TERNARY_F
+#undef TERNARY_D
 #undef UNARY_SB
 #undef UNARY_UB
 #undef UNARY_SW
@@ -980,6 +1169,67 @@ c_rule_ldreslinl (OrcCompiler *p, void *user, OrcInstruction *insn)
   ORC_ASM_CODE(p,"    }\n");
 }
 
+/* The position is x in the low half and y in the high half; only the
+ * fraction of y is used, as the weight of the row one stride below. */
+static void
+c_rule_ldresbilinX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  OrcVariable *pos = p->vars + insn->src_args[1];
+  int n_channels = ORC_PTR_TO_INT(user);
+  char x[80];
+  char y[80];
+  char src2[40];
+  char stride[40];
+  int i;
+
+  if ((p->target_flags & ORC_TARGET_C_NOEXEC) && !p->program->is_2d) {
+    ORC_COMPILER_ERROR(p, "opcode %s requires a 2D program",
+        insn->opcode->name);
+    return;
+  }
+
+  if (pos->vartype == ORC_VAR_TYPE_CONST) {
+    sprintf(x, "%d", (int)(orc_uint32)pos->value.i);
+    sprintf(y, "%d", (int)(orc_uint32)(pos->value.i >> 32));
+  } else if (p->target_flags & (ORC_TARGET_C_NOEXEC|ORC_TARGET_C_OPCODE)) {
+    char s[60];
+    c_get_name_int (s, p, insn, insn->src_args[1]);
+    sprintf(x, "(int)(%s)", s);
+    sprintf(y, "(int)((%s) >> 32)", s);
+  } else {
+    sprintf(x, "ex->params[%d]", insn->src_args[1]);
+    sprintf(y, "ex->params[%d]",
+        insn->src_args[1] + (ORC_VAR_T1 - ORC_VAR_P1));
+  }
+  c_get_name_int (src2, p, insn, insn->src_args[2]);
+  get_varname_stride (stride, p, insn->src_args[0]);
+
+  ORC_ASM_CODE(p,"    {\n");
+  if (p->target_flags & ORC_TARGET_C_OPCODE &&
+      !(insn->flags & ORC_INSN_FLAG_ADDED)) {
+    ORC_ASM_CODE(p,"    int tmp = %s + (offset + i) * %s;\n", x, src2);
+  } else {
+    ORC_ASM_CODE(p,"    int tmp = %s + i * %s;\n", x, src2);
+  }
+  ORC_ASM_CODE(p,"    int x = (tmp>>8)&0xff;\n");
+  ORC_ASM_CODE(p,"    int y = (%s>>8)&0xff;\n", y);
+  ORC_ASM_CODE(p,"    const %s *r0 = ptr%d + (tmp>>16);\n",
+      c_get_type_name (p->vars[insn->src_args[0]].size), insn->src_args[0]);
+  ORC_ASM_CODE(p,"    const %s *r1 = (const %s *)ORC_PTR_OFFSET(r0, %s);\n",
+      c_get_type_name (p->vars[insn->src_args[0]].size),
+      c_get_type_name (p->vars[insn->src_args[0]].size), stride);
+  if (n_channels == 1) {
+    ORC_ASM_CODE(p,"    var%d = ((((orc_uint8)r0[0] * (256-x) + (orc_uint8)r0[1] * x)>>8) * (256-y) + (((orc_uint8)r1[0] * (256-x) + (orc_uint8)r1[1] * x)>>8) * y)>>8;\n",
+        insn->dest_args[0]);
+  } else {
+    for(i=0;i<n_channels;i++){
+      ORC_ASM_CODE(p,"    var%d.x4[%d] = ((((orc_uint8)r0[0].x4[%d] * (256-x) + (orc_uint8)r0[1].x4[%d] * x)>>8) * (256-y) + (((orc_uint8)r1[0].x4[%d] * (256-x) + (orc_uint8)r1[1].x4[%d] * x)>>8) * y)>>8;\n",
+          insn->dest_args[0], i, i, i, i, i);
+    }
+  }
+  ORC_ASM_CODE(p,"    }\n");
+}
+
 static void
 c_rule_storeX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -993,6 +1243,363 @@ c_rule_storeX (OrcCompiler *p, void *user, OrcInstruction *insn)
   }
 }
 
+static void
+c_rule_loadchX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int n_channels = ORC_PTR_TO_INT(user);
+  const char *type = c_get_type_name (p->vars[insn->dest_args[0]].size);
+  char src[40];
+
+  c_get_name_int (src, p, insn, insn->src_args[1]);
+
+  if (p->target_flags & ORC_TARGET_C_OPCODE &&
+      !(insn->flags & ORC_INSN_FLAG_ADDED)) {
+    ORC_ASM_CODE(p,"    var%d = ((const %s *)ptr%d)[%d*(offset + i) + %s];\n",
+        insn->dest_args[0], type, insn->src_args[0], n_channels, src);
+  } else {
+    ORC_ASM_CODE(p,"    var%d = ((const %s *)ptr%d)[%d*i + %s];\n",
+        insn->dest_args[0], type, insn->src_args[0], n_channels, src);
+  }
+}
+
+static void
+c_rule_storechX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int n_channels = ORC_PTR_TO_INT(user);
+  const char *type = c_get_type_name (p->vars[insn->src_args[0]].size);
+  int j;
+
+  for(j=0;j<n_channels;j++){
+    if (p->target_flags & ORC_TARGET_C_OPCODE &&
+        !(insn->flags & ORC_INSN_FLAG_ADDED)) {
+      ORC_ASM_CODE(p,"    ((%s *)ptr%d)[%d*(offset + i) + %d] = var%d;\n",
+          type, insn->dest_args[0], n_channels, j, insn->src_args[j]);
+    } else {
+      ORC_ASM_CODE(p,"    ((%s *)ptr%d)[%d*i + %d] = var%d;\n",
+          type, insn->dest_args[0], n_channels, j, insn->src_args[j]);
+    }
+  }
+}
+
+static void
+c_rule_loadstrX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char src[40];
+
+  c_get_name_int (src, p, insn, insn->src_args[1]);
+
+  if (p->target_flags & ORC_TARGET_C_OPCODE &&
+      !(insn->flags & ORC_INSN_FLAG_ADDED)) {
+    ORC_ASM_CODE(p,"    var%d = ptr%d[(offset + i) * %s];\n", insn->dest_args[0],
+        insn->src_args[0], src);
+  } else {
+    ORC_ASM_CODE(p,"    var%d = ptr%d[i * %s];\n", insn->dest_args[0],
+        insn->src_args[0], src);
+  }
+}
+
+static void
+c_rule_storestrX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char src[40];
+
+  c_get_name_int (src, p, insn, insn->src_args[1]);
+
+  if (p->target_flags & ORC_TARGET_C_OPCODE &&
+      !(insn->flags & ORC_INSN_FLAG_ADDED)) {
+    ORC_ASM_CODE(p,"    ptr%d[(offset + i) * %s] = var%d;\n", insn->dest_args[0],
+        src, insn->src_args[0]);
+  } else {
+    ORC_ASM_CODE(p,"    ptr%d[i * %s] = var%d;\n", insn->dest_args[0],
+        src, insn->src_args[0]);
+  }
+}
+
+static void
+c_rule_loadtrX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char stride[40];
+  const char *type = c_get_type_name (p->vars[insn->src_args[0]].size);
+
+  if ((p->target_flags & ORC_TARGET_C_NOEXEC) && !p->program->is_2d) {
+    ORC_COMPILER_ERROR(p, "opcode %s requires a 2D program",
+        insn->opcode->name);
+    return;
+  }
+  get_varname_stride (stride, p, insn->src_args[0]);
+
+  if (p->target_flags & ORC_TARGET_C_OPCODE &&
+      !(insn->flags & ORC_INSN_FLAG_ADDED)) {
+    ORC_ASM_CODE(p,"    var%d = *(const %s *)ORC_PTR_OFFSET(ptr%d, (offset + i) * %s);\n",
+        insn->dest_args[0], type, insn->src_args[0], stride);
+  } else {
+    ORC_ASM_CODE(p,"    var%d = *(const %s *)ORC_PTR_OFFSET(ptr%d, i * %s);\n",
+        insn->dest_args[0], type, insn->src_args[0], stride);
+  }
+}
+
+static void
+c_rule_scanaddX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40], carry[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (carry, p, NULL, insn->dest_args[1]);
+
+  if (insn->opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
+    ORC_ASM_CODE(p, "    {\n");
+    ORC_ASM_CODE(p,"       orc_union32 _src1;\n");
+    ORC_ASM_CODE(p,"       orc_union32 _src2;\n");
+    ORC_ASM_CODE(p,"       orc_union32 _dest1;\n");
+    ORC_ASM_CODE(p,"       _src1.i = ORC_DENORMAL(%s);\n", carry);
+    ORC_ASM_CODE(p,"       _src2.i = ORC_DENORMAL(%s);\n", src1);
+    ORC_ASM_CODE(p,"       _dest1.f = _src1.f + _src2.f;\n");
+    ORC_ASM_CODE(p,"       %s = ORC_DENORMAL(_dest1.i);\n", carry);
+    ORC_ASM_CODE(p, "    }\n");
+  } else if (insn->opcode->dest_size[0] == 4) {
+    ORC_ASM_CODE(p,"    %s = ((orc_uint32)%s) + ((orc_uint32)%s);\n", carry,
+        carry, src1);
+  } else {
+    ORC_ASM_CODE(p,"    %s = %s + %s;\n", carry, carry, src1);
+  }
+  ORC_ASM_CODE(p,"    %s = %s;\n", dest, carry);
+}
+
+static void
+c_rule_maddswl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40], src2[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _src1;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _src2;\n");
+  ORC_ASM_CODE(p,"       _src1.i = %s;\n", src1);
+  ORC_ASM_CODE(p,"       _src2.i = %s;\n", src2);
+  ORC_ASM_CODE(p,"       %s = (orc_uint32)(_src1.x2[0] * _src2.x2[0]) + "
+      "(orc_uint32)(_src1.x2[1] * _src2.x2[1]);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_maddusbw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40], src2[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union16 _src1;\n");
+  ORC_ASM_CODE(p,"       orc_union16 _src2;\n");
+  ORC_ASM_CODE(p,"       _src1.i = %s;\n", src1);
+  ORC_ASM_CODE(p,"       _src2.i = %s;\n", src2);
+  ORC_ASM_CODE(p,"       %s = ORC_CLAMP_SW((orc_uint8)_src1.x2[0] * _src2.x2[0] + "
+      "(orc_uint8)_src1.x2[1] * _src2.x2[1]);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_selectX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  static const char *types[] = { NULL, "orc_int8", "orc_int16", NULL,
+    "orc_int32", NULL, NULL, NULL, "orc_int64" };
+  char dest[40], src1[40], src2[40], src3[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+  c_get_name_int (src3, p, insn, insn->src_args[2]);
+
+  ORC_ASM_CODE(p,"    %s = ((%s)%s < 0) ? %s : %s;\n", dest,
+      types[insn->opcode->dest_size[0]], src1, src2, src3);
+}
+
+/* user is the number of byte (8) or word (4) lanes of the fields */
+static void
+c_rule_unpackX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int n_lanes = ORC_PTR_TO_INT(user);
+  char dest[40], src1[40], src2[40];
+  int k;
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union64 _dest;\n");
+  if (n_lanes == 8) {
+    ORC_ASM_CODE(p,"       orc_union32 _lo;\n");
+    ORC_ASM_CODE(p,"       orc_union32 _hi;\n");
+  }
+  ORC_ASM_CODE(p,"       orc_uint64 _src = (orc_uint32)%s;\n", src1);
+  ORC_ASM_CODE(p,"       int _width = %s;\n", src2);
+  ORC_ASM_CODE(p,"       orc_uint32 _mask = (1u << _width) - 1;\n");
+  for(k=0;k<n_lanes;k++){
+    if (n_lanes == 8) {
+      ORC_ASM_CODE(p,"       %s.x4[%d] = (_src >> (%d * _width)) & _mask;\n",
+          (k < 4) ? "_lo" : "_hi", k & 3, k);
+    } else {
+      ORC_ASM_CODE(p,"       _dest.x4[%d] = (_src >> (%d * _width)) & _mask;\n",
+          k, k);
+    }
+  }
+  if (n_lanes == 8) {
+    ORC_ASM_CODE(p,"       _dest.x2[0] = _lo.i;\n");
+    ORC_ASM_CODE(p,"       _dest.x2[1] = _hi.i;\n");
+  }
+  ORC_ASM_CODE(p,"       %s = _dest.i;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_packX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int n_lanes = ORC_PTR_TO_INT(user);
+  char dest[40], src1[40], src2[40];
+  int k;
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union64 _src;\n");
+  if (n_lanes == 8) {
+    ORC_ASM_CODE(p,"       orc_union32 _lo;\n");
+    ORC_ASM_CODE(p,"       orc_union32 _hi;\n");
+  }
+  ORC_ASM_CODE(p,"       orc_uint64 _dest = 0;\n");
+  ORC_ASM_CODE(p,"       int _width = %s;\n", src2);
+  ORC_ASM_CODE(p,"       orc_uint32 _mask = (1u << _width) - 1;\n");
+  ORC_ASM_CODE(p,"       _src.i = %s;\n", src1);
+  if (n_lanes == 8) {
+    ORC_ASM_CODE(p,"       _lo.i = _src.x2[0];\n");
+    ORC_ASM_CODE(p,"       _hi.i = _src.x2[1];\n");
+  }
+  for(k=0;k<n_lanes;k++){
+    if (n_lanes == 8) {
+      ORC_ASM_CODE(p,"       _dest |= (orc_uint64)((orc_uint8)%s.x4[%d] & _mask) << (%d * _width);\n",
+          (k < 4) ? "_lo" : "_hi", k & 3, k);
+    } else {
+      ORC_ASM_CODE(p,"       _dest |= (orc_uint64)((orc_uint16)_src.x4[%d] & _mask) << (%d * _width);\n",
+          k, k);
+    }
+  }
+  ORC_ASM_CODE(p,"       %s = (orc_uint32)_dest;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_popcntX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int size = insn->opcode->dest_size[0];
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _x = (orc_uint%d)%s;\n", 8 * size, src1);
+  ORC_ASM_CODE(p,"       _x = _x - ((_x >> 1) & 0x55555555);\n");
+  ORC_ASM_CODE(p,"       _x = (_x & 0x33333333) + ((_x >> 2) & 0x33333333);\n");
+  ORC_ASM_CODE(p,"       _x = (_x + (_x >> 4)) & 0x0f0f0f0f;\n");
+  ORC_ASM_CODE(p,"       %s = (_x * 0x01010101) >> 24;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+/* a word is counted as the top half of a long with a one just below,
+ * which also gives 16 for zero */
+static void
+c_rule_clzX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int size = insn->opcode->dest_size[0];
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  if (size == 2) {
+    ORC_ASM_CODE(p,"       orc_uint32 _x = ((orc_uint32)(orc_uint16)%s << 16) | 0x8000;\n",
+        src1);
+  } else {
+    ORC_ASM_CODE(p,"       orc_uint32 _x = (orc_uint32)%s;\n", src1);
+  }
+  ORC_ASM_CODE(p,"       int _n = 0;\n");
+  ORC_ASM_CODE(p,"       if (_x == 0) _n = 32;\n");
+  ORC_ASM_CODE(p,"       if (_x && !(_x & 0xffff0000)) { _n += 16; _x <<= 16; }\n");
+  ORC_ASM_CODE(p,"       if (_x && !(_x & 0xff000000)) { _n += 8; _x <<= 8; }\n");
+  ORC_ASM_CODE(p,"       if (_x && !(_x & 0xf0000000)) { _n += 4; _x <<= 4; }\n");
+  ORC_ASM_CODE(p,"       if (_x && !(_x & 0xc0000000)) { _n += 2; _x <<= 2; }\n");
+  ORC_ASM_CODE(p,"       if (_x && !(_x & 0x80000000)) { _n += 1; }\n");
+  ORC_ASM_CODE(p,"       %s = _n;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_bitrevb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _x = (orc_uint8)%s;\n", src1);
+  ORC_ASM_CODE(p,"       _x = ((_x & 0x0f) << 4) | (_x >> 4);\n");
+  ORC_ASM_CODE(p,"       _x = ((_x & 0x33) << 2) | ((_x >> 2) & 0x33);\n");
+  ORC_ASM_CODE(p,"       _x = ((_x & 0x55) << 1) | ((_x >> 1) & 0x55);\n");
+  ORC_ASM_CODE(p,"       %s = _x;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+/* the element is handled as one or two orc_union32 for byte access */
+static void
+c_rule_shuffleX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int size = insn->opcode->dest_size[0];
+  char dest[40], src1[40], src2[40];
+  int k;
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _src[2];\n");
+  ORC_ASM_CODE(p,"       orc_union32 _dest[2];\n");
+  ORC_ASM_CODE(p,"       int _perm = %s;\n", src2);
+  ORC_ASM_CODE(p,"       int _j;\n");
+  if (size == 8) {
+    ORC_ASM_CODE(p,"       orc_union64 _tmp;\n");
+    ORC_ASM_CODE(p,"       _tmp.i = %s;\n", src1);
+    ORC_ASM_CODE(p,"       _src[0].i = _tmp.x2[0];\n");
+    ORC_ASM_CODE(p,"       _src[1].i = _tmp.x2[1];\n");
+  } else {
+    ORC_ASM_CODE(p,"       _src[0].i = %s;\n", src1);
+  }
+  for(k=0;k<size;k++){
+    ORC_ASM_CODE(p,"       _j = (_perm >> %d) & 0xf;\n", 4 * k);
+    ORC_ASM_CODE(p,"       _dest[%d].x4[%d] = (_j < %d) ? _src[_j >> 2].x4[_j & 3] : 0;\n",
+        k >> 2, k & 3, size);
+  }
+  if (size == 8) {
+    ORC_ASM_CODE(p,"       _tmp.x2[0] = _dest[0].i;\n");
+    ORC_ASM_CODE(p,"       _tmp.x2[1] = _dest[1].i;\n");
+    ORC_ASM_CODE(p,"       %s = _tmp.i;\n", dest);
+  } else {
+    ORC_ASM_CODE(p,"       %s = _dest[0].i;\n", dest);
+  }
+  ORC_ASM_CODE(p, "    }\n");
+}
+
 static void
 c_rule_accw (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -1029,6 +1636,118 @@ c_rule_accsadubl (OrcCompiler *p, void *user, OrcInstruction *insn)
       dest, dest, src1, src2);
 }
 
+static void
+c_rule_findX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  /* counts the elements before the first match */
+  ORC_ASM_CODE(p,"    if (%s != 0) break;\n", src1);
+  ORC_ASM_CODE(p,"    %s = %s + 1;\n", dest, dest);
+}
+
+/* The four products are flushed like the results of mulf, so that the
+ * sums match vector code running with denormals flushed to zero. */
+static void
+c_rule_mulcf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40], src2[40];
+  int conj = ORC_PTR_TO_INT(user);
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union64 _src1;\n");
+  ORC_ASM_CODE(p,"       orc_union64 _src2;\n");
+  ORC_ASM_CODE(p,"       orc_union64 _dest1;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _rr, _ir, _ii, _ri;\n");
+  ORC_ASM_CODE(p,"       _src1.i = %s;\n", src1);
+  ORC_ASM_CODE(p,"       _src2.i = %s;\n", src2);
+  ORC_ASM_CODE(p,"       _src1.x2[0] = ORC_DENORMAL(_src1.x2[0]);\n");
+  ORC_ASM_CODE(p,"       _src1.x2[1] = ORC_DENORMAL(_src1.x2[1]);\n");
+  ORC_ASM_CODE(p,"       _src2.x2[0] = ORC_DENORMAL(_src2.x2[0]);\n");
+  ORC_ASM_CODE(p,"       _src2.x2[1] = ORC_DENORMAL(_src2.x2[1]);\n");
+  ORC_ASM_CODE(p,"       _rr.f = _src1.x2f[0] * _src2.x2f[0];\n");
+  ORC_ASM_CODE(p,"       _ir.f = _src1.x2f[1] * _src2.x2f[0];\n");
+  ORC_ASM_CODE(p,"       _ii.f = _src1.x2f[1] * _src2.x2f[1];\n");
+  ORC_ASM_CODE(p,"       _ri.f = _src1.x2f[0] * _src2.x2f[1];\n");
+  ORC_ASM_CODE(p,"       _rr.i = ORC_DENORMAL(_rr.i);\n");
+  ORC_ASM_CODE(p,"       _ir.i = ORC_DENORMAL(_ir.i);\n");
+  ORC_ASM_CODE(p,"       _ii.i = ORC_DENORMAL(_ii.i);\n");
+  ORC_ASM_CODE(p,"       _ri.i = ORC_DENORMAL(_ri.i);\n");
+  if (conj) {
+    ORC_ASM_CODE(p,"       _dest1.x2f[0] = _rr.f + _ii.f;\n");
+    ORC_ASM_CODE(p,"       _dest1.x2f[1] = _ir.f - _ri.f;\n");
+  } else {
+    ORC_ASM_CODE(p,"       _dest1.x2f[0] = _rr.f - _ii.f;\n");
+    ORC_ASM_CODE(p,"       _dest1.x2f[1] = _ir.f + _ri.f;\n");
+  }
+  ORC_ASM_CODE(p,"       _dest1.x2[0] = ORC_DENORMAL(_dest1.x2[0]);\n");
+  ORC_ASM_CODE(p,"       _dest1.x2[1] = ORC_DENORMAL(_dest1.x2[1]);\n");
+  ORC_ASM_CODE(p,"       %s = _dest1.i;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_magsqcf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union64 _src1;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _rr, _ii, _dest1;\n");
+  ORC_ASM_CODE(p,"       _src1.i = %s;\n", src);
+  ORC_ASM_CODE(p,"       _src1.x2[0] = ORC_DENORMAL(_src1.x2[0]);\n");
+  ORC_ASM_CODE(p,"       _src1.x2[1] = ORC_DENORMAL(_src1.x2[1]);\n");
+  ORC_ASM_CODE(p,"       _rr.f = _src1.x2f[0] * _src1.x2f[0];\n");
+  ORC_ASM_CODE(p,"       _ii.f = _src1.x2f[1] * _src1.x2f[1];\n");
+  ORC_ASM_CODE(p,"       _rr.i = ORC_DENORMAL(_rr.i);\n");
+  ORC_ASM_CODE(p,"       _ii.i = ORC_DENORMAL(_ii.i);\n");
+  ORC_ASM_CODE(p,"       _dest1.f = _rr.f + _ii.f;\n");
+  ORC_ASM_CODE(p,"       %s = ORC_DENORMAL(_dest1.i);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_matrowlb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40], src2[100];
+  int row = insn->src_args[1];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  if (p->vars[row].vartype == ORC_VAR_TYPE_PARAM &&
+      !(p->target_flags & (ORC_TARGET_C_NOEXEC | ORC_TARGET_C_OPCODE))) {
+    /* the high half of a 64-bit parameter is kept with the temporaries */
+    sprintf(src2, "(ex->params[%d] & 0xffffffff) | "
+        "((orc_uint64)(ex->params[%d + (ORC_VAR_T1 - ORC_VAR_P1)]) << 32)",
+        row, row);
+  } else {
+    c_get_name_int (src2, p, insn, row);
+  }
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _src1;\n");
+  ORC_ASM_CODE(p,"       orc_union64 _src2;\n");
+  ORC_ASM_CODE(p,"       int _sum;\n");
+  ORC_ASM_CODE(p,"       _src1.i = %s;\n", src1);
+  ORC_ASM_CODE(p,"       _src2.i = %s;\n", src2);
+  ORC_ASM_CODE(p,"       _sum = 4 * _src2.x4[0] + "
+      "(orc_uint8)_src1.x4[1] * _src2.x4[1] + "
+      "(orc_uint8)_src1.x4[2] * _src2.x4[2] + "
+      "(orc_uint8)_src1.x4[3] * _src2.x4[3];\n");
+  ORC_ASM_CODE(p,"       %s = ORC_CLAMP_UB(_sum >> 8);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
 static void
 c_rule_splitql (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -1292,6 +2011,280 @@ c_rule_convdf (OrcCompiler *p, void *user, OrcInstruction *insn)
   ORC_ASM_CODE(p, "    }\n");
 }
 
+static void
+c_rule_convhf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  /* exact; half subnormals are normal floats */
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _dest;\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _h = (orc_uint16)%s;\n", src1);
+  ORC_ASM_CODE(p,"       orc_uint32 _e = (_h >> 10) & 0x1f;\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _m = _h & 0x3ff;\n");
+  ORC_ASM_CODE(p,"       if (_e == 0x1f) {\n");
+  ORC_ASM_CODE(p,"         _dest.i = 0x7f800000 | (_m << 13) | (_m ? 0x00400000 : 0);\n");
+  ORC_ASM_CODE(p,"       } else if (_e != 0) {\n");
+  ORC_ASM_CODE(p,"         _dest.i = ((_e + 112) << 23) | (_m << 13);\n");
+  ORC_ASM_CODE(p,"       } else {\n");
+  ORC_ASM_CODE(p,"         _dest.f = _m * (1.0f/16777216.0f);\n");
+  ORC_ASM_CODE(p,"       }\n");
+  ORC_ASM_CODE(p,"       %s = _dest.i | ((_h & 0x8000) << 16);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_convfh (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  /* round to nearest even, overflow to infinity, NaN is quieted */
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _src1;\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _a;\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _r;\n");
+  ORC_ASM_CODE(p,"       _src1.i = ORC_DENORMAL(%s);\n", src1);
+  ORC_ASM_CODE(p,"       _a = _src1.i & 0x7fffffff;\n");
+  ORC_ASM_CODE(p,"       if (_a > 0x7f800000) {\n");
+  ORC_ASM_CODE(p,"         _r = 0x7e00 | ((_a >> 13) & 0x3ff);\n");
+  ORC_ASM_CODE(p,"       } else if (_a >= 0x47800000) {\n");
+  ORC_ASM_CODE(p,"         _r = 0x7c00;\n");
+  ORC_ASM_CODE(p,"       } else if (_a < 0x38800000) {\n");
+  ORC_ASM_CODE(p,"         orc_union32 _t;\n");
+  ORC_ASM_CODE(p,"         _t.i = _a;\n");
+  ORC_ASM_CODE(p,"         _t.f += 0.5f;\n");
+  ORC_ASM_CODE(p,"         _r = _t.i - 0x3f000000;\n");
+  ORC_ASM_CODE(p,"       } else {\n");
+  ORC_ASM_CODE(p,"         _r = (_a - 0x37fff001 + ((_a >> 13) & 1)) >> 13;\n");
+  ORC_ASM_CODE(p,"       }\n");
+  ORC_ASM_CODE(p,"       %s = _r | ((_src1.i >> 16) & 0x8000);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_convbf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p,"    %s = ORC_DENORMAL((orc_uint32)(orc_uint16)%s << 16);\n",
+      dest, src1);
+}
+
+static void
+c_rule_convfb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  /* round to nearest even, NaN is quieted */
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _x = ORC_DENORMAL(%s);\n", src1);
+  ORC_ASM_CODE(p,"       if (ORC_ISNAN(_x)) {\n");
+  ORC_ASM_CODE(p,"         %s = (_x >> 16) | 0x0040;\n", dest);
+  ORC_ASM_CODE(p,"       } else {\n");
+  ORC_ASM_CODE(p,"         %s = (_x + 0x7fff + ((_x >> 16) & 1)) >> 16;\n", dest);
+  ORC_ASM_CODE(p,"       }\n");
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+/* The transcendental opcodes are defined by these polynomial
+ * approximations, which the SIMD backends compute with the same
+ * sequence of operations.  Compared to the exact results, expf and
+ * logf are within 1 ulp, powf is within 1 ulp, and sinf and cosf are
+ * within 2 ulp for |x| < 2^22.  Larger arguments to sinf and cosf lose
+ * accuracy.  powf is computed as exp2(b * log2(a)), so a negative a
+ * gives NaN, and 0^0, inf^0 and 1^inf are NaN. */
+
+static void
+c_rule_expf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _x;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _t;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _s1;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _s2;\n");
+  ORC_ASM_CODE(p,"       float _k, _r, _z;\n");
+  ORC_ASM_CODE(p,"       orc_int32 _n;\n");
+  ORC_ASM_CODE(p,"       _x.i = ORC_DENORMAL(%s);\n", src1);
+  ORC_ASM_CODE(p,"       _x.f = (89.0f < _x.f) ? 89.0f : _x.f;\n");
+  ORC_ASM_CODE(p,"       _x.f = (-104.0f > _x.f) ? -104.0f : _x.f;\n");
+  ORC_ASM_CODE(p,"       _t.f = _x.f * 1.44269504f + 12582912.0f;\n");
+  ORC_ASM_CODE(p,"       _k = _t.f - 12582912.0f;\n");
+  ORC_ASM_CODE(p,"       _n = _t.i - 0x4b400000;\n");
+  ORC_ASM_CODE(p,"       _r = _x.f - _k * 0.693359375f;\n");
+  ORC_ASM_CODE(p,"       _r = _r - _k * -2.12194440e-4f;\n");
+  ORC_ASM_CODE(p,"       _z = _r * _r;\n");
+  ORC_ASM_CODE(p,"       _x.f = 1.9875691500e-4f * _r + 1.3981999507e-3f;\n");
+  ORC_ASM_CODE(p,"       _x.f = _x.f * _r + 8.3334519073e-3f;\n");
+  ORC_ASM_CODE(p,"       _x.f = _x.f * _r + 4.1665795894e-2f;\n");
+  ORC_ASM_CODE(p,"       _x.f = _x.f * _r + 1.6666665459e-1f;\n");
+  ORC_ASM_CODE(p,"       _x.f = _x.f * _r + 5.0000001201e-1f;\n");
+  ORC_ASM_CODE(p,"       _x.f = _x.f * _z + _r + 1.0f;\n");
+  /* 2^n in two steps, since 2^128 and 2^-126 are both needed */
+  ORC_ASM_CODE(p,"       _s1.i = (orc_uint32)((_n >> 1) + 127) << 23;\n");
+  ORC_ASM_CODE(p,"       _s2.i = (orc_uint32)(_n - (_n >> 1) + 127) << 23;\n");
+  ORC_ASM_CODE(p,"       _x.f = _x.f * _s1.f * _s2.f;\n");
+  ORC_ASM_CODE(p,"       %s = ORC_DENORMAL(_x.i);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_logf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _x;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _m;\n");
+  ORC_ASM_CODE(p,"       float _e, _f, _y;\n");
+  ORC_ASM_CODE(p,"       _x.i = ORC_DENORMAL(%s);\n", src1);
+  /* positive, normal and finite */
+  ORC_ASM_CODE(p,"       if ((orc_uint32)_x.i - 0x00800000 < 0x7f000000) {\n");
+  ORC_ASM_CODE(p,"         _m.i = _x.i - 0x3f3504f3;\n");
+  ORC_ASM_CODE(p,"         _e = (float)(_m.i >> 23);\n");
+  ORC_ASM_CODE(p,"         _m.i = (_m.i & 0x007fffff) + 0x3f3504f3;\n");
+  ORC_ASM_CODE(p,"         _f = _m.f - 1.0f;\n");
+  ORC_ASM_CODE(p,"         _y = 7.0376836292e-2f * _f - 1.1514610310e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f + 1.1676998740e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f - 1.2420140846e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f + 1.4249322787e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f - 1.6668057665e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f + 2.0000714765e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f - 2.4999993993e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f + 3.3333331174e-1f;\n");
+  ORC_ASM_CODE(p,"         _y = _y * _f * (_f * _f);\n");
+  ORC_ASM_CODE(p,"         _y = _y + _e * -2.12194440e-4f;\n");
+  ORC_ASM_CODE(p,"         _y = _y - 0.5f * (_f * _f);\n");
+  ORC_ASM_CODE(p,"         _x.f = _f + _y + _e * 0.693359375f;\n");
+  ORC_ASM_CODE(p,"       } else if (_x.f == 0.0f) {\n");
+  ORC_ASM_CODE(p,"         _x.i = 0xff800000;\n");
+  ORC_ASM_CODE(p,"       } else if (_x.f < 0.0f) {\n");
+  ORC_ASM_CODE(p,"         _x.i = 0x7fc00000;\n");
+  ORC_ASM_CODE(p,"       }\n");
+  ORC_ASM_CODE(p,"       %s = _x.i;\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+/* user is 1 for cosf */
+static void
+c_rule_sinf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _x;\n");
+  ORC_ASM_CODE(p,"       orc_union64 _t;\n");
+  ORC_ASM_CODE(p,"       double _k, _r;\n");
+  ORC_ASM_CODE(p,"       float _y, _z, _s, _c;\n");
+  ORC_ASM_CODE(p,"       orc_uint32 _q;\n");
+  ORC_ASM_CODE(p,"       _x.i = ORC_DENORMAL(%s);\n", src1);
+  /* reduced to [-pi/4,pi/4] in double precision */
+  ORC_ASM_CODE(p,"       _t.f = (double)_x.f * 0.63661977236758134 + 6755399441055744.0;\n");
+  ORC_ASM_CODE(p,"       _k = _t.f - 6755399441055744.0;\n");
+  ORC_ASM_CODE(p,"       _r = (double)_x.f - _k * 1.5707963267341256;\n");
+  ORC_ASM_CODE(p,"       _r = _r - _k * 6.077100506506192e-11;\n");
+  ORC_ASM_CODE(p,"       _y = (float)_r;\n");
+  ORC_ASM_CODE(p,"       _q = (orc_uint32)_t.i + %d;\n", user ? 1 : 0);
+  ORC_ASM_CODE(p,"       _z = _y * _y;\n");
+  ORC_ASM_CODE(p,"       _s = -1.9515295891e-4f * _z + 8.3321608736e-3f;\n");
+  ORC_ASM_CODE(p,"       _s = _s * _z - 1.6666654611e-1f;\n");
+  ORC_ASM_CODE(p,"       _s = _s * _z * _y + _y;\n");
+  ORC_ASM_CODE(p,"       _c = 2.443315711809948e-5f * _z - 1.388731625493765e-3f;\n");
+  ORC_ASM_CODE(p,"       _c = _c * _z + 4.166664568298827e-2f;\n");
+  ORC_ASM_CODE(p,"       _c = _c * _z * _z - 0.5f * _z + 1.0f;\n");
+  ORC_ASM_CODE(p,"       _x.f = (_q & 1) ? _c : _s;\n");
+  ORC_ASM_CODE(p,"       if (_q & 2) _x.f = -_x.f;\n");
+  ORC_ASM_CODE(p,"       %s = ORC_DENORMAL(_x.i);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
+static void
+c_rule_powf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  char dest[40], src1[40], src2[40];
+
+  c_get_name_int (dest, p, insn, insn->dest_args[0]);
+  c_get_name_int (src1, p, insn, insn->src_args[0]);
+  c_get_name_int (src2, p, insn, insn->src_args[1]);
+
+  ORC_ASM_CODE(p, "    {\n");
+  ORC_ASM_CODE(p,"       orc_union32 _x;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _y;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _m;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _s1;\n");
+  ORC_ASM_CODE(p,"       orc_union32 _s2;\n");
+  ORC_ASM_CODE(p,"       orc_union64 _k;\n");
+  ORC_ASM_CODE(p,"       double _e, _s, _z, _t;\n");
+  ORC_ASM_CODE(p,"       orc_int32 _n;\n");
+  ORC_ASM_CODE(p,"       _x.i = ORC_DENORMAL(%s);\n", src1);
+  ORC_ASM_CODE(p,"       _y.i = ORC_DENORMAL(%s);\n", src2);
+  /* log2(a), with the special values of logf */
+  ORC_ASM_CODE(p,"       if ((orc_uint32)_x.i - 0x00800000 < 0x7f000000) {\n");
+  ORC_ASM_CODE(p,"         _m.i = _x.i - 0x3f3504f3;\n");
+  ORC_ASM_CODE(p,"         _e = (double)(_m.i >> 23);\n");
+  ORC_ASM_CODE(p,"         _m.i = (_m.i & 0x007fffff) + 0x3f3504f3;\n");
+  ORC_ASM_CODE(p,"       } else {\n");
+  ORC_ASM_CODE(p,"         if (_x.f == 0.0f) {\n");
+  ORC_ASM_CODE(p,"           _x.i = 0xff800000;\n");
+  ORC_ASM_CODE(p,"         } else if (_x.f < 0.0f) {\n");
+  ORC_ASM_CODE(p,"           _x.i = 0x7fc00000;\n");
+  ORC_ASM_CODE(p,"         }\n");
+  ORC_ASM_CODE(p,"         _e = (double)_x.f;\n");
+  ORC_ASM_CODE(p,"         _m.f = 1.0f;\n");
+  ORC_ASM_CODE(p,"       }\n");
+  ORC_ASM_CODE(p,"       _s = ((double)_m.f - 1.0) / ((double)_m.f + 1.0);\n");
+  ORC_ASM_CODE(p,"       _z = _s * _s;\n");
+  ORC_ASM_CODE(p,"       _t = _z * (1.0/13) + (1.0/11);\n");
+  ORC_ASM_CODE(p,"       _t = _t * _z + (1.0/9);\n");
+  ORC_ASM_CODE(p,"       _t = _t * _z + (1.0/7);\n");
+  ORC_ASM_CODE(p,"       _t = _t * _z + (1.0/5);\n");
+  ORC_ASM_CODE(p,"       _t = _t * _z + (1.0/3);\n");
+  ORC_ASM_CODE(p,"       _t = _t * _z + 1.0;\n");
+  ORC_ASM_CODE(p,"       _t = _t * _s * 2.8853900817779268 + _e;\n");
+  /* exp2(b * log2(a)) */
+  ORC_ASM_CODE(p,"       _t = (double)_y.f * _t;\n");
+  ORC_ASM_CODE(p,"       _t = (130.0 < _t) ? 130.0 : _t;\n");
+  ORC_ASM_CODE(p,"       _t = (-160.0 > _t) ? -160.0 : _t;\n");
+  ORC_ASM_CODE(p,"       _k.f = _t + 6755399441055744.0;\n");
+  ORC_ASM_CODE(p,"       _n = (orc_int32)(orc_uint32)_k.i;\n");
+  ORC_ASM_CODE(p,"       _t = _t - (_k.f - 6755399441055744.0);\n");
+  ORC_ASM_CODE(p,"       _e = 1.3215486790144307e-06 * _t + 1.525273380405984e-05;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 1.5403530393381608e-04;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 1.3333558146428443e-03;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 9.618129107628477e-03;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 5.550410866482158e-02;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 2.402265069591007e-01;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 6.931471805599453e-01;\n");
+  ORC_ASM_CODE(p,"       _e = _e * _t + 1.0;\n");
+  ORC_ASM_CODE(p,"       _s1.i = (orc_uint32)((_n >> 1) + 127) << 23;\n");
+  ORC_ASM_CODE(p,"       _s2.i = (orc_uint32)(_n - (_n >> 1) + 127) << 23;\n");
+  ORC_ASM_CODE(p,"       _x.f = (float)_e * _s1.f * _s2.f;\n");
+  ORC_ASM_CODE(p,"       %s = ORC_DENORMAL(_x.i);\n", dest);
+  ORC_ASM_CODE(p, "    }\n");
+}
+
 static void
 c_rule_convfl (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -1514,6 +2507,8 @@ orc_c_init (void)
 #define BINARY_UQ(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
 #define BINARY_F(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
 #define BINARY_D(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
+#define TERNARY_F(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
+#define TERNARY_D(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
 #define UNARY_SB(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
 #define UNARY_UB(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
 #define UNARY_SW(a,b) orc_rule_register (rule_set, #a , c_rule_ ## a, NULL);
@@ -1565,14 +2560,63 @@ orc_c_init (void)
   orc_rule_register (rule_set, "ldresnearl", c_rule_ldresnearX, NULL);
   orc_rule_register (rule_set, "ldreslinb", c_rule_ldreslinb, NULL);
   orc_rule_register (rule_set, "ldreslinl", c_rule_ldreslinl, NULL);
+  orc_rule_register (rule_set, "ldresbilinb", c_rule_ldresbilinX, (void *)1);
+  orc_rule_register (rule_set, "ldresbilinl", c_rule_ldresbilinX, (void *)4);
   orc_rule_register (rule_set, "storeb", c_rule_storeX, NULL);
   orc_rule_register (rule_set, "storew", c_rule_storeX, NULL);
   orc_rule_register (rule_set, "storel", c_rule_storeX, NULL);
   orc_rule_register (rule_set, "storeq", c_rule_storeX, NULL);
+  orc_rule_register (rule_set, "loadch3b", c_rule_loadchX, (void *)3);
+  orc_rule_register (rule_set, "loadch4b", c_rule_loadchX, (void *)4);
+  orc_rule_register (rule_set, "loadch3w", c_rule_loadchX, (void *)3);
+  orc_rule_register (rule_set, "loadch4w", c_rule_loadchX, (void *)4);
+  orc_rule_register (rule_set, "storech3b", c_rule_storechX, (void *)3);
+  orc_rule_register (rule_set, "storech3w", c_rule_storechX, (void *)3);
+  orc_rule_register (rule_set, "loadstrb", c_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "loadstrw", c_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "loadstrl", c_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "loadstrq", c_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "storestrb", c_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "storestrw", c_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "storestrl", c_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "storestrq", c_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "loadtrb", c_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "loadtrw", c_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "loadtrl", c_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "loadtrq", c_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "scanaddw", c_rule_scanaddX, NULL);
+  orc_rule_register (rule_set, "scanaddl", c_rule_scanaddX, NULL);
+  orc_rule_register (rule_set, "scanaddf", c_rule_scanaddX, NULL);
+  orc_rule_register (rule_set, "maddswl", c_rule_maddswl, NULL);
+  orc_rule_register (rule_set, "maddusbw", c_rule_maddusbw, NULL);
+  orc_rule_register (rule_set, "selectb", c_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectw", c_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectl", c_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectf", c_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectd", c_rule_selectX, NULL);
+  orc_rule_register (rule_set, "unpacklb", c_rule_unpackX, (void *)8);
+  orc_rule_register (rule_set, "unpacklw", c_rule_unpackX, (void *)4);
+  orc_rule_register (rule_set, "packbl", c_rule_packX, (void *)8);
+  orc_rule_register (rule_set, "packwl", c_rule_packX, (void *)4);
+  orc_rule_register (rule_set, "popcntb", c_rule_popcntX, NULL);
+  orc_rule_register (rule_set, "popcntw", c_rule_popcntX, NULL);
+  orc_rule_register (rule_set, "popcntl", c_rule_popcntX, NULL);
+  orc_rule_register (rule_set, "clzw", c_rule_clzX, NULL);
+  orc_rule_register (rule_set, "clzl", c_rule_clzX, NULL);
+  orc_rule_register (rule_set, "bitrevb", c_rule_bitrevb, NULL);
+  orc_rule_register (rule_set, "shufflel", c_rule_shuffleX, NULL);
+  orc_rule_register (rule_set, "shuffleq", c_rule_shuffleX, NULL);
 
   orc_rule_register (rule_set, "accw", c_rule_accw, NULL);
   orc_rule_register (rule_set, "accl", c_rule_accl, NULL);
   orc_rule_register (rule_set, "accsadubl", c_rule_accsadubl, NULL);
+  orc_rule_register (rule_set, "findb", c_rule_findX, NULL);
+  orc_rule_register (rule_set, "findw", c_rule_findX, NULL);
+  orc_rule_register (rule_set, "findl", c_rule_findX, NULL);
+  orc_rule_register (rule_set, "mulcf", c_rule_mulcf, (void *)0);
+  orc_rule_register (rule_set, "mulconjcf", c_rule_mulcf, (void *)1);
+  orc_rule_register (rule_set, "magsqcf", c_rule_magsqcf, NULL);
+  orc_rule_register (rule_set, "matrowlb", c_rule_matrowlb, NULL);
   orc_rule_register (rule_set, "splitql", c_rule_splitql, NULL);
   orc_rule_register (rule_set, "splitlw", c_rule_splitlw, NULL);
   orc_rule_register (rule_set, "splitwb", c_rule_splitwb, NULL);
@@ -1593,6 +2637,15 @@ orc_c_init (void)
   orc_rule_register (rule_set, "convdl", c_rule_convdl, NULL);
   orc_rule_register (rule_set, "convfd", c_rule_convfd, NULL);
   orc_rule_register (rule_set, "convdf", c_rule_convdf, NULL);
+  orc_rule_register (rule_set, "convhf", c_rule_convhf, NULL);
+  orc_rule_register (rule_set, "convfh", c_rule_convfh, NULL);
+  orc_rule_register (rule_set, "convbf", c_rule_convbf, NULL);
+  orc_rule_register (rule_set, "convfb", c_rule_convfb, NULL);
+  orc_rule_register (rule_set, "expf", c_rule_expf, NULL);
+  orc_rule_register (rule_set, "logf", c_rule_logf, NULL);
+  orc_rule_register (rule_set, "sinf", c_rule_sinf, (void *)0);
+  orc_rule_register (rule_set, "cosf", c_rule_sinf, (void *)1);
+  orc_rule_register (rule_set, "powf", c_rule_powf, NULL);
   orc_rule_register (rule_set, "minf", c_rule_minf, NULL);
   orc_rule_register (rule_set, "maxf", c_rule_maxf, NULL);
   orc_rule_register (rule_set, "mind", c_rule_mind, NULL);
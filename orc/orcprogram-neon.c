@@ -491,6 +491,25 @@ enum {
   LABEL_L1L2_AFTER,
 };
 
+/* vtbl indexes of a shuffle for one doubleword of elements */
+static void
+neon_emit_shuffle_table (OrcCompiler *compiler, OrcInstruction *insn)
+{
+  int size = insn->opcode->dest_size[0];
+  int perm = compiler->vars[insn->src_args[1]].value.i;
+  orc_uint32 word[2] = { 0, 0 };
+  int i;
+
+  for(i=0;i<8;i++){
+    int j = (perm >> (4 * (i % size))) & 0xf;
+    orc_uint32 index = (j < size) ? (i / size) * size + j : 0xff;
+
+    word[i / 4] |= index << (8 * (i % 4));
+  }
+  orc_arm_emit_data (compiler, word[0]);
+  orc_arm_emit_data (compiler, word[1]);
+}
+
 static void
 orc_compiler_neon_assemble (OrcCompiler *compiler)
 {
@@ -728,6 +747,13 @@ orc_compiler_neon_assemble (OrcCompiler *compiler)
   orc_arm_emit_data (compiler, 0x07060706);
   orc_arm_emit_data (compiler, 0x0f0e0f0e);
   orc_arm_emit_data (compiler, 0x0f0e0f0e);
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+
+    if (strncmp (insn->opcode->name, "shuffle", 7) == 0) {
+      neon_emit_shuffle_table (compiler, insn);
+    }
+  }
 
   orc_arm_do_fixups (compiler);
 }
@@ -19,6 +19,7 @@
 #define ORC_SSE_ALIGNED_DEST_CUTOFF 64
 
 static void orc_sse_emit_loop (OrcCompiler *compiler, int offset, int update);
+static void orc_sse_emit_update (OrcCompiler *compiler, int update);
 
 void orc_compiler_sse_register_rules (OrcTarget *target);
 static void orc_compiler_sse_init (OrcCompiler *compiler);
@@ -91,6 +92,9 @@ orc_compiler_sse_get_default_flags (void)
   if (_orc_compiler_flag_debug) {
     flags |= ORC_TARGET_SSE_FRAME_POINTER;
   }
+  if (!orc_compiler_flag_check ("-small_n")) {
+    flags |= ORC_TARGET_SSE_SMALL_N;
+  }
   
 #if defined(HAVE_AMD64) || defined(HAVE_I386)
 #ifndef MMX
@@ -118,10 +122,10 @@ sse_get_flag_name (int shift)
   static const char *flags[] = {
 #ifndef MMX
     "sse2", "sse3", "ssse3", "sse41", "sse42", "sse4a", "sse5",
-    "frame_pointer", "short_jumps", "64bit"
+    "frame_pointer", "short_jumps", "64bit", "fma", "f16c", "small_n"
 #else
     "mmx", "mmxext", "3dnow", "3dnowext", "ssse3", "sse41", "",
-    "frame_pointer", "short_jumps", "64bit"
+    "frame_pointer", "short_jumps", "64bit", "", "", "small_n"
 #endif
   };
 
@@ -249,21 +253,71 @@ orc_compiler_sse_init (OrcCompiler *compiler)
     compiler->unroll_shift = 0;
   }
   compiler->alloc_loop_counter = TRUE;
+  compiler->share_inplace_ptr = TRUE;
   compiler->allow_gp_on_stack = TRUE;
+#ifndef MMX
+  if (compiler->target_flags & ORC_TARGET_SSE_SSSE3) {
+    compiler->tap_window = 16;
+  }
+#endif
 
   {
+    /* the offset register of a transposed source holds the stride */
+    for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+      if (compiler->vars[i].transposed) {
+        compiler->vars[i].need_offset_reg = TRUE;
+      }
+    }
     for(i=0;i<compiler->n_insns;i++){
       OrcInstruction *insn = compiler->insns + i;
       OrcStaticOpcode *opcode = insn->opcode;
 
+      if (strncmp (opcode->name, "loadtr", 6) == 0) {
+        compiler->vars[insn->src_args[0]].need_offset_reg = TRUE;
+      }
       if (strcmp (opcode->name, "ldreslinb") == 0 ||
           strcmp (opcode->name, "ldreslinl") == 0 ||
+          strcmp (opcode->name, "ldresbilinl") == 0 ||
           strcmp (opcode->name, "ldresnearb") == 0 ||
           strcmp (opcode->name, "ldresnearl") == 0) {
         compiler->vars[insn->src_args[0]].need_offset_reg = TRUE;
       }
+      if (strcmp (opcode->name, "ldresbilinl") == 0) {
+        compiler->vars[insn->src_args[0]].need_stride_reg = TRUE;
+      }
+#ifndef MMX
+      if ((compiler->target_flags & ORC_TARGET_SSE_SSE4_1) &&
+          strncmp (opcode->name, "select", 6) == 0 &&
+          opcode->src_size[2] != 0) {
+        compiler->valid_regs[X86_XMM0] = 0;
+      }
+#endif
+    }
+  }
+}
+
+/* an in-place source addressed through its destination's register */
+static int
+sse_ptr_is_shared (OrcCompiler *compiler, int i)
+{
+  OrcVariable *var = compiler->vars + i;
+
+  return var->vartype == ORC_VAR_TYPE_SRC && var->inplace &&
+    var->ptr_register != 0 &&
+    var->ptr_register == compiler->vars[var->inplace_dest].ptr_register;
+}
+
+static int
+sse_get_find_var (OrcCompiler *compiler)
+{
+  int j;
+
+  for(j=0;j<compiler->n_insns;j++){
+    if (compiler->insns[j].opcode->flags & ORC_STATIC_OPCODE_FIND) {
+      return compiler->insns[j].dest_args[0];
     }
   }
+  return -1;
 }
 
 void
@@ -279,6 +333,9 @@ sse_save_accumulators (OrcCompiler *compiler)
     if (var->name == NULL) continue;
     switch (var->vartype) {
       case ORC_VAR_TYPE_ACCUMULATOR:
+        /* stored by sse_emit_find_exit */
+        if (compiler->find_label && i == sse_get_find_var (compiler)) break;
+
         src = var->alloc;
         tmp = orc_compiler_get_temp_reg (compiler);
 
@@ -503,29 +560,6 @@ sse_load_constants_outer (OrcCompiler *compiler)
       }
     }
   }
-
-  {
-    for(i=0;i<compiler->n_insns;i++){
-      OrcInstruction *insn = compiler->insns + i;
-      OrcStaticOpcode *opcode = insn->opcode;
-
-      if (strcmp (opcode->name, "ldreslinb") == 0 ||
-          strcmp (opcode->name, "ldreslinl") == 0 ||
-          strcmp (opcode->name, "ldresnearb") == 0 ||
-          strcmp (opcode->name, "ldresnearl") == 0) {
-        if (compiler->vars[insn->src_args[1]].vartype == ORC_VAR_TYPE_PARAM) {
-          orc_x86_emit_mov_memoffset_reg (compiler, 4,
-              (int)ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[1]]),
-              compiler->exec_reg,
-              compiler->vars[insn->src_args[0]].ptr_offset);
-        } else {
-          orc_x86_emit_mov_imm_reg (compiler, 4,
-              compiler->vars[insn->src_args[1]].value.i,
-              compiler->vars[insn->src_args[0]].ptr_offset);
-        }
-      }
-    }
-  }
 }
 
 void
@@ -541,7 +575,7 @@ sse_load_constants_inner (OrcCompiler *compiler)
         break;
       case ORC_VAR_TYPE_SRC:
       case ORC_VAR_TYPE_DEST:
-        if (compiler->vars[i].ptr_register) {
+        if (compiler->vars[i].ptr_register && !sse_ptr_is_shared (compiler, i)) {
           orc_x86_emit_mov_memoffset_reg (compiler, compiler->is_64bit ? 8 : 4,
               (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg,
               compiler->vars[i].ptr_register);
@@ -556,7 +590,108 @@ sse_load_constants_inner (OrcCompiler *compiler)
         break;
     }
   }
+
+  /* resampling positions restart with each row */
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+    OrcStaticOpcode *opcode = insn->opcode;
+
+    if (strcmp (opcode->name, "ldreslinb") == 0 ||
+        strcmp (opcode->name, "ldreslinl") == 0 ||
+        strcmp (opcode->name, "ldresbilinl") == 0 ||
+        strcmp (opcode->name, "ldresnearb") == 0 ||
+        strcmp (opcode->name, "ldresnearl") == 0) {
+      if (compiler->vars[insn->src_args[1]].vartype == ORC_VAR_TYPE_PARAM) {
+        orc_x86_emit_mov_memoffset_reg (compiler, 4,
+            (int)ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[1]]),
+            compiler->exec_reg,
+            compiler->vars[insn->src_args[0]].ptr_offset);
+      } else {
+        orc_x86_emit_mov_imm_reg (compiler, 4,
+            compiler->vars[insn->src_args[1]].value.i,
+            compiler->vars[insn->src_args[0]].ptr_offset);
+      }
+      /* the rules keep only the fraction, start at the integer part */
+      orc_x86_emit_mov_reg_reg (compiler, 4,
+          compiler->vars[insn->src_args[0]].ptr_offset, compiler->gp_tmpreg);
+      orc_x86_emit_sar_imm_reg (compiler, 4, 16, compiler->gp_tmpreg);
+      orc_x86_emit_add_reg_reg_shift (compiler, compiler->is_64bit ? 8 : 4,
+          compiler->gp_tmpreg, compiler->vars[insn->src_args[0]].ptr_register,
+          (compiler->vars[insn->src_args[0]].size == 4) ? 2 : 0);
+      orc_x86_emit_and_imm_reg (compiler, 4, 0xffff,
+          compiler->vars[insn->src_args[0]].ptr_offset);
+      /* the second row of a bilinear load is one stride below */
+      if (strcmp (opcode->name, "ldresbilinl") == 0) {
+        orc_x86_emit_mov_memoffset_reg (compiler, 4,
+            (int)ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[0]]),
+            compiler->exec_reg,
+            compiler->vars[insn->src_args[0]].stride_register);
+      }
+    }
+  }
+
+  /* transposed sources step down the column by the stride */
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+
+    if (strncmp (insn->opcode->name, "loadtr", 6) != 0) continue;
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[0]]),
+        compiler->exec_reg, compiler->vars[insn->src_args[0]].ptr_offset);
+  }
+
+  /* running sums restart with each row */
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+
+    if (!(insn->opcode->flags & ORC_STATIC_OPCODE_SCAN)) continue;
+    orc_sse_emit_pxor (compiler, compiler->vars[insn->dest_args[1]].alloc,
+        compiler->vars[insn->dest_args[1]].alloc);
+  }
+
+  if (compiler->find_label) {
+    orc_x86_emit_mov_imm_reg (compiler, 4, 0, compiler->find_counter);
+  }
+}
+
+#ifndef MMX
+/* The taps of a filter carry the vector below the window from one
+ * iteration to the next, so the main loop starts with it loaded.  See
+ * sse_emit_tap(). */
+static void
+sse_load_taps (OrcCompiler *compiler)
+{
+  int i;
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+    OrcVariable *src = compiler->vars + insn->src_args[0];
+    OrcVariable *lo, *hi;
+    int ptr_reg;
+
+    if (!(insn->flags & ORC_INSN_FLAG_TAP_WINDOW)) continue;
+    lo = compiler->vars + insn->src_args[2];
+    hi = compiler->vars + insn->src_args[3];
+    if (i != hi->first_use) continue;
+    if ((src->size << compiler->loop_shift) != 16) continue;
+
+    if (src->ptr_register == 0) {
+      orc_x86_emit_mov_memoffset_reg (compiler, compiler->is_64bit ? 8 : 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[insn->src_args[0]]),
+          compiler->exec_reg, compiler->gp_tmpreg);
+      ptr_reg = compiler->gp_tmpreg;
+    } else {
+      ptr_reg = src->ptr_register;
+    }
+    orc_x86_emit_mov_memoffset_sse (compiler, 16, lo->value.i * src->size,
+        ptr_reg, lo->alloc,
+        src->is_aligned && ((lo->value.i * src->size) & 15) == 0);
+    orc_sse_emit_pslldq_imm (compiler,
+        16 - (hi->value.i - lo->value.i) * src->size, lo->alloc);
+  }
+  compiler->tap_carry = TRUE;
 }
+#endif
 
 void
 sse_add_strides (OrcCompiler *compiler)
@@ -572,6 +707,13 @@ sse_add_strides (OrcCompiler *compiler)
         break;
       case ORC_VAR_TYPE_SRC:
       case ORC_VAR_TYPE_DEST:
+        if (compiler->vars[i].transposed) {
+          /* the next row starts one column to the right */
+          orc_x86_emit_add_imm_memoffset (compiler, compiler->is_64bit ? 8 : 4,
+              compiler->vars[i].size,
+              (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg);
+          break;
+        }
         orc_x86_emit_mov_memoffset_reg (compiler, 4,
             (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
             compiler->gp_tmpreg);
@@ -594,22 +736,49 @@ sse_add_strides (OrcCompiler *compiler)
   }
 }
 
+/* arrays of 3-channel, element-strided or transposed elements never
+ * reach vector alignment */
+#define IS_ALIGNABLE(var) ((((var)->size & ((var)->size - 1)) == 0) && \
+    (var)->element_stride <= 1 && !(var)->transposed)
+
+/* in-place sources sharing the pointer share its alignment */
+static void
+sse_set_aligned (OrcCompiler *compiler, int align_var, int is_aligned)
+{
+  int i;
+
+  compiler->vars[align_var].is_aligned = is_aligned;
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    if (sse_ptr_is_shared (compiler, i) &&
+        compiler->vars[i].inplace_dest == align_var) {
+      compiler->vars[i].is_aligned = is_aligned;
+    }
+  }
+}
+
 static int
 get_align_var (OrcCompiler *compiler)
 {
   int i;
   for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
     if (compiler->vars[i].size == 0) continue;
+    if (!IS_ALIGNABLE (compiler->vars + i)) continue;
     if ((compiler->vars[i].size << compiler->loop_shift) >= 16) {
       return i;
     }
   }
   for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
     if (compiler->vars[i].size == 0) continue;
+    if (!IS_ALIGNABLE (compiler->vars + i)) continue;
     if ((compiler->vars[i].size << compiler->loop_shift) >= 8) {
       return i;
     }
   }
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].size == 0) continue;
+    if (!IS_ALIGNABLE (compiler->vars + i)) continue;
+    return i;
+  }
   for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
     if (compiler->vars[i].size == 0) continue;
     return i;
@@ -711,16 +880,6 @@ orc_emit_split_3_regions (OrcCompiler *compiler)
 static void
 orc_emit_split_2_regions (OrcCompiler *compiler)
 {
-  int align_var;
-  int align_shift ORC_GNUC_UNUSED;
-  int var_size_shift;
-
-  align_var = get_align_var (compiler);
-  if (align_var < 0)
-    return;
-  var_size_shift = get_shift (compiler->vars[align_var].size);
-  align_shift = var_size_shift + compiler->loop_shift;
-
   /* Calculate n2 */
   orc_x86_emit_mov_memoffset_reg (compiler, 4,
       (int)ORC_STRUCT_OFFSET(OrcExecutor,n), compiler->exec_reg,
@@ -760,6 +919,47 @@ orc_program_has_float (OrcCompiler *compiler)
 #define LABEL_OUTER_LOOP_SKIP 5
 #define LABEL_STEP_DOWN(x) (8+(x))
 #define LABEL_STEP_UP(x) (13+(x))
+#define LABEL_SMALL_N 20
+#define LABEL_ENTRY 21
+#define LABEL_BATCH_ENTRY 24
+#define LABEL_BATCH_START 25
+#define LABEL_BATCH_LOOP 26
+#define LABEL_BATCH_LOAD_SKIP 27
+#define LABEL_BATCH_DONE 28
+#define LABEL_TILE_LOOP 29
+#define LABEL_TILE_WIDTH 30
+#define LABEL_FIND_MATCH 31
+#define LABEL_FIND_DONE 32
+#define LABEL_SMALL_N_STEP_DOWN(x) (33+(x))
+/* the small n path is never taken by 2D programs, which can reuse its
+ * labels */
+#define LABEL_TRANSPOSE_STEP_DOWN(x) LABEL_SMALL_N_STEP_DOWN(x)
+#define LABEL_TRANSPOSE_SKIP 38
+#define LABEL_TRANSPOSE_LOOP 39
+#define LABEL_TRANSPOSE_REGION2_SKIP 18
+#define LABEL_TRANSPOSE_TAIL 19
+/* ring buffer programs are 1D and take neither the small n, batch nor
+ * tile paths, so they reuse those labels */
+#define LABEL_RING_LOOP LABEL_TILE_LOOP
+#define LABEL_RING_DONE LABEL_TILE_WIDTH
+#define LABEL_RING_MIN_SKIP(x) (LABEL_BATCH_ENTRY+(x))
+#define LABEL_RING_WRAP_SKIP(x) LABEL_SMALL_N_STEP_DOWN(x)
+#define ORC_SSE_MAX_RINGS 4
+
+/* For n smaller than one unrolled vector iteration, neither the
+ * alignment split nor the inner loop does any work.  The check is made
+ * right after the prologue, so these calls branch to a separate copy of
+ * the step-down tail (see orc_sse_emit_small_n()) before any of the
+ * per-call setup is done. */
+static void
+orc_emit_small_n_check (OrcCompiler *compiler)
+{
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor,n), compiler->exec_reg, X86_EAX);
+  orc_x86_emit_cmp_imm_reg (compiler, 4,
+      1<<(compiler->loop_shift + compiler->unroll_shift), X86_EAX);
+  orc_x86_emit_jl (compiler, LABEL_SMALL_N);
+}
 
 static void
 orc_compiler_sse_save_registers (OrcCompiler *compiler)
@@ -805,6 +1005,740 @@ orc_compiler_sse_restore_registers (OrcCompiler *compiler)
   }
 }
 
+/* Column strips for 2D programs.  The top of the current strip for each
+ * array is kept in arrays[i+ORC_VAR_C1], the number of columns left in
+ * params[ORC_VAR_C2], and the caller's n in params[ORC_VAR_C3].  n is
+ * set to the strip width while the rows of the strip are processed. */
+static void
+orc_sse_emit_tile_start (OrcCompiler *compiler)
+{
+  int ptr_size = compiler->is_64bit ? 8 : 4;
+  int i;
+
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg, X86_EAX);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C2]),
+      compiler->exec_reg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C3]),
+      compiler->exec_reg);
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name == NULL) continue;
+    orc_x86_emit_mov_memoffset_reg (compiler, ptr_size,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg,
+        compiler->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (compiler, ptr_size, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i + ORC_VAR_C1]),
+        compiler->exec_reg);
+  }
+
+  orc_x86_emit_label (compiler, LABEL_TILE_LOOP);
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C2]),
+      compiler->exec_reg, X86_EAX);
+  orc_x86_emit_cmp_imm_reg (compiler, 4, compiler->tile_n, X86_EAX);
+  orc_x86_emit_jle (compiler, LABEL_TILE_WIDTH);
+  orc_x86_emit_mov_imm_reg (compiler, 4, compiler->tile_n, X86_EAX);
+  orc_x86_emit_label (compiler, LABEL_TILE_WIDTH);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg);
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name == NULL) continue;
+    orc_x86_emit_mov_memoffset_reg (compiler, ptr_size,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i + ORC_VAR_C1]),
+        compiler->exec_reg, compiler->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (compiler, ptr_size, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg);
+  }
+}
+
+static void
+orc_sse_emit_tile_end (OrcCompiler *compiler)
+{
+  int ptr_size = compiler->is_64bit ? 8 : 4;
+  int i;
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name == NULL) continue;
+    if (compiler->vars[i].transposed) {
+      /* the columns of the output are the rows of a transposed source */
+      orc_x86_emit_mov_imm_reg (compiler, 4, compiler->tile_n,
+          compiler->gp_tmpreg);
+      orc_x86_emit_imul_memoffset_reg (compiler, 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
+          compiler->gp_tmpreg);
+      orc_x86_emit_add_reg_memoffset (compiler, ptr_size, compiler->gp_tmpreg,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i + ORC_VAR_C1]),
+          compiler->exec_reg);
+      continue;
+    }
+    orc_x86_emit_add_imm_memoffset (compiler, ptr_size,
+        compiler->tile_n * compiler->vars[i].size,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i + ORC_VAR_C1]),
+        compiler->exec_reg);
+  }
+  orc_x86_emit_add_imm_memoffset (compiler, 4, -compiler->tile_n,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C2]),
+      compiler->exec_reg);
+  orc_x86_emit_jg (compiler, LABEL_TILE_LOOP);
+
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C3]),
+      compiler->exec_reg, X86_EAX);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg);
+}
+
+/* Number of ring buffers the loop wraps itself, or 0.  Each needs a
+ * pointer register to reload at the wrap, and elements of a power-of-two
+ * size.  Other programs with rings are split by _orc_ring_setup(). */
+static int
+sse_get_ring_wrap (OrcCompiler *compiler)
+{
+  OrcVariable *var;
+  int n_rings = 0;
+  int i;
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    var = compiler->vars + i;
+    if (var->name == NULL || !var->ring) continue;
+    if (var->ptr_register == 0 || var->element_stride > 1 ||
+        (var->size & (var->size - 1)) != 0) {
+      return FALSE;
+    }
+    n_rings++;
+  }
+  return (n_rings <= ORC_SSE_MAX_RINGS) ? n_rings : 0;
+}
+
+/* Ring buffers.  The call is run in segments that end where n runs out
+ * or a ring wraps.  The elements left in the call are kept in
+ * params[ORC_VAR_C2], the caller's n in params[ORC_VAR_C3], and the
+ * elements left before each ring wraps in params[ORC_VAR_C4+x].  n is
+ * set to the segment length while the segment runs.  A call with a bad
+ * ring size or start does nothing. */
+static void
+orc_sse_emit_ring_start (OrcCompiler *compiler)
+{
+  OrcVariable *var;
+  int x;
+  int i;
+
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg, X86_EAX);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C2]),
+      compiler->exec_reg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C3]),
+      compiler->exec_reg);
+  orc_x86_emit_test_reg_reg (compiler, 4, X86_EAX, X86_EAX);
+  orc_x86_emit_jle (compiler, LABEL_RING_DONE);
+
+  x = 0;
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name == NULL || !compiler->vars[i].ring) continue;
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_T9 + i]),
+        compiler->exec_reg, X86_EAX);
+    orc_x86_emit_test_reg_reg (compiler, 4, X86_EAX, X86_EAX);
+    orc_x86_emit_jle (compiler, LABEL_RING_DONE);
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor,
+          params[ORC_VAR_T9 + ORC_N_ARRAYS + i]),
+        compiler->exec_reg, compiler->gp_tmpreg);
+    orc_x86_emit_test_reg_reg (compiler, 4, compiler->gp_tmpreg,
+        compiler->gp_tmpreg);
+    orc_x86_emit_jl (compiler, LABEL_RING_DONE);
+    orc_x86_emit_sub_reg_reg (compiler, 4, compiler->gp_tmpreg, X86_EAX);
+    orc_x86_emit_jle (compiler, LABEL_RING_DONE);
+    orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C4 + x]),
+        compiler->exec_reg);
+    x++;
+  }
+
+  /* eax may be a pointer register from here on */
+  sse_load_constants_inner (compiler);
+
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    var = compiler->vars + i;
+    if (var->name == NULL || !var->ring) continue;
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor,
+          params[ORC_VAR_T9 + ORC_N_ARRAYS + i]),
+        compiler->exec_reg, compiler->gp_tmpreg);
+    orc_x86_emit_add_reg_reg_shift (compiler, compiler->is_64bit ? 8 : 4,
+        compiler->gp_tmpreg, var->ptr_register, get_shift (var->size));
+  }
+
+  orc_x86_emit_label (compiler, LABEL_RING_LOOP);
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C2]),
+      compiler->exec_reg, compiler->gp_tmpreg);
+  for(x=0;x<compiler->ring_wrap;x++){
+    orc_x86_emit_cmp_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C4 + x]),
+        compiler->exec_reg);
+    orc_x86_emit_jge (compiler, LABEL_RING_MIN_SKIP(x));
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C4 + x]),
+        compiler->exec_reg, compiler->gp_tmpreg);
+    orc_x86_emit_label (compiler, LABEL_RING_MIN_SKIP(x));
+  }
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg);
+
+  /* orc_emit_split_2_regions() without eax */
+  if (compiler->loop_shift > 0) {
+    orc_x86_emit_sar_imm_reg (compiler, 4,
+        compiler->loop_shift + compiler->unroll_shift, compiler->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, counter2), compiler->exec_reg);
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg,
+        compiler->gp_tmpreg);
+    orc_x86_emit_and_imm_reg (compiler, 4,
+        (1<<(compiler->loop_shift + compiler->unroll_shift))-1,
+        compiler->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, counter3), compiler->exec_reg);
+  } else {
+    orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, counter2), compiler->exec_reg);
+  }
+}
+
+/* The pointers of the other arrays carry on from where the segment
+ * stopped.  A ring that is used up starts again at its first element;
+ * its pointer register holds the ring size on the way. */
+static void
+orc_sse_emit_ring_end (OrcCompiler *compiler)
+{
+  int ptr_reg;
+  int x;
+  int i;
+
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg,
+      compiler->gp_tmpreg);
+
+  x = 0;
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name == NULL || !compiler->vars[i].ring) continue;
+    ptr_reg = compiler->vars[i].ptr_register;
+    orc_x86_emit_sub_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C4 + x]),
+        compiler->exec_reg);
+    orc_x86_emit_jne (compiler, LABEL_RING_WRAP_SKIP(x));
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_T9 + i]),
+        compiler->exec_reg, ptr_reg);
+    orc_x86_emit_mov_reg_memoffset (compiler, 4, ptr_reg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C4 + x]),
+        compiler->exec_reg);
+    orc_x86_emit_mov_memoffset_reg (compiler, compiler->is_64bit ? 8 : 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg,
+        ptr_reg);
+    orc_x86_emit_label (compiler, LABEL_RING_WRAP_SKIP(x));
+    x++;
+  }
+
+  orc_x86_emit_sub_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C2]),
+      compiler->exec_reg);
+  orc_x86_emit_jg (compiler, LABEL_RING_LOOP);
+
+  orc_x86_emit_label (compiler, LABEL_RING_DONE);
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_C3]),
+      compiler->exec_reg, compiler->gp_tmpreg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg);
+}
+
+#ifndef MMX
+/* Batch entry point, x86-64 only:
+ *   void func (OrcExecutor *ex, const OrcBatchJob *jobs, int n_jobs)
+ * The job pointer and the number of jobs left are kept in
+ * arrays[ORC_VAR_A3] and params[ORC_VAR_A3].  The regular entry point
+ * sets params[ORC_VAR_A3] to 0, which makes the job loop run the body
+ * once with the n and arrays already in the executor. */
+static int
+sse_can_batch (OrcCompiler *compiler)
+{
+  int i;
+
+  if (!compiler->is_64bit) return FALSE;
+  if (compiler->program->is_2d) return FALSE;
+  if (compiler->program->constant_n > 0) return FALSE;
+  if (compiler->find_label) return FALSE;
+  if (compiler->ring_wrap) return FALSE;
+  for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
+    /* the resampling offsets are only loaded once */
+    if (compiler->vars[i].need_offset_reg) return FALSE;
+  }
+  return TRUE;
+}
+
+static void
+orc_sse_emit_batch_entry (OrcCompiler *compiler, int set_mxcsr)
+{
+#ifdef HAVE_OS_WIN32
+  int jobs_reg = X86_EDX;
+  int n_jobs_reg = X86_R8;
+#else
+  int jobs_reg = X86_ESI;
+  int n_jobs_reg = X86_EDX;
+#endif
+
+  orc_x86_emit_label (compiler, LABEL_BATCH_ENTRY);
+  orc_x86_emit_cpuinsn_none (compiler, ORC_X86_endbr64);
+  orc_x86_emit_mov_reg_memoffset (compiler, 8, jobs_reg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[ORC_VAR_A3]),
+      compiler->exec_reg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, n_jobs_reg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_A3]),
+      compiler->exec_reg);
+
+  orc_x86_emit_push_saved_regs (compiler);
+  orc_compiler_sse_save_registers (compiler);
+  if (set_mxcsr) {
+    orc_sse_set_mxcsr (compiler);
+  }
+  orc_x86_emit_jmp (compiler, LABEL_BATCH_START);
+}
+
+static void
+orc_sse_emit_batch_load_job (OrcCompiler *compiler)
+{
+  int i;
+
+  orc_x86_emit_label (compiler, LABEL_BATCH_LOOP);
+  orc_x86_emit_cmp_imm_memoffset (compiler, 4, 0,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_A3]),
+      compiler->exec_reg);
+  orc_x86_emit_je (compiler, LABEL_BATCH_LOAD_SKIP);
+
+  orc_x86_emit_mov_memoffset_reg (compiler, 8,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[ORC_VAR_A3]),
+      compiler->exec_reg, X86_EAX);
+  orc_x86_emit_mov_memoffset_reg (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcBatchJob, n), X86_EAX, compiler->gp_tmpreg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg);
+  for(i=ORC_VAR_D1;i<=ORC_VAR_S8;i++){
+    if (compiler->vars[i].name == NULL) continue;
+    orc_x86_emit_mov_memoffset_reg (compiler, 8,
+        (int)ORC_STRUCT_OFFSET(OrcBatchJob, arrays[i - ORC_VAR_D1]),
+        X86_EAX, compiler->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (compiler, 8, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg);
+  }
+
+  orc_x86_emit_label (compiler, LABEL_BATCH_LOAD_SKIP);
+}
+
+static void
+orc_sse_emit_batch_next_job (OrcCompiler *compiler)
+{
+  orc_x86_emit_cmp_imm_memoffset (compiler, 4, 0,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_A3]),
+      compiler->exec_reg);
+  orc_x86_emit_je (compiler, LABEL_BATCH_DONE);
+
+  orc_x86_emit_add_imm_memoffset (compiler, 8, (int)sizeof(OrcBatchJob),
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[ORC_VAR_A3]),
+      compiler->exec_reg);
+  orc_x86_emit_add_imm_memoffset (compiler, 4, -1,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_A3]),
+      compiler->exec_reg);
+  orc_x86_emit_jne (compiler, LABEL_BATCH_LOOP);
+
+  orc_x86_emit_label (compiler, LABEL_BATCH_DONE);
+}
+#endif
+
+/* A find that never matched leaves n in its accumulator.  A match
+ * jumps here with the nonzero bytes of the loop pass in gp_tmpreg. */
+static void
+sse_emit_find_exit (OrcCompiler *compiler)
+{
+  int var = sse_get_find_var (compiler);
+  int size = 0;
+  int j;
+
+  for(j=0;j<compiler->n_insns;j++){
+    if (compiler->insns[j].opcode->flags & ORC_STATIC_OPCODE_FIND) {
+      size = compiler->insns[j].opcode->src_size[0];
+    }
+  }
+
+  if (compiler->program->constant_n > 0) {
+    orc_x86_emit_mov_imm_reg (compiler, 4, compiler->program->constant_n,
+        compiler->gp_tmpreg);
+  } else {
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, n), compiler->exec_reg,
+        compiler->gp_tmpreg);
+  }
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, accumulators[var-ORC_VAR_A1]),
+      compiler->exec_reg);
+  orc_x86_emit_jmp (compiler, LABEL_FIND_DONE);
+
+  orc_x86_emit_label (compiler, LABEL_FIND_MATCH);
+  orc_x86_emit_bsf_reg_reg (compiler, 4, compiler->gp_tmpreg,
+      compiler->gp_tmpreg);
+  orc_x86_emit_sar_imm_reg (compiler, 4, get_shift (size),
+      compiler->gp_tmpreg);
+  orc_x86_emit_add_reg_reg (compiler, 4, compiler->find_offset,
+      compiler->gp_tmpreg);
+  orc_x86_emit_add_reg_reg (compiler, 4, compiler->find_counter,
+      compiler->gp_tmpreg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, accumulators[var-ORC_VAR_A1]),
+      compiler->exec_reg);
+  orc_x86_emit_label (compiler, LABEL_FIND_DONE);
+}
+
+/* Step-down tail loops: runs the remaining counter3 elements in
+ * power-of-two chunks, largest first. */
+static void
+orc_sse_emit_step_down (OrcCompiler *compiler, int align_var, int label_base)
+{
+  int save_loop_shift;
+  int l;
+
+  save_loop_shift = compiler->loop_shift;
+  sse_set_aligned (compiler, align_var, FALSE);
+
+  for(l=save_loop_shift + compiler->unroll_shift - 1; l >= 0; l--) {
+    compiler->loop_shift = l;
+    ORC_ASM_CODE(compiler, "# LOOP SHIFT %d\n", compiler->loop_shift);
+
+    orc_x86_emit_test_imm_memoffset (compiler, 4, 1<<compiler->loop_shift,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor,counter3), compiler->exec_reg);
+    orc_x86_emit_je (compiler, label_base + compiler->loop_shift);
+    orc_sse_emit_loop (compiler, 0, 1<<compiler->loop_shift);
+    orc_x86_emit_label (compiler, label_base + compiler->loop_shift);
+  }
+
+  compiler->loop_shift = save_loop_shift;
+}
+
+/* Target of orc_emit_small_n_check(), with n still in eax.  Only the
+ * setup the tail loops use is done: no batch, tile or region split
+ * bookkeeping, and counter3 is n itself. */
+static void
+orc_sse_emit_small_n (OrcCompiler *compiler, int align_var)
+{
+#ifndef MMX
+  int set_mxcsr = orc_program_has_float (compiler);
+#endif
+
+  orc_x86_emit_label (compiler, LABEL_SMALL_N);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, X86_EAX,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor,counter3), compiler->exec_reg);
+
+  orc_compiler_sse_save_registers (compiler);
+#ifndef MMX
+  if (set_mxcsr) {
+    orc_sse_set_mxcsr (compiler);
+  }
+#endif
+
+  sse_load_constants_outer (compiler);
+  sse_load_constants_inner (compiler);
+
+  orc_sse_emit_step_down (compiler, align_var, LABEL_SMALL_N_STEP_DOWN(0));
+
+  sse_save_accumulators (compiler);
+
+#ifndef MMX
+  if (set_mxcsr) {
+    orc_sse_restore_mxcsr (compiler);
+  }
+#else
+  orc_x86_emit_emms (compiler);
+#endif
+
+  orc_compiler_sse_restore_registers (compiler);
+
+  orc_x86_emit_epilogue (compiler);
+}
+
+#ifndef MMX
+/* bytes the pointer of a source or destination moves per element */
+static int
+sse_get_element_bytes (OrcVariable *var)
+{
+  if (var->update_type == 0) return 0;
+  if (var->element_stride > 1) return var->size * var->element_stride;
+  return var->size;
+}
+
+/* A transposed source that fills a vector at full width is transposed
+ * in registers, a block of as many rows as the vector has elements at a
+ * time, as long as nothing else carries state from one row to the next
+ * and every pointer can be stepped back over the tail of a row.  The
+ * update types are only known after the first pass over the loop.
+ * Returns the rows of a block, or 0 to gather the columns element by
+ * element. */
+static int
+sse_get_transpose_rows (OrcCompiler *compiler)
+{
+  int n_loadtr = 0;
+  int size = 0;
+  int i;
+
+  if (!compiler->program->is_2d) return 0;
+  if (compiler->program->constant_n > 0) return 0;
+  if (compiler->program->constant_m == 1) return 0;
+  if (compiler->has_iterator_opcode || compiler->find_label) return 0;
+
+  for(i=0;i<compiler->n_insns;i++){
+    OrcInstruction *insn = compiler->insns + i;
+
+    if (insn->opcode->flags & ORC_STATIC_OPCODE_SCAN) return 0;
+    if (insn->flags & ORC_INSN_FLAG_TAP_WINDOW) return 0;
+    if (strncmp (insn->opcode->name, "loadtr", 6) == 0) {
+      size = compiler->vars[insn->src_args[0]].size;
+      n_loadtr++;
+    }
+  }
+  if (n_loadtr != 1) return 0;
+  if ((size << compiler->loop_shift) != 16) return 0;
+
+  for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
+    OrcVariable *var = compiler->vars + i;
+    int bytes;
+
+    if (var->name == NULL) continue;
+    if (var->vartype != ORC_VAR_TYPE_SRC &&
+        var->vartype != ORC_VAR_TYPE_DEST) continue;
+    if (var->ptr_register == 0) return 0;
+    if (var->transposed) continue;
+    if (var->need_offset_reg || var->update_type == 1) return 0;
+    bytes = sse_get_element_bytes (var);
+    if (bytes > 8 || (bytes & (bytes - 1))) return 0;
+  }
+
+  return 16 / size;
+}
+
+/* Sets aside vector registers the loop leaves unused for the columns
+ * of a block and a spare, 9 for 16 rows of bytes, which are transposed
+ * as 8 rows of words.  Returns FALSE if there are not enough. */
+static int
+sse_reserve_transpose_regs (OrcCompiler *compiler, int rows)
+{
+  int n = (rows == 16) ? 9 : rows + 1;
+  int regs[9];
+  int i, j;
+
+  j = 0;
+  for(i=X86_XMM0;i<X86_XMM0+16 && j<n;i++){
+    if (compiler->valid_regs[i] && !compiler->used_regs[i] &&
+        i > compiler->max_used_temp_reg) {
+      regs[j++] = i;
+    }
+  }
+  if (j < n) return FALSE;
+
+  for(j=0;j<n;j++){
+    compiler->transpose_regs[j] = regs[j];
+    compiler->valid_regs[regs[j]] = 0;
+    compiler->used_regs[regs[j]] = 1;
+  }
+  return TRUE;
+}
+
+/* Moves the pointers that are not transposed by a number of rows. */
+static void
+sse_emit_row_step (OrcCompiler *compiler, int rows)
+{
+  int i;
+
+  for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
+    OrcVariable *var = compiler->vars + i;
+
+    if (var->name == NULL) continue;
+    if (var->vartype != ORC_VAR_TYPE_SRC &&
+        var->vartype != ORC_VAR_TYPE_DEST) continue;
+    if (var->transposed || sse_ptr_is_shared (compiler, i)) continue;
+
+    if (rows == 1) {
+      orc_x86_emit_mov_memoffset_reg (compiler, 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
+          compiler->gp_tmpreg);
+    } else {
+      orc_x86_emit_mov_imm_reg (compiler, 4, (rows < 0) ? -rows : rows,
+          compiler->gp_tmpreg);
+      orc_x86_emit_imul_memoffset_reg (compiler, 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
+          compiler->gp_tmpreg);
+    }
+    if (rows < 0) {
+      orc_x86_emit_sub_reg_reg (compiler, compiler->is_64bit ? 8 : 4,
+          compiler->gp_tmpreg, var->ptr_register);
+    } else {
+      orc_x86_emit_add_reg_reg (compiler, compiler->is_64bit ? 8 : 4,
+          compiler->gp_tmpreg, var->ptr_register);
+    }
+  }
+}
+
+/* After the tail of one row of a block, moves the pointers to the tail
+ * of the next row: back over the counter3 elements done and one stride
+ * down, or for the transposed source back up the counter3 rows read and
+ * one column right. */
+static void
+sse_emit_tail_step (OrcCompiler *compiler)
+{
+  int i;
+  int b;
+
+  for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
+    OrcVariable *var = compiler->vars + i;
+
+    if (var->name == NULL) continue;
+    if (var->vartype != ORC_VAR_TYPE_SRC &&
+        var->vartype != ORC_VAR_TYPE_DEST) continue;
+    if (sse_ptr_is_shared (compiler, i)) continue;
+
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, counter3), compiler->exec_reg,
+        compiler->gp_tmpreg);
+    if (var->transposed) {
+      orc_x86_emit_imul_memoffset_reg (compiler, 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
+          compiler->gp_tmpreg);
+      orc_x86_emit_sub_reg_reg (compiler, compiler->is_64bit ? 8 : 4,
+          compiler->gp_tmpreg, var->ptr_register);
+      orc_x86_emit_add_imm_reg (compiler, compiler->is_64bit ? 8 : 4,
+          var->size, var->ptr_register, FALSE);
+      continue;
+    }
+    if (sse_get_element_bytes (var) > 0) {
+      for(b=1;b<sse_get_element_bytes (var);b<<=1){
+        orc_x86_emit_add_reg_reg (compiler, 4, compiler->gp_tmpreg,
+            compiler->gp_tmpreg);
+      }
+      orc_x86_emit_sub_reg_reg (compiler, compiler->is_64bit ? 8 : 4,
+          compiler->gp_tmpreg, var->ptr_register);
+    }
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
+        compiler->gp_tmpreg);
+    orc_x86_emit_add_reg_reg (compiler, compiler->is_64bit ? 8 : 4,
+        compiler->gp_tmpreg, var->ptr_register);
+  }
+}
+
+/* Runs the rows of a 2D program reading a transposed source in blocks
+ * while at least a block of rows is left.  The main loop emits the body
+ * once per row of the block, the first row loading the block and
+ * transposing it (see sse_rule_loadtrX()), and the tails of the rows
+ * gather their columns one after the other.  Then the arrays move down
+ * a block of rows, and the rows left over take the regular path. */
+static void
+orc_sse_emit_transposed_rows (OrcCompiler *compiler, int align_var, int rows)
+{
+  int save_unroll_shift = compiler->unroll_shift;
+  int save_is_aligned = compiler->vars[align_var].is_aligned;
+  int i;
+  int k;
+
+  ORC_ASM_CODE(compiler, "# TRANSPOSE %d ROWS\n", rows);
+  orc_x86_emit_cmp_imm_memoffset (compiler, 4, rows,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_A2]),
+      compiler->exec_reg);
+  orc_x86_emit_jl (compiler, LABEL_TRANSPOSE_SKIP);
+
+  compiler->unroll_shift = 0;
+  orc_emit_split_2_regions (compiler);
+  sse_load_constants_inner (compiler);
+
+  orc_x86_emit_cmp_imm_memoffset (compiler, 4, 0,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor,counter2), compiler->exec_reg);
+  orc_x86_emit_je (compiler, LABEL_TRANSPOSE_REGION2_SKIP);
+
+  if (compiler->loop_counter != ORC_REG_INVALID) {
+    orc_x86_emit_mov_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, counter2), compiler->exec_reg,
+        compiler->loop_counter);
+  }
+
+  ORC_ASM_CODE(compiler, "# LOOP SHIFT %d\n", compiler->loop_shift);
+  orc_x86_emit_align (compiler, 4);
+  orc_x86_emit_label (compiler, LABEL_TRANSPOSE_LOOP);
+  compiler->transpose_rows = rows;
+  for(k=0;k<rows;k++){
+    compiler->transpose_row = k;
+    if (k > 0) {
+      sse_emit_row_step (compiler, 1);
+    }
+    orc_sse_emit_loop (compiler, 0, 0);
+  }
+  compiler->transpose_rows = 0;
+  sse_emit_row_step (compiler, 1 - rows);
+  orc_sse_emit_update (compiler, 1<<compiler->loop_shift);
+  if (compiler->loop_counter != ORC_REG_INVALID) {
+    orc_x86_emit_add_imm_reg (compiler, 4, -1, compiler->loop_counter, TRUE);
+  } else {
+    orc_x86_emit_dec_memoffset (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor,counter2),
+        compiler->exec_reg);
+  }
+  orc_x86_emit_jne (compiler, LABEL_TRANSPOSE_LOOP);
+  orc_x86_emit_label (compiler, LABEL_TRANSPOSE_REGION2_SKIP);
+
+  /* counter2 counts the tails of the rows */
+  orc_x86_emit_mov_imm_reg (compiler, 4, rows, compiler->gp_tmpreg);
+  orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor,counter2), compiler->exec_reg);
+  orc_x86_emit_label (compiler, LABEL_TRANSPOSE_TAIL);
+  orc_sse_emit_step_down (compiler, align_var, LABEL_TRANSPOSE_STEP_DOWN(0));
+  sse_emit_tail_step (compiler);
+  orc_x86_emit_dec_memoffset (compiler, 4,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor,counter2), compiler->exec_reg);
+  orc_x86_emit_jne (compiler, LABEL_TRANSPOSE_TAIL);
+
+  for(i=0;i<ORC_N_COMPILER_VARIABLES;i++){
+    OrcVariable *var = compiler->vars + i;
+
+    if (var->name == NULL) continue;
+    if (var->vartype != ORC_VAR_TYPE_SRC &&
+        var->vartype != ORC_VAR_TYPE_DEST) continue;
+    if (var->transposed) {
+      orc_x86_emit_add_imm_memoffset (compiler, compiler->is_64bit ? 8 : 4,
+          rows * var->size,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg);
+      continue;
+    }
+    orc_x86_emit_mov_imm_reg (compiler, 4, rows, compiler->gp_tmpreg);
+    orc_x86_emit_imul_memoffset_reg (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[i]), compiler->exec_reg,
+        compiler->gp_tmpreg);
+    orc_x86_emit_add_reg_memoffset (compiler, compiler->is_64bit ? 8 : 4,
+        compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]), compiler->exec_reg);
+  }
+
+  orc_x86_emit_add_imm_memoffset (compiler, 4, -rows,
+      (int)ORC_STRUCT_OFFSET(OrcExecutor,params[ORC_VAR_A2]),
+      compiler->exec_reg);
+  orc_x86_emit_jne (compiler, LABEL_OUTER_LOOP);
+  orc_x86_emit_jmp (compiler, LABEL_OUTER_LOOP_SKIP);
+  orc_x86_emit_label (compiler, LABEL_TRANSPOSE_SKIP);
+
+  compiler->unroll_shift = save_unroll_shift;
+  sse_set_aligned (compiler, align_var, save_is_aligned);
+}
+#endif
+
 static void
 orc_compiler_sse_assemble (OrcCompiler *compiler)
 {
@@ -813,6 +1747,9 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
 #endif
   int align_var;
   int is_aligned;
+  int use_small_n;
+  int use_batch = FALSE;
+  int transpose_rows = 0;
 
   if (0 && orc_x86_assemble_copy_check (compiler)) {
     /* The rep movs implementation isn't faster most of the time */
@@ -825,7 +1762,25 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
     orc_x86_assemble_copy (compiler);
     return;
   }
-  is_aligned = compiler->vars[align_var].is_aligned;
+  is_aligned = compiler->vars[align_var].is_aligned ||
+    !IS_ALIGNABLE (compiler->vars + align_var);
+  compiler->ring_wrap = sse_get_ring_wrap (compiler);
+
+  use_small_n = ((compiler->target_flags & ORC_TARGET_SSE_SMALL_N) &&
+      compiler->loop_shift > 0 && compiler->program->n_minimum <
+      (1<<(compiler->loop_shift + compiler->unroll_shift)) &&
+      !(compiler->program->constant_n > 0 &&
+        compiler->program->constant_n <= ORC_SSE_ALIGNED_DEST_CUTOFF) &&
+      !compiler->program->is_2d && compiler->tile_n == 0 &&
+      sse_get_find_var (compiler) < 0 && compiler->ring_wrap == 0);
+
+  if (sse_get_find_var (compiler) >= 0) {
+    if (compiler->find_counter == 0 || compiler->find_offset == 0) {
+      orc_compiler_error (compiler, "no registers left for find");
+      return;
+    }
+    compiler->find_label = LABEL_FIND_MATCH;
+  }
 
   {
     orc_sse_emit_loop (compiler, 0, 0);
@@ -842,8 +1797,22 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
 
   if (compiler->error) return;
 
+#ifndef MMX
+  use_batch = sse_can_batch (compiler);
+  transpose_rows = sse_get_transpose_rows (compiler);
+  if (transpose_rows > 0 &&
+      !sse_reserve_transpose_regs (compiler, transpose_rows)) {
+    transpose_rows = 0;
+  }
+#endif
+
+  orc_x86_emit_label (compiler, LABEL_ENTRY);
   orc_x86_emit_prologue (compiler);
 
+  if (use_small_n) {
+    orc_emit_small_n_check (compiler);
+  }
+
   orc_compiler_sse_save_registers (compiler);
 
 #ifndef MMX
@@ -853,8 +1822,32 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
   }
 #endif
 
+#ifndef MMX
+  if (use_batch) {
+    orc_x86_emit_mov_imm_reg (compiler, 4, 0, compiler->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[ORC_VAR_A3]),
+        compiler->exec_reg);
+    orc_x86_emit_label (compiler, LABEL_BATCH_START);
+  }
+#endif
+
   sse_load_constants_outer (compiler);
 
+#ifndef MMX
+  if (use_batch) {
+    orc_sse_emit_batch_load_job (compiler);
+  }
+#endif
+
+  if (compiler->tile_n > 0) {
+    orc_sse_emit_tile_start (compiler);
+  }
+
+  if (compiler->ring_wrap) {
+    orc_sse_emit_ring_start (compiler);
+  }
+
   if (compiler->program->is_2d) {
     if (compiler->program->constant_m > 0) {
       orc_x86_emit_mov_imm_reg (compiler, 4, compiler->program->constant_m,
@@ -874,11 +1867,19 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
     }
 
     orc_x86_emit_label (compiler, LABEL_OUTER_LOOP);
+#ifndef MMX
+    if (transpose_rows > 0) {
+      orc_sse_emit_transposed_rows (compiler, align_var, transpose_rows);
+    }
+#endif
   }
 
   if (compiler->program->constant_n > 0 &&
-      compiler->program->constant_n <= ORC_SSE_ALIGNED_DEST_CUTOFF) {
+      compiler->program->constant_n <= ORC_SSE_ALIGNED_DEST_CUTOFF &&
+      compiler->ring_wrap == 0) {
     /* don't need to load n */
+  } else if (compiler->ring_wrap) {
+    /* split by orc_sse_emit_ring_start() */
   } else if (compiler->loop_shift > 0) {
     if (compiler->has_iterator_opcode || is_aligned) {
       orc_emit_split_2_regions (compiler);
@@ -895,10 +1896,13 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
         (int)ORC_STRUCT_OFFSET(OrcExecutor,counter2), compiler->exec_reg);
   }
 
-  sse_load_constants_inner (compiler);
+  if (compiler->ring_wrap == 0) {
+    sse_load_constants_inner (compiler);
+  }
 
   if (compiler->program->constant_n > 0 &&
-      compiler->program->constant_n <= ORC_SSE_ALIGNED_DEST_CUTOFF) {
+      compiler->program->constant_n <= ORC_SSE_ALIGNED_DEST_CUTOFF &&
+      compiler->ring_wrap == 0) {
     int n_left = compiler->program->constant_n;
     int save_loop_shift;
     int loop_shift;
@@ -906,6 +1910,11 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
     compiler->offset = 0;
 
     save_loop_shift = compiler->loop_shift;
+#ifndef MMX
+    if (n_left >= (1<<compiler->loop_shift)) {
+      sse_load_taps (compiler);
+    }
+#endif
     while (n_left >= (1<<compiler->loop_shift)) {
       ORC_ASM_CODE(compiler, "# LOOP SHIFT %d\n", compiler->loop_shift);
       orc_sse_emit_loop (compiler, compiler->offset, 0);
@@ -913,6 +1922,7 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
       n_left -= 1<<compiler->loop_shift;
       compiler->offset += 1<<compiler->loop_shift;
     }
+    compiler->tap_carry = FALSE;
     for(loop_shift = compiler->loop_shift-1; loop_shift>=0; loop_shift--) {
       if (n_left >= (1<<loop_shift)) {
         compiler->loop_shift = loop_shift;
@@ -929,7 +1939,9 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
     int emit_region1 = TRUE;
     int emit_region3 = TRUE;
 
-    if (compiler->has_iterator_opcode || is_aligned) {
+    /* a ring buffer segment can start anywhere, so it runs unaligned
+     * without a region 1 */
+    if (compiler->has_iterator_opcode || is_aligned || compiler->ring_wrap) {
       emit_region1 = FALSE;
     }
     if (compiler->loop_shift == 0) {
@@ -942,7 +1954,7 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
       int l;
 
       save_loop_shift = compiler->loop_shift;
-      compiler->vars[align_var].is_aligned = FALSE;
+      sse_set_aligned (compiler, align_var, FALSE);
 
       for (l=0;l<save_loop_shift;l++){
         compiler->loop_shift = l;
@@ -956,7 +1968,7 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
       }
 
       compiler->loop_shift = save_loop_shift;
-      compiler->vars[align_var].is_aligned = TRUE;
+      sse_set_aligned (compiler, align_var, TRUE);
     }
 
     orc_x86_emit_label (compiler, LABEL_REGION1_SKIP);
@@ -971,6 +1983,10 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
           compiler->loop_counter);
     }
 
+#ifndef MMX
+    sse_load_taps (compiler);
+#endif
+
     ORC_ASM_CODE(compiler, "# LOOP SHIFT %d\n", compiler->loop_shift);
     orc_x86_emit_align (compiler, 4);
     orc_x86_emit_label (compiler, LABEL_INNER_LOOP_START);
@@ -989,30 +2005,18 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
           compiler->exec_reg);
     }
     orc_x86_emit_jne (compiler, LABEL_INNER_LOOP_START);
+    compiler->tap_carry = FALSE;
     orc_x86_emit_label (compiler, LABEL_REGION2_SKIP);
 
     if (emit_region3) {
-      int save_loop_shift;
-      int l;
-
-      save_loop_shift = compiler->loop_shift + compiler->unroll_shift;
-      compiler->vars[align_var].is_aligned = FALSE;
-
-      for(l=save_loop_shift - 1; l >= 0; l--) {
-        compiler->loop_shift = l;
-        ORC_ASM_CODE(compiler, "# LOOP SHIFT %d\n", compiler->loop_shift);
-
-        orc_x86_emit_test_imm_memoffset (compiler, 4, 1<<compiler->loop_shift,
-            (int)ORC_STRUCT_OFFSET(OrcExecutor,counter3), compiler->exec_reg);
-        orc_x86_emit_je (compiler, LABEL_STEP_DOWN(compiler->loop_shift));
-        orc_sse_emit_loop (compiler, 0, 1<<compiler->loop_shift);
-        orc_x86_emit_label (compiler, LABEL_STEP_DOWN(compiler->loop_shift));
-      }
-
-      compiler->loop_shift = save_loop_shift;
+      orc_sse_emit_step_down (compiler, align_var, LABEL_STEP_DOWN(0));
     }
   }
 
+  if (compiler->ring_wrap) {
+    orc_sse_emit_ring_end (compiler);
+  }
+
   if (compiler->program->is_2d && compiler->program->constant_m != 1) {
     sse_add_strides (compiler);
 
@@ -1023,6 +2027,20 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
     orc_x86_emit_label (compiler, LABEL_OUTER_LOOP_SKIP);
   }
 
+  if (compiler->tile_n > 0) {
+    orc_sse_emit_tile_end (compiler);
+  }
+
+  if (compiler->find_label) {
+    sse_emit_find_exit (compiler);
+  }
+
+#ifndef MMX
+  if (use_batch) {
+    orc_sse_emit_batch_next_job (compiler);
+  }
+#endif
+
   sse_save_accumulators (compiler);
 
 #ifndef MMX
@@ -1037,17 +2055,31 @@ orc_compiler_sse_assemble (OrcCompiler *compiler)
 
   orc_x86_emit_epilogue (compiler);
 
+  if (use_small_n) {
+    orc_sse_emit_small_n (compiler, align_var);
+  }
+
+#ifndef MMX
+  if (use_batch) {
+    orc_sse_emit_batch_entry (compiler, set_mxcsr);
+  }
+#endif
+
   orc_x86_calculate_offsets (compiler);
   orc_x86_output_insns (compiler);
 
   orc_x86_do_fixups (compiler);
+
+  if (use_batch && !compiler->error) {
+    compiler->batch_entry =
+        compiler->labels[LABEL_BATCH_ENTRY] - compiler->code;
+  }
 }
 
 static void
 orc_sse_emit_loop (OrcCompiler *compiler, int offset, int update)
 {
   int j;
-  int k;
   OrcInstruction *insn;
   OrcStaticOpcode *opcode;
   OrcRule *rule;
@@ -1095,36 +2127,52 @@ orc_sse_emit_loop (OrcCompiler *compiler, int offset, int update)
   }
 
   if (update) {
-    for(k=0;k<ORC_N_COMPILER_VARIABLES;k++){
-      OrcVariable *var = compiler->vars + k;
-
-      if (var->name == NULL) continue;
-      if (var->vartype == ORC_VAR_TYPE_SRC ||
-          var->vartype == ORC_VAR_TYPE_DEST) {
-        int offset;
-        if (var->update_type == 0) {
-          offset = 0;
-        } else if (var->update_type == 1) {
-          offset = (var->size * update) >> 1;
-        } else {
-          offset = var->size * update;
-        }
+    orc_sse_emit_update (compiler, update);
+  }
+}
+
+/* advances the pointers over the elements of update iterations */
+static void
+orc_sse_emit_update (OrcCompiler *compiler, int update)
+{
+  int k;
 
-        if (offset != 0) {
-          if (compiler->vars[k].ptr_register) {
-            orc_x86_emit_add_imm_reg (compiler, compiler->is_64bit ? 8 : 4,
-                offset,
-                compiler->vars[k].ptr_register, FALSE);
-          } else {
-            orc_x86_emit_add_imm_memoffset (compiler, compiler->is_64bit ? 8 : 4,
-                offset,
-                (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[k]),
-                compiler->exec_reg);
-          }
+  for(k=0;k<ORC_N_COMPILER_VARIABLES;k++){
+    OrcVariable *var = compiler->vars + k;
+
+    if (var->name == NULL) continue;
+    if (var->vartype == ORC_VAR_TYPE_SRC ||
+        var->vartype == ORC_VAR_TYPE_DEST) {
+      int offset;
+      if (var->update_type == 0) {
+        offset = 0;
+      } else if (var->update_type == 1) {
+        offset = (var->size * update) >> 1;
+      } else {
+        offset = var->size * update;
+      }
+      if (var->element_stride > 1) {
+        offset *= var->element_stride;
+      }
+
+      if (offset != 0 && !sse_ptr_is_shared (compiler, k)) {
+        if (compiler->vars[k].ptr_register) {
+          orc_x86_emit_add_imm_reg (compiler, compiler->is_64bit ? 8 : 4,
+              offset,
+              compiler->vars[k].ptr_register, FALSE);
+        } else {
+          orc_x86_emit_add_imm_memoffset (compiler, compiler->is_64bit ? 8 : 4,
+              offset,
+              (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[k]),
+              compiler->exec_reg);
         }
       }
     }
   }
+  if (compiler->find_label) {
+    orc_x86_emit_add_imm_reg (compiler, 4, update, compiler->find_counter,
+        FALSE);
+  }
 }
 
 static void
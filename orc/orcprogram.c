@@ -262,6 +262,28 @@ void orc_program_set_constant_m (OrcProgram *program, int m)
   program->constant_m = m;
 }
 
+/**
+ * orc_program_set_2d_tiling:
+ * @program: a pointer to an OrcProgram structure
+ * @tiling: ORC_TILING_AUTO, ORC_TILING_NONE, or a strip width in elements
+ *
+ * Controls how two-dimensional programs walk the arrays.  Without
+ * tiling, each row is processed across the full width before moving to
+ * the next row.  With tiling, the columns are split into strips, and
+ * each strip is processed for all rows before moving to the next strip,
+ * so that data shared between neighboring rows is still in the cache.
+ *
+ * ORC_TILING_AUTO, the default, uses strips sized to the level 1 data
+ * cache, and only for programs where each element only depends on the
+ * same column of other arrays.  Rows narrower than a strip are processed
+ * as before.  A positive value forces strips of that many elements.
+ */
+void
+orc_program_set_2d_tiling (OrcProgram *program, int tiling)
+{
+  program->tiling = tiling;
+}
+
 /**
  * orc_program_set_backup_function:
  * @program: a pointer to an OrcProgram structure
@@ -740,6 +762,134 @@ orc_program_set_var_alignment (OrcProgram *program, int var, int alignment)
   }
 }
 
+/**
+ * orc_program_set_var_element_stride:
+ * @program: a pointer to an OrcProgram structure
+ * @var: index of a source or destination variable
+ * @stride: distance between consecutive elements, in elements
+ *
+ * Makes the program access every @stride-th element of the array,
+ * for example a single channel of interleaved data, instead of
+ * consecutive elements.  Loads and stores of the variable are
+ * compiled to loadstr and storestr opcodes.  The array must hold
+ * (n - 1) * @stride + 1 elements per row.
+ */
+void
+orc_program_set_var_element_stride (OrcProgram *program, int var, int stride)
+{
+  if (program->vars[var].vartype != ORC_VAR_TYPE_SRC &&
+      program->vars[var].vartype != ORC_VAR_TYPE_DEST) {
+    orc_program_set_error (program, "element stride set on non-array variable");
+    return;
+  }
+  if (stride < 1) {
+    orc_program_set_error (program, "bad element stride");
+    return;
+  }
+  program->vars[var].element_stride = stride;
+}
+
+/**
+ * orc_program_set_var_transposed:
+ * @program: a pointer to an OrcProgram structure
+ * @var: index of a source variable
+ *
+ * Makes a 2D program read the source array transposed: element i of
+ * row j is element j of row i of the array, so that the destination
+ * rows are the columns of the source.  Loads of the variable are
+ * compiled to loadtr opcodes.  The array must hold m elements per row
+ * and n rows, and its stride is the distance between those rows.
+ */
+void
+orc_program_set_var_transposed (OrcProgram *program, int var)
+{
+  if (program->vars[var].vartype != ORC_VAR_TYPE_SRC) {
+    orc_program_set_error (program, "transposed set on non-source variable");
+    return;
+  }
+  if (program->vars[var].element_stride > 1) {
+    orc_program_set_error (program, "transposed set on strided variable");
+    return;
+  }
+  program->vars[var].transposed = TRUE;
+}
+
+/**
+ * orc_program_set_var_ring:
+ * @program: a pointer to an OrcProgram structure
+ * @var: index of a source or destination variable
+ *
+ * Makes the array of a 1D program a ring buffer.  The size of the ring
+ * and the element where the call starts are given with
+ * orc_executor_set_ring(), and element i of the call is element
+ * (start + i) modulo size of the array.  Calls are split into
+ * contiguous ranges where the ring wraps, so programs with ring
+ * buffers cannot use opcodes whose results depend on where a call
+ * starts, such as loadupdb or running sums.
+ */
+void
+orc_program_set_var_ring (OrcProgram *program, int var)
+{
+  if (program->vars[var].vartype != ORC_VAR_TYPE_SRC &&
+      program->vars[var].vartype != ORC_VAR_TYPE_DEST) {
+    orc_program_set_error (program, "ring set on non-array variable");
+    return;
+  }
+  if (program->vars[var].element_stride > 1 ||
+      program->vars[var].transposed) {
+    orc_program_set_error (program, "ring set on strided variable");
+    return;
+  }
+  program->vars[var].ring = TRUE;
+}
+
+/**
+ * orc_program_set_inplace:
+ * @program: a pointer to an OrcProgram structure
+ * @dest: index of a destination variable
+ * @src: index of a source variable
+ *
+ * Declares that @src and @dest are always called with the same array
+ * (and, in 2D programs, the same stride), so that the program updates
+ * the array in place.  Element i of the destination may only depend on
+ * element i of the source, and the source must be read before the
+ * destination is written.  Compiled code may then address both
+ * variables through a single pointer.  Arrays without the annotation
+ * must not overlap.  When the debug level is at least
+ * ORC_DEBUG_WARNING, orc_executor_run() checks the arrays and emulates
+ * calls that break the declaration.
+ */
+void
+orc_program_set_inplace (OrcProgram *program, int dest, int src)
+{
+  OrcVariable *d = program->vars + dest;
+  OrcVariable *s = program->vars + src;
+  int i;
+
+  if (d->vartype != ORC_VAR_TYPE_DEST || s->vartype != ORC_VAR_TYPE_SRC) {
+    orc_program_set_error (program, "inplace set on non-array variables");
+    return;
+  }
+  if (d->size != s->size) {
+    orc_program_set_error (program, "inplace set on variables of different size");
+    return;
+  }
+  if (d->element_stride > 1 || s->element_stride > 1 || s->transposed ||
+      d->ring || s->ring) {
+    orc_program_set_error (program, "inplace set on strided variable");
+    return;
+  }
+  for(i=ORC_VAR_S1;i<=ORC_VAR_S8;i++){
+    if (program->vars[i].inplace && (i == src ||
+          program->vars[i].inplace_dest == dest)) {
+      orc_program_set_error (program, "inplace set twice on variable");
+      return;
+    }
+  }
+  s->inplace = TRUE;
+  s->inplace_dest = dest;
+}
+
 void
 orc_program_set_sampling_type (OrcProgram *program, int var,
     int sampling_type)
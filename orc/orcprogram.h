@@ -95,8 +95,13 @@ struct _OrcProgram {
   char *init_function;
   char *error_msg;
   unsigned int current_line;
+
+  int tiling;
 };
 
+#define ORC_TILING_AUTO 0
+#define ORC_TILING_NONE (-1)
+
 #define ORC_SRC_ARG(p,i,n) ((p)->vars[(i)->src_args[(n)]].alloc)
 #define ORC_DEST_ARG(p,i,n) ((p)->vars[(i)->dest_args[(n)]].alloc)
 #define ORC_SRC_TYPE(p,i,n) ((p)->vars[(i)->src_args[(n)]].vartype)
@@ -123,6 +128,7 @@ ORC_API void orc_program_set_n_multiple (OrcProgram *ex, int n);
 ORC_API void orc_program_set_n_minimum (OrcProgram *ex, int n);
 ORC_API void orc_program_set_n_maximum (OrcProgram *ex, int n);
 ORC_API void orc_program_set_constant_m (OrcProgram *program, int m);
+ORC_API void orc_program_set_2d_tiling (OrcProgram *program, int tiling);
 
 ORC_API void orc_program_append (OrcProgram *p, const char *opcode, int arg0, int arg1, int arg2);
 ORC_API void orc_program_append_2 (OrcProgram *program, const char *name,
@@ -169,6 +175,11 @@ ORC_API int orc_program_add_parameter_int64 (OrcProgram *program, int size, cons
 ORC_API int orc_program_add_accumulator (OrcProgram *program, int size, const char *name);
 ORC_API void orc_program_set_type_name (OrcProgram *program, int var, const char *type_name);
 ORC_API void orc_program_set_var_alignment (OrcProgram *program, int var, int alignment);
+ORC_API void orc_program_set_var_element_stride (OrcProgram *program, int var, int stride);
+ORC_API void orc_program_set_var_transposed (OrcProgram *program, int var);
+
+ORC_API void orc_program_set_var_ring (OrcProgram *program, int var);
+ORC_API void orc_program_set_inplace (OrcProgram *program, int dest, int src);
 ORC_API void orc_program_set_sampling_type (OrcProgram *program, int var, int sampling_type);
 
 ORC_API int orc_program_allocate_register (OrcProgram *program, int is_data);
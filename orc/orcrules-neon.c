@@ -2294,6 +2294,58 @@ orc_neon_rule_splatw3q (OrcCompiler *p, void *user, OrcInstruction *insn)
 
 }
 
+/* The table of each shuffle follows the one of splatw3q in the
+ * constants at the end of the code, in the order of the instructions. */
+static void
+orc_neon_rule_shuffleX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int size = p->vars[insn->dest_args[0]].size;
+  orc_uint32 code;
+  int offset = 16;
+  int label = 20;
+  int i;
+
+  if (p->vars[insn->src_args[1]].vartype != ORC_VAR_TYPE_CONST) {
+    ORC_COMPILER_ERROR(p, "code generation rule for %s only works with constant permutation",
+        insn->opcode->name);
+    return;
+  }
+  for(i=0;i<p->insn_index;i++){
+    if (strncmp (p->insns[i].opcode->name, "shuffle", 7) == 0) offset += 8;
+  }
+
+  orc_arm_add_fixup (p, label, 1);
+  ORC_ASM_CODE(p,"  vldr %s, .L%d+%d\n",
+      orc_neon_reg_name (p->tmpreg), label, offset);
+  code = 0xed9f0b00;
+  code |= (p->tmpreg&0xf) << 12;
+  code |= ((p->tmpreg>>4)&0x1) << 22;
+  code |= ((offset - 8) >> 2)&0xff;
+  orc_arm_emit (p, code);
+
+  ORC_ASM_CODE(p,"  vtbl.8 %s, { %s }, %s\n",
+      orc_neon_reg_name (p->vars[insn->dest_args[0]].alloc),
+      orc_neon_reg_name (p->vars[insn->src_args[0]].alloc),
+      orc_neon_reg_name (p->tmpreg));
+  code = NEON_BINARY(0xf3b00800,
+      p->vars[insn->dest_args[0]].alloc,
+      p->vars[insn->src_args[0]].alloc,
+      p->tmpreg);
+  orc_arm_emit (p, code);
+
+  if ((size << p->insn_shift) > 8) {
+    ORC_ASM_CODE(p,"  vtbl.8 %s, { %s }, %s\n",
+        orc_neon_reg_name (p->vars[insn->dest_args[0]].alloc+1),
+        orc_neon_reg_name (p->vars[insn->src_args[0]].alloc+1),
+        orc_neon_reg_name (p->tmpreg));
+    code = NEON_BINARY(0xf3b00800,
+        p->vars[insn->dest_args[0]].alloc+1,
+        p->vars[insn->src_args[0]].alloc+1,
+        p->tmpreg);
+    orc_arm_emit (p, code);
+  }
+}
+
 static void
 orc_neon_rule_accsadubl (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -2565,6 +2617,48 @@ orc_neon_rule_mulhsw (OrcCompiler *p, void *user, OrcInstruction *insn)
   }
 }
 
+static void
+orc_neon_rule_maddswl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int i;
+
+  for(i=0;i<((p->insn_shift == 2) ? 2 : 1);i++){
+    orc_neon_emit_binary_long (p, "vmull.s16",0xf2900c00,
+        p->tmpreg,
+        p->vars[insn->src_args[0]].alloc + i,
+        p->vars[insn->src_args[1]].alloc + i);
+    orc_neon_emit_binary (p, "vpadd.i32", 0xf2200b10,
+        p->vars[insn->dest_args[0]].alloc + i,
+        p->tmpreg,
+        p->tmpreg + 1);
+  }
+}
+
+static void
+orc_neon_rule_maddusbw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int i;
+
+  for(i=0;i<((p->insn_shift == 3) ? 2 : 1);i++){
+    orc_neon_emit_unary_long (p, "vmovl.u8", 0xf3880a10,
+        p->tmpreg,
+        p->vars[insn->src_args[0]].alloc + i);
+    orc_neon_emit_unary_long (p, "vmovl.s8", 0xf2880a10,
+        p->tmpreg2,
+        p->vars[insn->src_args[1]].alloc + i);
+    orc_neon_emit_binary_quad (p, "vmul.i16", 0xf2100910,
+        p->tmpreg,
+        p->tmpreg,
+        p->tmpreg2);
+    orc_neon_emit_unary_quad (p, "vpaddl.s16", 0xf3b40200,
+        p->tmpreg,
+        p->tmpreg);
+    orc_neon_emit_unary_narrow (p, "vqmovn.s32", 0xf3b60280,
+        p->vars[insn->dest_args[0]].alloc + i,
+        p->tmpreg);
+  }
+}
+
 static void
 orc_neon_rule_mulhul (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -2862,6 +2956,8 @@ orc_compiler_neon_register_rules (OrcTarget *target)
   REG(mulsbw);
   REG(mulubw);
   REG(mulswl);
+  REG(maddswl);
+  REG(maddusbw);
   REG(muluwl);
 
   REG(accw);
@@ -2910,6 +3006,8 @@ orc_compiler_neon_register_rules (OrcTarget *target)
   REG(splatbw);
   REG(splatbl);
   REG(splatw3q);
+  orc_rule_register (rule_set, "shufflel", orc_neon_rule_shuffleX, NULL);
+  orc_rule_register (rule_set, "shuffleq", orc_neon_rule_shuffleX, NULL);
   REG(div255w);
 
   orc_rule_register (rule_set, "loadpb", neon_rule_loadpX, (void *)1);
@@ -84,6 +84,52 @@ sse_rule_loadpX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
   }
 }
 
+#ifndef MMX
+/* One tap of a filter, see orc_compiler_group_taps().  The first tap
+ * loads the vector at the highest offset; the vector below it is the
+ * one the iteration before loaded, or, outside the main loop, the part
+ * of the vector at the lowest offset below the highest, shifted up.
+ * Each tap is then a palignr of the pair, and the last tap keeps the
+ * high vector for the next iteration. */
+static void
+sse_emit_tap (OrcCompiler *compiler, OrcInstruction *insn, int ptr_reg)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+  OrcVariable *dest = compiler->vars + insn->dest_args[0];
+  OrcVariable *lo = compiler->vars + insn->src_args[2];
+  OrcVariable *hi = compiler->vars + insn->src_args[3];
+  int min = lo->value.i;
+  int max = hi->value.i;
+  int shift;
+
+  if (compiler->insn_index == hi->first_use) {
+    if (!compiler->tap_carry) {
+      orc_x86_emit_mov_memoffset_sse (compiler, 16,
+          (compiler->offset + min) * src->size, ptr_reg, lo->alloc,
+          src->is_aligned && ((min * src->size) & 15) == 0);
+      orc_sse_emit_pslldq_imm (compiler, 16 - (max - min) * src->size,
+          lo->alloc);
+    }
+    orc_x86_emit_mov_memoffset_sse (compiler, 16,
+        (compiler->offset + max) * src->size, ptr_reg, hi->alloc,
+        src->is_aligned && ((max * src->size) & 15) == 0);
+  }
+
+  shift = 16 - max * src->size;
+  if (insn->opcode->src_size[1]) {
+    shift += compiler->vars[insn->src_args[1]].value.i * src->size;
+  }
+  orc_sse_emit_movdqa (compiler, hi->alloc, dest->alloc);
+  if (shift != 16) {
+    orc_sse_emit_palignr (compiler, shift, lo->alloc, dest->alloc);
+  }
+
+  if (compiler->insn_index == hi->last_use && compiler->tap_carry) {
+    orc_sse_emit_movdqa (compiler, hi->alloc, lo->alloc);
+  }
+}
+#endif
+
 static void
 sse_rule_loadX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
 {
@@ -102,6 +148,14 @@ sse_rule_loadX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
   } else {
     ptr_reg = src->ptr_register;
   } 
+#ifndef MMX
+  if ((insn->flags & ORC_INSN_FLAG_TAP_WINDOW) &&
+      (src->size << compiler->loop_shift) == 16) {
+    sse_emit_tap (compiler, insn, ptr_reg);
+    src->update_type = 2;
+    return;
+  }
+#endif
   switch (src->size << compiler->loop_shift) {
     case 1:
       orc_x86_emit_mov_memoffset_reg (compiler, 1, offset, ptr_reg,
@@ -158,6 +212,14 @@ sse_rule_loadoffX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
   } else {
     ptr_reg = src->ptr_register;
   } 
+#ifndef MMX
+  if ((insn->flags & ORC_INSN_FLAG_TAP_WINDOW) &&
+      (src->size << compiler->loop_shift) == 16) {
+    sse_emit_tap (compiler, insn, ptr_reg);
+    src->update_type = 2;
+    return;
+  }
+#endif
   switch (src->size << compiler->loop_shift) {
     case 1:
       orc_x86_emit_mov_memoffset_reg (compiler, 1, offset, ptr_reg,
@@ -178,7 +240,7 @@ sse_rule_loadoffX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
       break;
     case 16:
       orc_x86_emit_mov_memoffset_sse (compiler, 16, offset, ptr_reg,
-          dest->alloc, src->is_aligned);
+          dest->alloc, src->is_aligned && (offset & 15) == 0);
       break;
     default:
       orc_compiler_error (compiler,"bad load size %d",
@@ -666,6 +728,101 @@ mmx_rule_ldreslinl (OrcCompiler *compiler, void *user, OrcInstruction *insn)
 }
 #endif
 
+#ifndef MMX
+/* Like ldreslinl, but each pixel also blends the pair one stride below,
+ * weighted by the fraction of the y half of the position.  Both rows
+ * are blended horizontally with one multiply, then vertically. */
+static void
+sse_rule_ldresbilinl (OrcCompiler *compiler, void *user, OrcInstruction *insn)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+  int pos_var = insn->src_args[1];
+  int increment_var = insn->src_args[2];
+  OrcVariable *dest = compiler->vars + insn->dest_args[0];
+  int tmp = orc_compiler_get_temp_reg (compiler);
+  int tmp2 = orc_compiler_get_temp_reg (compiler);
+  int xfrac = orc_compiler_get_temp_reg (compiler);
+  int yfrac = orc_compiler_get_temp_reg (compiler);
+  int zero = orc_compiler_get_constant (compiler, 1, 0);
+  int mask = orc_compiler_get_constant (compiler, 2, 0x00ff);
+  int regsize = compiler->is_64bit ? 8 : 4;
+  int i;
+
+  if (compiler->vars[pos_var].vartype == ORC_VAR_TYPE_PARAM) {
+    orc_x86_emit_mov_memoffset_sse (compiler, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor,
+          params[pos_var + (ORC_VAR_T1 - ORC_VAR_P1)]),
+        compiler->exec_reg, yfrac, FALSE);
+    orc_sse_emit_pshuflw (compiler, ORC_SSE_SHUF(0,0,0,0), yfrac, yfrac);
+    orc_sse_emit_pshufd (compiler, ORC_SSE_SHUF(0,0,0,0), yfrac, yfrac);
+    orc_sse_emit_psrlw_imm (compiler, 8, yfrac);
+  } else {
+    orc_sse_load_constant (compiler, yfrac, 2,
+        (compiler->vars[pos_var].value.i >> 40) & 0xff);
+  }
+
+  for(i=0;i<(1<<compiler->loop_shift);i++){
+    /* a0 a1 b0 b1, the pair in this row and in the next */
+    orc_x86_emit_mov_memoffset_sse (compiler, 8, 0,
+        src->ptr_register, tmp, FALSE);
+    orc_x86_emit_mov_memindex_sse (compiler, 8, 0,
+        src->ptr_register, src->stride_register, 0, tmp2, FALSE);
+    orc_sse_emit_punpckldq (compiler, tmp2, tmp);
+    orc_sse_emit_movdqa (compiler, tmp, tmp2);
+    orc_sse_emit_punpcklbw (compiler, zero, tmp);
+    orc_sse_emit_punpckhbw (compiler, zero, tmp2);
+    orc_sse_emit_psubw (compiler, tmp, tmp2);
+
+    orc_sse_emit_movd_load_register (compiler, src->ptr_offset, xfrac);
+    orc_sse_emit_pshuflw (compiler, ORC_SSE_SHUF(0,0,0,0), xfrac, xfrac);
+    orc_sse_emit_pshufd (compiler, ORC_SSE_SHUF(0,0,0,0), xfrac, xfrac);
+    orc_sse_emit_psrlw_imm (compiler, 8, xfrac);
+    orc_sse_emit_pmullw (compiler, xfrac, tmp2);
+    orc_sse_emit_psraw_imm (compiler, 8, tmp2);
+    orc_sse_emit_paddw (compiler, tmp, tmp2);
+    orc_sse_emit_pand (compiler, mask, tmp2);
+
+    /* tmp2 holds both rows blended, now blend them vertically */
+    orc_sse_emit_movdqa (compiler, tmp2, tmp);
+    orc_sse_emit_psrldq_imm (compiler, 8, tmp);
+    orc_sse_emit_pslldq_imm (compiler, 8, tmp2);
+    orc_sse_emit_psrldq_imm (compiler, 8, tmp2);
+    orc_sse_emit_psubw (compiler, tmp2, tmp);
+    orc_sse_emit_pmullw (compiler, yfrac, tmp);
+    orc_sse_emit_psraw_imm (compiler, 8, tmp);
+    orc_sse_emit_paddw (compiler, tmp2, tmp);
+    orc_sse_emit_pand (compiler, mask, tmp);
+    orc_sse_emit_packuswb (compiler, zero, tmp);
+
+    if (i == 0) {
+      orc_sse_emit_movdqa (compiler, tmp, dest->alloc);
+    } else {
+      orc_sse_emit_pslldq_imm (compiler, 4*i, tmp);
+      orc_sse_emit_por (compiler, tmp, dest->alloc);
+    }
+
+    if (compiler->vars[increment_var].vartype == ORC_VAR_TYPE_PARAM) {
+      orc_x86_emit_add_memoffset_reg (compiler, 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, params[increment_var]),
+          compiler->exec_reg, src->ptr_offset);
+    } else {
+      orc_x86_emit_add_imm_reg (compiler, 4,
+          compiler->vars[increment_var].value.i,
+          src->ptr_offset, FALSE);
+    }
+
+    orc_x86_emit_mov_reg_reg (compiler, 4, src->ptr_offset, compiler->gp_tmpreg);
+    orc_x86_emit_sar_imm_reg (compiler, 4, 16, compiler->gp_tmpreg);
+
+    orc_x86_emit_add_reg_reg_shift (compiler, regsize, compiler->gp_tmpreg,
+        src->ptr_register, 2);
+    orc_x86_emit_and_imm_reg (compiler, 4, 0xffff, src->ptr_offset);
+  }
+
+  src->update_type = 0;
+}
+#endif
+
 static void
 sse_rule_copyx (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -765,6 +922,8 @@ BINARY(subl,psubd,0xfa)
 /* BINARY(subssl,psubsd,0xe9) */
 /* BINARY(subusl,psubusd,0xd9) */
 BINARY(xorl,pxor,0xef)
+BINARY(maddswl,pmaddwd,0xf5)
+BINARY(maddusbw,pmaddubsw,0x3804)
 
 BINARY(andq,pand,0xdb)
 BINARY(andnq,pandn,0xdf)
@@ -840,6 +999,41 @@ sse_rule_accsadubl (OrcCompiler *p, void *user, OrcInstruction *insn)
   orc_sse_emit_paddd (p, tmp, dest);
 }
 
+#ifndef MMX
+/* Bytes of the active lanes that are nonzero end up set in gp_tmpreg,
+ * and a match jumps out of the loop to find_label, which turns the
+ * lowest set bit into an index. */
+static void
+sse_rule_findX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int size = p->vars[insn->src_args[0]].size;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int n_bytes = size << p->insn_shift;
+
+  orc_sse_emit_pxor (p, tmp, tmp);
+  if (size == 1) {
+    orc_sse_emit_pcmpeqb (p, src, tmp);
+  } else if (size == 2) {
+    orc_sse_emit_pcmpeqw (p, src, tmp);
+  } else {
+    orc_sse_emit_pcmpeqd (p, src, tmp);
+  }
+  orc_sse_emit_pmovmskb (p, tmp, p->gp_tmpreg);
+  if (n_bytes < 16) {
+    orc_x86_emit_cpuinsn_imm_reg (p, ORC_X86_xor_imm32_rm, 4,
+        (1<<n_bytes) - 1, p->gp_tmpreg);
+    orc_x86_emit_and_imm_reg (p, 4, (1<<n_bytes) - 1, p->gp_tmpreg);
+  } else {
+    orc_x86_emit_cpuinsn_imm_reg (p, ORC_X86_xor_imm32_rm, 4, 0xffff,
+        p->gp_tmpreg);
+  }
+  /* mov leaves the flags alone */
+  orc_x86_emit_mov_imm_reg (p, 4, p->offset, p->find_offset);
+  orc_x86_emit_jne (p, p->find_label);
+}
+#endif
+
 #ifndef MMX
 static void
 sse_rule_signX_ssse3 (OrcCompiler *p, void *user, OrcInstruction *insn)
@@ -1470,6 +1664,31 @@ sse_rule_mulhub (OrcCompiler *p, void *user, OrcInstruction *insn)
   orc_sse_emit_por (p, tmp2, dest);
 }
 
+static void
+sse_rule_maddusbw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int tmp2 = orc_compiler_get_temp_reg (p);
+
+  /* odd bytes, then even bytes; the products fit in 16 bits */
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_movdqa (p, dest, tmp2);
+  orc_sse_emit_psraw_imm (p, 8, tmp);
+  orc_sse_emit_psrlw_imm (p, 8, tmp2);
+  orc_sse_emit_pmullw (p, tmp, tmp2);
+
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_psllw_imm (p, 8, tmp);
+  orc_sse_emit_psraw_imm (p, 8, tmp);
+  orc_sse_emit_psllw_imm (p, 8, dest);
+  orc_sse_emit_psrlw_imm (p, 8, dest);
+  orc_sse_emit_pmullw (p, tmp, dest);
+
+  orc_sse_emit_paddsw (p, tmp2, dest);
+}
+
 static void
 sse_rule_mulswl (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
@@ -2060,660 +2279,2765 @@ sse_rule_select1wb_ssse3 (OrcCompiler *p, void *user, OrcInstruction *insn)
     sse_rule_select1wb (p, user, insn);
   }
 }
-#endif
 
-/* slow rules */
+/* Arrays of 3- and 4-channel elements are moved in chunks of 16, 8,
+ * 4, 2 and 1 bytes, so that nothing outside the array is touched, and
+ * pshufb gathers each channel from or scatters it into the chunks. */
 
-static void
-sse_rule_maxuw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+static int
+sse_chunk_size (int n_bytes)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp;
+  int len = 16;
 
-  tmp = orc_compiler_get_constant (p, 2, 0x8000);
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
-  orc_sse_emit_pmaxsw (p, src, dest);
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
+  while (len > n_bytes) len >>= 1;
+  return len;
 }
 
-static void
-sse_rule_minuw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+static int
+sse_get_shuffle (OrcCompiler *p, int c, const orc_uint8 *mask)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp;
+  OrcConstant constant;
+  int reg;
+  int i;
 
-  tmp = orc_compiler_get_constant (p, 2, 0x8000);
+  memset (&constant, 0, sizeof(constant));
+  for(i=0;i<4;i++){
+    constant.full_value[i] = mask[4*i] | (mask[4*i+1]<<8) |
+      (mask[4*i+2]<<16) | ((orc_uint32)mask[4*i+3]<<24);
+  }
+  constant.is_long = TRUE;
 
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
-  orc_sse_emit_pminsw (p, src, dest);
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
+  reg = orc_compiler_try_get_constant_long (p, constant.full_value[0],
+      constant.full_value[1], constant.full_value[2], constant.full_value[3]);
+  if (reg != ORC_REG_INVALID) return reg;
+
+  p->target->load_constant_long (p, c, &constant);
+  return c;
 }
 
-static void
-sse_rule_avgsb_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+static int
+sse_get_array_ptr (OrcCompiler *p, int var)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp;
-
-  tmp = orc_compiler_get_constant (p, 1, 0x80);
-
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
-  orc_sse_emit_pavgb (p, src, dest);
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
+  if (p->vars[var].ptr_register == 0) {
+    orc_x86_emit_mov_memoffset_reg (p, p->is_64bit ? 8 : 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[var]),
+        p->exec_reg, p->gp_tmpreg);
+    return p->gp_tmpreg;
+  }
+  return p->vars[var].ptr_register;
 }
 
+/* Stores the low len (1 or 2) bytes of src at offset from ptr_reg.
+ * These go through a general purpose register; when the array pointer
+ * itself had to be loaded into gp_tmpreg, eax is used instead and kept
+ * on the stack around the store.  eax is never exec_reg or gp_tmpreg. */
 static void
-sse_rule_avgsw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_store_small (OrcCompiler *p, int len, int src, int offset,
+    int ptr_reg)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp;
+  int ptr_size = p->is_64bit ? 8 : 4;
 
-  tmp = orc_compiler_get_constant (p, 2, 0x8000);
+  if (ptr_reg != p->gp_tmpreg) {
+    orc_sse_emit_movd_store_register (p, src, p->gp_tmpreg);
+    orc_x86_emit_mov_reg_memoffset (p, len, p->gp_tmpreg, offset, ptr_reg);
+    return;
+  }
 
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
-  orc_sse_emit_pavgw (p, src, dest);
-  orc_sse_emit_pxor(p, tmp, src);
-  orc_sse_emit_pxor(p, tmp, dest);
+  orc_x86_emit_push (p, ptr_size, X86_EAX);
+  orc_sse_emit_movd_store_register (p, src, X86_EAX);
+  orc_x86_emit_mov_reg_memoffset (p, len, X86_EAX, offset, ptr_reg);
+  orc_x86_emit_pop (p, ptr_size, X86_EAX);
 }
 
+/* Gathers the elements of size bytes at start, start + stride, ...
+ * from the span bytes of the array at the current position into dest. */
 static void
-sse_rule_maxsb_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_gather (OrcCompiler *p, int var, int dest, int size, int start,
+    int stride, int span)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
-
-  orc_sse_emit_movdqa (p, dest, tmp);
-  orc_sse_emit_pcmpgtb (p, src, tmp);
-  orc_sse_emit_pand (p, tmp, dest);
-  orc_sse_emit_pandn (p, src, tmp);
-  orc_sse_emit_por (p, tmp, dest);
+  int n_bytes = size << p->loop_shift;
+  int first = TRUE;
+  int offset;
+  int len;
+  int tmp, c;
+
+  tmp = orc_compiler_get_temp_reg (p);
+  c = orc_compiler_get_temp_reg (p);
+
+  for(offset=0;offset<span;offset+=len){
+    orc_uint8 mask[16];
+    int used = FALSE;
+    int ptr_reg;
+    int reg;
+    int i;
+
+    len = sse_chunk_size (span - offset);
+    for(i=0;i<16;i++){
+      int j = (i / size) * stride + start + i % size - offset;
+      if (i < n_bytes && j >= 0 && j < len) {
+        mask[i] = j;
+        used = TRUE;
+      } else {
+        mask[i] = 0x80;
+      }
+    }
+    if (!used) continue;
+
+    reg = first ? dest : tmp;
+    ptr_reg = sse_get_array_ptr (p, var);
+    i = p->offset * stride + offset;
+    switch (len) {
+      case 1:
+        orc_x86_emit_mov_memoffset_reg (p, 1, i, ptr_reg, p->gp_tmpreg);
+        orc_sse_emit_movd_load_register (p, p->gp_tmpreg, reg);
+        break;
+      case 2:
+        orc_sse_emit_pxor (p, reg, reg);
+        orc_sse_emit_pinsrw_memoffset (p, 0, i, ptr_reg, reg);
+        break;
+      default:
+        orc_x86_emit_mov_memoffset_sse (p, len, i, ptr_reg, reg, FALSE);
+        break;
+    }
+    orc_sse_emit_pshufb (p, sse_get_shuffle (p, c, mask), reg);
+    if (!first) {
+      orc_sse_emit_por (p, tmp, dest);
+    }
+    first = FALSE;
+  }
 }
 
 static void
-sse_rule_minsb_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_loadchX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
+  OrcVariable *src = p->vars + insn->src_args[0];
   int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
+  int size = p->vars[insn->dest_args[0]].size;
+  int n_channels = ORC_PTR_TO_INT(user);
+  int channel;
 
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_pcmpgtb (p, dest, tmp);
-  orc_sse_emit_pand (p, tmp, dest);
-  orc_sse_emit_pandn (p, src, tmp);
-  orc_sse_emit_por (p, tmp, dest);
-}
+  if (p->vars[insn->src_args[1]].vartype != ORC_VAR_TYPE_CONST) {
+    orc_compiler_error (p, "code generation rule for %s only works with constant channel",
+        insn->opcode->name);
+    return;
+  }
+  channel = p->vars[insn->src_args[1]].value.i;
+  if (channel < 0 || channel >= n_channels) {
+    orc_compiler_error (p, "channel %d out of range for %s", channel,
+        insn->opcode->name);
+    return;
+  }
 
-static void
-sse_rule_maxsl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
-{
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
+  sse_emit_gather (p, insn->src_args[0], dest, size, channel * size,
+      n_channels * size, n_channels * (size << p->loop_shift));
 
-  orc_sse_emit_movdqa (p, dest, tmp);
-  orc_sse_emit_pcmpgtd (p, src, tmp);
-  orc_sse_emit_pand (p, tmp, dest);
-  orc_sse_emit_pandn (p, src, tmp);
-  orc_sse_emit_por (p, tmp, dest);
+  src->update_type = 2;
 }
 
 static void
-sse_rule_minsl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_storechX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
+  OrcVariable *dest = p->vars + insn->dest_args[0];
+  int size = p->vars[insn->src_args[0]].size;
+  int n_channels = ORC_PTR_TO_INT(user);
+  int n_bytes = size << p->loop_shift;
+  int offset;
+  int len;
+  int acc, tmp, c;
+
+  acc = orc_compiler_get_temp_reg (p);
+  tmp = orc_compiler_get_temp_reg (p);
+  c = orc_compiler_get_temp_reg (p);
+
+  for(offset=0;offset<n_channels*n_bytes;offset+=len){
+    int first = TRUE;
+    int ptr_reg;
+    int k;
+
+    len = sse_chunk_size (n_channels*n_bytes - offset);
+    for(k=0;k<n_channels;k++){
+      orc_uint8 mask[16];
+      int used = FALSE;
+      int reg;
+      int i;
+
+      for(i=0;i<16;i++){
+        int j = offset + i;
+        if (i < len && (j / size) % n_channels == k) {
+          mask[i] = (j / (n_channels * size)) * size + j % size;
+          used = TRUE;
+        } else {
+          mask[i] = 0x80;
+        }
+      }
+      if (!used) continue;
 
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_pcmpgtd (p, dest, tmp);
-  orc_sse_emit_pand (p, tmp, dest);
-  orc_sse_emit_pandn (p, src, tmp);
-  orc_sse_emit_por (p, tmp, dest);
-}
+      reg = first ? acc : tmp;
+      orc_sse_emit_movdqa (p, p->vars[insn->src_args[k]].alloc, reg);
+      orc_sse_emit_pshufb (p, sse_get_shuffle (p, c, mask), reg);
+      if (!first) {
+        orc_sse_emit_por (p, tmp, acc);
+      }
+      first = FALSE;
+    }
 
-static void
-sse_rule_maxul_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
-{
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
-  int tmpc;
+    ptr_reg = sse_get_array_ptr (p, insn->dest_args[0]);
+    k = p->offset * dest->size + offset;
+    switch (len) {
+      case 1:
+      case 2:
+        if (len == 2 && p->target_flags & ORC_TARGET_SSE_SSE4_1) {
+          orc_sse_emit_pextrw_memoffset (p, 0, k, acc, ptr_reg);
+          break;
+        }
+        sse_emit_store_small (p, len, acc, k, ptr_reg);
+        break;
+      default:
+        orc_x86_emit_mov_sse_memoffset (p, len, acc, k, ptr_reg, FALSE,
+            dest->is_uncached);
+        break;
+    }
+  }
 
-  tmpc = orc_compiler_get_constant (p, 4, 0x80000000);
-  orc_sse_emit_pxor(p, tmpc, src);
-  orc_sse_emit_pxor(p, tmpc, dest);
+  dest->update_type = 2;
+}
 
-  orc_sse_emit_movdqa (p, dest, tmp);
-  orc_sse_emit_pcmpgtd (p, src, tmp);
-  orc_sse_emit_pand (p, tmp, dest);
-  orc_sse_emit_pandn (p, src, tmp);
-  orc_sse_emit_por (p, tmp, dest);
+/* Element-strided arrays are read and written one element at a time,
+ * except that SSSE3 gathers small strides with pshufb.  Stores never
+ * write the elements in between, which may belong to someone else. */
 
-  orc_sse_emit_pxor(p, tmpc, src);
-  orc_sse_emit_pxor(p, tmpc, dest);
+static int
+sse_get_element_stride (OrcCompiler *p, OrcInstruction *insn, int var)
+{
+  int stride;
+
+  if (p->vars[insn->src_args[1]].vartype != ORC_VAR_TYPE_CONST) {
+    orc_compiler_error (p, "code generation rule for %s only works with constant stride",
+        insn->opcode->name);
+    return 0;
+  }
+  stride = p->vars[insn->src_args[1]].value.i;
+  if (stride != MAX(1, p->vars[var].element_stride)) {
+    orc_compiler_error (p, "stride %d does not match element stride of %s",
+        stride, p->vars[var].name);
+    return 0;
+  }
+  return stride;
 }
 
 static void
-sse_rule_minul_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_loadstrX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
+  OrcVariable *src = p->vars + insn->src_args[0];
   int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
-  int tmpc;
+  int size = src->size;
+  int n = 1 << p->loop_shift;
+  int stride;
+  int tmp;
+  int k;
 
-  tmpc = orc_compiler_get_constant (p, 4, 0x80000000);
-  orc_sse_emit_pxor(p, tmpc, src);
-  orc_sse_emit_pxor(p, tmpc, dest);
+  stride = sse_get_element_stride (p, insn, insn->src_args[0]);
+  if (stride == 0) return;
+  if (stride == 1) {
+    sse_rule_loadX (p, user, insn);
+    return;
+  }
 
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_pcmpgtd (p, dest, tmp);
-  orc_sse_emit_pand (p, tmp, dest);
-  orc_sse_emit_pandn (p, src, tmp);
-  orc_sse_emit_por (p, tmp, dest);
+  if ((p->target_flags & ORC_TARGET_SSE_SSSE3) && n > 1 && stride <= 4 &&
+      size <= 4) {
+    sse_emit_gather (p, insn->src_args[0], dest, size, 0, stride * size,
+        (n - 1) * stride * size + size);
+    src->update_type = 2;
+    return;
+  }
 
-  orc_sse_emit_pxor(p, tmpc, src);
-  orc_sse_emit_pxor(p, tmpc, dest);
+  tmp = orc_compiler_get_temp_reg (p);
+  if (size == 2) {
+    orc_sse_emit_pxor (p, dest, dest);
+  }
+  for(k=n-1;k>=0;k--){
+    int offset = (p->offset + k) * stride * size;
+    int ptr_reg = sse_get_array_ptr (p, insn->src_args[0]);
+    int reg = (k == n - 1) ? dest : tmp;
+
+    switch (size) {
+      case 1:
+        orc_x86_emit_mov_memoffset_reg (p, 1, offset, ptr_reg, p->gp_tmpreg);
+        orc_sse_emit_movd_load_register (p, p->gp_tmpreg, reg);
+        break;
+      case 2:
+        orc_sse_emit_pinsrw_memoffset (p, k, offset, ptr_reg, dest);
+        continue;
+      default:
+        orc_x86_emit_mov_memoffset_sse (p, size, offset, ptr_reg, reg, FALSE);
+        break;
+    }
+    if (k < n - 1) {
+      orc_sse_emit_pslldq_imm (p, size, dest);
+      orc_sse_emit_por (p, tmp, dest);
+    }
+  }
+
+  src->update_type = 2;
 }
 
 static void
-sse_rule_avgsl (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_storestrX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
+  OrcVariable *dest = p->vars + insn->dest_args[0];
+  int src = p->vars[insn->src_args[0]].alloc;
+  int size = dest->size;
+  int n = 1 << p->loop_shift;
+  int stride;
+  int tmp;
+  int k;
 
-  /* (a+b+1) >> 1 = (a|b) - ((a^b)>>1) */
+  stride = sse_get_element_stride (p, insn, insn->dest_args[0]);
+  if (stride == 0) return;
+  if (stride == 1) {
+    sse_rule_storeX (p, user, insn);
+    return;
+  }
 
-  orc_sse_emit_movdqa (p, dest, tmp);
-  orc_sse_emit_pxor(p, src, tmp);
-  orc_sse_emit_psrad_imm(p, 1, tmp);
+  tmp = orc_compiler_get_temp_reg (p);
+  if (size == 1 || (size == 2 && !(p->target_flags & ORC_TARGET_SSE_SSE4_1))) {
+    orc_sse_emit_movdqa (p, src, tmp);
+  }
+  for(k=0;k<n;k++){
+    int offset = (p->offset + k) * stride * size;
+    int ptr_reg = sse_get_array_ptr (p, insn->dest_args[0]);
+
+    switch (size) {
+      case 1:
+      case 2:
+        if (size == 2 && p->target_flags & ORC_TARGET_SSE_SSE4_1) {
+          orc_sse_emit_pextrw_memoffset (p, k, offset, src, ptr_reg);
+          break;
+        }
+        sse_emit_store_small (p, size, tmp, offset, ptr_reg);
+        orc_sse_emit_psrldq_imm (p, size, tmp);
+        break;
+      case 4:
+      case 8:
+        if (k == 0) {
+          orc_x86_emit_mov_sse_memoffset (p, size, src, offset, ptr_reg,
+              FALSE, dest->is_uncached);
+          break;
+        }
+        orc_sse_emit_pshufd (p, (size == 4) ? k : 0xee, src, tmp);
+        orc_x86_emit_mov_sse_memoffset (p, size, tmp, offset, ptr_reg,
+            FALSE, dest->is_uncached);
+        break;
+      default:
+        ORC_ASSERT(0);
+        break;
+    }
+  }
 
-  orc_sse_emit_por(p, src, dest);
-  orc_sse_emit_psubd(p, tmp, dest);
+  dest->update_type = 2;
 }
 
+/* Transposed sources read one element from each of the next rows,
+ * stepping the pointer by the stride kept in the offset register, and
+ * merge them with punpckl in a tree, each level interleaving groups
+ * twice as large as the level below. */
 static void
-sse_rule_avgul (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_load_column (OrcCompiler *p, OrcVariable *src, int reg, int level,
+    const int *tmp)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
+  if (level == 0) {
+    switch (src->size) {
+      case 1:
+      case 2:
+        orc_x86_emit_mov_memoffset_reg (p, src->size, 0, src->ptr_register,
+            p->gp_tmpreg);
+        orc_sse_emit_movd_load_register (p, p->gp_tmpreg, reg);
+        break;
+      default:
+        orc_x86_emit_mov_memoffset_sse (p, src->size, 0, src->ptr_register,
+            reg, FALSE);
+        break;
+    }
+    orc_x86_emit_add_reg_reg (p, p->is_64bit ? 8 : 4, src->ptr_offset,
+        src->ptr_register);
+    return;
+  }
 
-  /* (a+b+1) >> 1 = (a|b) - ((a^b)>>1) */
+  sse_emit_load_column (p, src, reg, level - 1, tmp);
+  sse_emit_load_column (p, src, tmp[level - 1], level - 1, tmp);
+  switch (src->size << (level - 1)) {
+    case 1:
+      orc_sse_emit_punpcklbw (p, tmp[level - 1], reg);
+      break;
+    case 2:
+      orc_sse_emit_punpcklwd (p, tmp[level - 1], reg);
+      break;
+    case 4:
+      orc_sse_emit_punpckldq (p, tmp[level - 1], reg);
+      break;
+    default:
+      orc_sse_emit_punpcklqdq (p, tmp[level - 1], reg);
+      break;
+  }
+}
 
-  orc_sse_emit_movdqa (p, dest, tmp);
-  orc_sse_emit_pxor(p, src, tmp);
-  orc_sse_emit_psrld_imm(p, 1, tmp);
+#ifndef MMX
+/* Transposes the n vectors in reg[] as an n x n matrix of elements of
+ * the given size, with reg[n] as spare.  Each stage interleaves pairs
+ * of rows into elements twice as large, lows to the first half and
+ * highs to the second half, renaming registers instead of moving them.
+ * The stages leave column c in reg[c] with the bits of c reversed, so
+ * the registers are put back in column order at the end. */
+static void
+sse_emit_transpose (OrcCompiler *p, int *reg, int n, int size)
+{
+  int y[8];
+  int spare = reg[n];
+  int bits;
+  int i, j, c;
+
+  for(;size<16;size<<=1){
+    for(i=0;i<n/2;i++){
+      int a = reg[2*i];
+      int b = reg[2*i+1];
+
+      orc_sse_emit_movdqa (p, a, spare);
+      switch (size) {
+        case 1:
+          orc_sse_emit_punpcklbw (p, b, a);
+          orc_sse_emit_punpckhbw (p, b, spare);
+          break;
+        case 2:
+          orc_sse_emit_punpcklwd (p, b, a);
+          orc_sse_emit_punpckhwd (p, b, spare);
+          break;
+        case 4:
+          orc_sse_emit_punpckldq (p, b, a);
+          orc_sse_emit_punpckhdq (p, b, spare);
+          break;
+        default:
+          orc_sse_emit_punpcklqdq (p, b, a);
+          orc_sse_emit_punpckhqdq (p, b, spare);
+          break;
+      }
+      y[i] = a;
+      y[i + n/2] = spare;
+      spare = b;
+    }
+    memcpy (reg, y, n * sizeof(int));
+  }
 
-  orc_sse_emit_por(p, src, dest);
-  orc_sse_emit_psubd(p, tmp, dest);
+  for(bits=0;(1<<bits)<n;bits++);
+  for(c=0;c<n;c++){
+    for(i=0,j=0;i<bits;i++){
+      if (c & (1<<i)) j |= 1<<(bits-1-i);
+    }
+    y[c] = reg[j];
+  }
+  memcpy (reg, y, n * sizeof(int));
+  reg[n] = spare;
 }
 
+/* Loads the next rows of a transposed source as whole vectors and
+ * transposes them in the registers set aside by the loop, which keep
+ * the columns for the rows of the block that follow.  Bytes take two
+ * passes over 16 rows: row pairs are interleaved into words and
+ * transposed 8 x 8, first from the low halves for columns 0 to 7, then
+ * from the high halves, reloaded, for columns 8 to 15. */
 static void
-sse_rule_addssl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_load_block (OrcCompiler *p, int var)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp;
-#if 0
-  int tmp2 = orc_compiler_get_temp_reg (p);
-  int tmp3 = orc_compiler_get_temp_reg (p);
-
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_pand (p, dest, tmp);
+  OrcVariable *src = p->vars + var;
+  int *reg = p->transpose_regs;
+  int n = p->transpose_rows;
+  int i;
 
-  orc_sse_emit_movdqa (p, src, tmp2);
-  orc_sse_emit_pxor (p, dest, tmp2);
-  orc_sse_emit_psrad_imm (p, 1, tmp2);
-  orc_sse_emit_paddd (p, tmp2, tmp);
+  if (src->size == 1) {
+    int spare = reg[8];
 
-  orc_sse_emit_psrad (p, 30, tmp);
-  orc_sse_emit_pslld (p, 30, tmp);
-  orc_sse_emit_movdqa (p, tmp, tmp2);
-  orc_sse_emit_pslld_imm (p, 1, tmp2);
-  orc_sse_emit_movdqa (p, tmp, tmp3);
-  orc_sse_emit_pxor (p, tmp2, tmp3);
-  orc_sse_emit_psrad_imm (p, 31, tmp3);
+    if (p->transpose_row == 8) {
+      orc_x86_emit_mov_imm_reg (p, 4, 16, p->gp_tmpreg);
+      orc_x86_emit_imul_memoffset_reg (p, 4,
+          (int)ORC_STRUCT_OFFSET(OrcExecutor, params[var]), p->exec_reg,
+          p->gp_tmpreg);
+      orc_x86_emit_sub_reg_reg (p, p->is_64bit ? 8 : 4, p->gp_tmpreg,
+          src->ptr_register);
+    }
+    for(i=0;i<8;i++){
+      orc_x86_emit_mov_memoffset_sse (p, 16, 0, src->ptr_register, reg[i],
+          FALSE);
+      orc_x86_emit_add_reg_reg (p, p->is_64bit ? 8 : 4, src->ptr_offset,
+          src->ptr_register);
+      orc_x86_emit_mov_memoffset_sse (p, 16, 0, src->ptr_register, spare,
+          FALSE);
+      orc_x86_emit_add_reg_reg (p, p->is_64bit ? 8 : 4, src->ptr_offset,
+          src->ptr_register);
+      if (p->transpose_row == 0) {
+        orc_sse_emit_punpcklbw (p, spare, reg[i]);
+      } else {
+        orc_sse_emit_punpckhbw (p, spare, reg[i]);
+      }
+    }
+    sse_emit_transpose (p, reg, 8, 2);
+    return;
+  }
 
-  orc_sse_emit_psrad_imm (p, 31, tmp2);
-  tmp = orc_compiler_get_constant (p, 4, 0x80000000);
-  orc_sse_emit_pxor (p, tmp, tmp2); /*  clamped value */
-  orc_sse_emit_pand (p, tmp3, tmp2);
+  for(i=0;i<n;i++){
+    orc_x86_emit_mov_memoffset_sse (p, 16, 0, src->ptr_register, reg[i],
+        FALSE);
+    orc_x86_emit_add_reg_reg (p, p->is_64bit ? 8 : 4, src->ptr_offset,
+        src->ptr_register);
+  }
+  sse_emit_transpose (p, reg, n, src->size);
+}
+#endif
 
-  orc_sse_emit_paddd (p, src, dest);
-  orc_sse_emit_pandn (p, dest, tmp3); /*  tmp is mask: ~0 is for clamping */
-  orc_sse_emit_movdqa (p, tmp3, dest);
+static void
+sse_rule_loadtrX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  OrcVariable *src = p->vars + insn->src_args[0];
+  int tmp[4];
+  int i;
 
-  orc_sse_emit_por (p, tmp2, dest);
-#endif
+  if (src->ptr_register == 0 || src->ptr_offset == 0) {
+    orc_compiler_error (p, "unimplemented: %s on pointer stored in memory",
+        insn->opcode->name);
+    return;
+  }
 
-  int s = orc_compiler_get_temp_reg (p);
-  int t = orc_compiler_get_temp_reg (p);
+#ifndef MMX
+  if (p->transpose_rows > 0 && (src->size << p->loop_shift) == 16) {
+    int k = p->transpose_row & ((src->size == 1) ? 7 : p->transpose_rows - 1);
 
-  /*
-     From Tim Terriberry: (slightly faster than above)
+    if (k == 0) {
+      sse_emit_load_block (p, insn->src_args[0]);
+    }
+    orc_sse_emit_movdqa (p, p->transpose_regs[k],
+        p->vars[insn->dest_args[0]].alloc);
+    src->update_type = 0;
+    return;
+  }
+#endif
 
-     m=0xFFFFFFFF;
-     s=_a;
-     t=_a;
-     s^=_b;
-     _a+=_b;
-     t^=_a;
-     t^=m;
-     m>>=1;
-     s|=t;
-     t=_b;
-     s>>=31;
-     t>>=31;
-     _a&=s;
-     t^=m;
-     s=~s&t;
-     _a|=s; 
-  */
+  for(i=0;i<p->loop_shift;i++){
+    tmp[i] = orc_compiler_get_temp_reg (p);
+  }
+  sse_emit_load_column (p, src, p->vars[insn->dest_args[0]].alloc,
+      p->loop_shift, tmp);
 
-  orc_sse_emit_movdqa (p, dest, s);
-  orc_sse_emit_movdqa (p, dest, t);
-  orc_sse_emit_pxor (p, src, s);
-  orc_sse_emit_paddd (p, src, dest);
-  orc_sse_emit_pxor (p, dest, t);
-  tmp = orc_compiler_get_constant (p, 4, 0xffffffff);
-  orc_sse_emit_pxor (p, tmp, t);
-  orc_sse_emit_por (p, t, s);
-  orc_sse_emit_movdqa (p, src, t);
-  orc_sse_emit_psrad_imm (p, 31, s);
-  orc_sse_emit_psrad_imm (p, 31, t);
-  orc_sse_emit_pand (p, s, dest);
-  tmp = orc_compiler_get_constant (p, 4, 0x7fffffff);
-  orc_sse_emit_pxor (p, tmp, t);
-  orc_sse_emit_pandn (p, t, s);
-  orc_sse_emit_por (p, s, dest);
+  src->update_type = 0;
 }
 
+/* Running sums add the elements shifted up by 1, 2, 4, ... lanes, then
+ * the running value of the previous iterations, which is kept
+ * broadcast to all lanes of the hidden second dest.  Floats are summed
+ * one lane after the other instead, so that the rounding matches the
+ * emulation. */
 static void
-sse_rule_subssl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_scanaddX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
   int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp;
-  int tmp2 = orc_compiler_get_temp_reg (p);
-  int tmp3 = orc_compiler_get_temp_reg (p);
+  int carry = p->vars[insn->dest_args[1]].alloc;
+  int size = p->vars[insn->dest_args[0]].size;
+  int n = 1 << p->loop_shift;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int k;
 
-  tmp = orc_compiler_get_temp_constant (p, 4, 0xffffffff);
-  orc_sse_emit_pxor (p, src, tmp);
-  orc_sse_emit_movdqa (p, tmp, tmp2);
-  orc_sse_emit_por (p, dest, tmp);
+  if (insn->opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
+    int orig = orc_compiler_get_temp_reg (p);
 
-  orc_sse_emit_pxor (p, dest, tmp2);
-  orc_sse_emit_psrad_imm (p, 1, tmp2);
-  orc_sse_emit_psubd (p, tmp2, tmp);
+    orc_sse_emit_movdqa (p, carry, tmp);
+    orc_sse_emit_psrldq_imm (p, 12, tmp);
+    orc_sse_emit_addps (p, tmp, dest);
+    if (n > 1) {
+      orc_sse_emit_movdqa (p, dest, orig);
+    }
+    for(k=1;k<n;k++){
+      orc_sse_emit_movdqa (p, dest, tmp);
+      orc_sse_emit_pslldq_imm (p, 4, tmp);
+      orc_sse_emit_movdqa (p, orig, dest);
+      orc_sse_emit_addps (p, tmp, dest);
+    }
+  } else {
+    for(k=size;k<n*size;k<<=1){
+      orc_sse_emit_movdqa (p, dest, tmp);
+      orc_sse_emit_pslldq_imm (p, k, tmp);
+      if (size == 2) {
+        orc_sse_emit_paddw (p, tmp, dest);
+      } else {
+        orc_sse_emit_paddd (p, tmp, dest);
+      }
+    }
+    if (size == 2) {
+      orc_sse_emit_paddw (p, carry, dest);
+    } else {
+      orc_sse_emit_paddd (p, carry, dest);
+    }
+  }
 
-  orc_sse_emit_psrad_imm (p, 30, tmp);
-  orc_sse_emit_pslld_imm (p, 30, tmp);
-  orc_sse_emit_movdqa (p, tmp, tmp2);
-  orc_sse_emit_pslld_imm (p, 1, tmp2);
-  orc_sse_emit_movdqa (p, tmp, tmp3);
-  orc_sse_emit_pxor (p, tmp2, tmp3);
-  orc_sse_emit_psrad_imm (p, 31, tmp3); /*  tmp3 is mask: ~0 is for clamping */
+  /* broadcast the last lane */
+  k = n - 1;
+  if (size == 2) {
+    if (k < 4) {
+      orc_sse_emit_pshuflw (p, (k & 3) * 0x55, dest, carry);
+    } else {
+      orc_sse_emit_pshufhw (p, (k & 3) * 0x55, dest, carry);
+    }
+    orc_sse_emit_pshufd (p, (k >> 1) * 0x55, carry, carry);
+  } else {
+    orc_sse_emit_pshufd (p, k * 0x55, dest, carry);
+  }
+}
 
-  orc_sse_emit_psrad_imm (p, 31, tmp2);
-  tmp = orc_compiler_get_constant (p, 4, 0x80000000);
-  orc_sse_emit_pxor (p, tmp, tmp2); /*  clamped value */
-  orc_sse_emit_pand (p, tmp3, tmp2);
+/* The mask arrives in dest.  It is spread to whole elements and then
+ * used to combine the two sources with and/andn/or.  Either source may
+ * be the mask itself, so dest is only written at the end then. */
+static void
+sse_rule_selectX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int src1 = p->vars[insn->src_args[1]].alloc;
+  int src2 = p->vars[insn->src_args[2]].alloc;
+  int size = p->vars[insn->dest_args[0]].size;
+  int mask = dest;
+  int tmp;
 
-  orc_sse_emit_psubd (p, src, dest);
-  orc_sse_emit_pandn (p, dest, tmp3);
-  orc_sse_emit_movdqa (p, tmp3, dest);
+  if (src1 == dest || src2 == dest) {
+    mask = orc_compiler_get_temp_reg (p);
+  }
 
-  orc_sse_emit_por (p, tmp2, dest);
+  switch (size) {
+    case 1:
+      tmp = orc_compiler_get_temp_reg (p);
+      orc_sse_emit_pxor (p, tmp, tmp);
+      orc_sse_emit_pcmpgtb (p, dest, tmp);
+      mask = tmp;
+      break;
+    case 2:
+      if (mask != dest) orc_sse_emit_movdqa (p, dest, mask);
+      orc_sse_emit_psraw_imm (p, 15, mask);
+      break;
+    case 4:
+      if (mask != dest) orc_sse_emit_movdqa (p, dest, mask);
+      orc_sse_emit_psrad_imm (p, 31, mask);
+      break;
+    case 8:
+      tmp = orc_compiler_get_temp_reg (p);
+      orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,3,1,1), dest, tmp);
+      orc_sse_emit_psrad_imm (p, 31, tmp);
+      mask = tmp;
+      break;
+    default:
+      ORC_ASSERT(0);
+      break;
+  }
 
+  tmp = orc_compiler_get_temp_reg (p);
+  orc_sse_emit_movdqa (p, mask, tmp);
+  orc_sse_emit_pandn (p, src2, tmp);
+  orc_sse_emit_pand (p, src1, mask);
+  orc_sse_emit_por (p, tmp, mask);
+  if (mask != dest) {
+    orc_sse_emit_movdqa (p, mask, dest);
+  }
 }
 
+/* The blend instructions take the mask from xmm0, which is kept out of
+ * register allocation for programs that select. */
 static void
-sse_rule_addusl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_selectX_sse41 (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
   int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmp = orc_compiler_get_temp_reg (p);
-  int tmp2 = orc_compiler_get_temp_reg (p);
+  int src1 = p->vars[insn->src_args[1]].alloc;
+  int src2 = p->vars[insn->src_args[2]].alloc;
+  int size = p->vars[insn->dest_args[0]].size;
 
-#if 0
-  /* an alternate version.  slower. */
-  /* Compute the bit that gets carried from bit 0 to bit 1 */
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_pand (p, dest, tmp);
-  orc_sse_emit_pslld_imm (p, 31, tmp);
-  orc_sse_emit_psrld_imm (p, 31, tmp);
+  orc_sse_emit_movdqa (p, dest, X86_XMM0);
+  if (size == 2) {
+    orc_sse_emit_psraw_imm (p, 15, X86_XMM0);
+  }
+  if (src1 == dest) {
+    int tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p, src1, tmp);
+    src1 = tmp;
+  }
+  if (src2 != dest) {
+    orc_sse_emit_movdqa (p, src2, dest);
+  }
 
-  /* Add in (src>>1) */
-  orc_sse_emit_movdqa (p, src, tmp2);
-  orc_sse_emit_psrld_imm (p, 1, tmp2);
-  orc_sse_emit_paddd (p, tmp2, tmp);
+  switch (size) {
+    case 1:
+    case 2:
+      orc_sse_emit_pblendvb (p, src1, dest);
+      break;
+    case 4:
+      orc_sse_emit_blendvps (p, src1, dest);
+      break;
+    case 8:
+      orc_sse_emit_blendvpd (p, src1, dest);
+      break;
+    default:
+      ORC_ASSERT(0);
+      break;
+  }
+}
 
-  /* Add in (dest>>1) */
-  orc_sse_emit_movdqa (p, dest, tmp2);
-  orc_sse_emit_psrld_imm (p, 1, tmp2);
-  orc_sse_emit_paddd (p, tmp2, tmp);
+static int
+sse_get_constant_bytes (OrcCompiler *p, const orc_uint8 *bytes)
+{
+  orc_uint32 v[4];
+  int i;
 
-  /* turn overflow bit into mask */
-  orc_sse_emit_psrad_imm (p, 31, tmp);
+  for(i=0;i<4;i++){
+    v[i] = bytes[4*i] | (bytes[4*i+1]<<8) | (bytes[4*i+2]<<16) |
+      ((orc_uint32)bytes[4*i+3]<<24);
+  }
+  return orc_compiler_get_constant_long (p, v[0], v[1], v[2], v[3]);
+}
 
-  /* compute the sum, then or over the mask */
-  orc_sse_emit_paddd (p, src, dest);
-  orc_sse_emit_por (p, tmp, dest);
-#endif
+static int
+sse_get_field_width (OrcCompiler *p, OrcInstruction *insn, int lane_bits)
+{
+  int width;
 
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_pand (p, dest, tmp);
+  if (p->vars[insn->src_args[1]].vartype != ORC_VAR_TYPE_CONST) {
+    orc_compiler_error (p, "code generation rule for %s only works with constant width",
+        insn->opcode->name);
+    return 0;
+  }
+  width = p->vars[insn->src_args[1]].value.i;
+  if (width < 1 || width > lane_bits) {
+    orc_compiler_error (p, "width %d out of range for %s", width,
+        insn->opcode->name);
+    return 0;
+  }
+  return width;
+}
 
-  orc_sse_emit_movdqa (p, src, tmp2);
-  orc_sse_emit_pxor (p, dest, tmp2);
-  orc_sse_emit_psrld_imm (p, 1, tmp2);
-  orc_sse_emit_paddd (p, tmp2, tmp);
+/* Field k of an unpack goes to lane k, with the bytes of two adjacent
+ * byte lanes sharing one word window.  The window of a lane starts at
+ * *start in the 32-bit source, the field at bit *shift of the window. */
+static void
+sse_field_window (int k, int width, int lane_bits, int *start, int *shift)
+{
+  int first = (lane_bits == 8) ? (k & ~1) : k;
+
+  *start = first * width / 8;
+  *shift = k * width - 8 * (*start);
+}
+
+/* user is the number of lanes, 8 bytes or 4 words.  The fields of each
+ * lane are gathered into a word with pshufb and brought to the bottom
+ * by a multiply and a common right shift, as long as every field fits
+ * in its window.  Otherwise each field is shifted out of the
+ * zero-extended source on its own. */
+static void
+sse_rule_unpackX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int n_lanes = ORC_PTR_TO_INT(user);
+  int lane_bits = 64 / n_lanes;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int width;
+  int fits;
+  int start, shift;
+  int tmp, acc;
+  int i, k;
+
+  width = sse_get_field_width (p, insn, lane_bits);
+  if (width == 0) return;
+
+  fits = (p->target_flags & ORC_TARGET_SSE_SSSE3);
+  for(k=0;k<n_lanes && k*width<32;k++){
+    sse_field_window (k, width, lane_bits, &start, &shift);
+    if (shift + width > 16) fits = FALSE;
+  }
+
+  if (fits) {
+    orc_uint8 shuf[16];
+    orc_uint8 mul[2][16];
+
+    memset (mul, 0, sizeof(mul));
+    for(i=0;i<16;i++){
+      int e = i / 8;
+      int word = (i & 7) / 2;
+      int b;
+
+      k = (lane_bits == 8) ? 2 * word : word;
+      sse_field_window (k, width, lane_bits, &start, &shift);
+      b = start + (i & 1);
+      shuf[i] = (k * width < 32 && b < 4) ? 4 * e + b : 0x80;
+    }
+    for(k=0;k<n_lanes;k++){
+      int word = (lane_bits == 8) ? k / 2 : k;
+      int half = (lane_bits == 8) ? (k & 1) : 0;
+      int m = 0;
+
+      if (k*width < 32) {
+        sse_field_window (k, width, lane_bits, &start, &shift);
+        m = 1 << (16 - width - shift);
+      }
+      for(i=0;i<2;i++){
+        mul[half][8*i + 2*word] = m & 0xff;
+        mul[half][8*i + 2*word + 1] = m >> 8;
+      }
+    }
+
+    orc_sse_emit_pshufb (p, sse_get_constant_bytes (p, shuf), dest);
+    if (lane_bits == 8) {
+      tmp = orc_compiler_get_temp_reg (p);
+      orc_sse_emit_movdqa (p, dest, tmp);
+      orc_sse_emit_pmullw (p, sse_get_constant_bytes (p, mul[0]), tmp);
+      orc_sse_emit_psrlw_imm (p, 16 - width, tmp);
+      orc_sse_emit_pmullw (p, sse_get_constant_bytes (p, mul[1]), dest);
+      orc_sse_emit_psrlw_imm (p, 16 - width, dest);
+      orc_sse_emit_psllw_imm (p, 8, dest);
+      orc_sse_emit_por (p, tmp, dest);
+    } else {
+      orc_sse_emit_pmullw (p, sse_get_constant_bytes (p, mul[0]), dest);
+      if (width < 16) {
+        orc_sse_emit_psrlw_imm (p, 16 - width, dest);
+      }
+    }
+    return;
+  }
+
+  tmp = orc_compiler_get_temp_reg (p);
+  acc = orc_compiler_get_temp_reg (p);
+  orc_sse_emit_pxor (p, tmp, tmp);
+  orc_sse_emit_punpckldq (p, tmp, dest);
+  for(k=0;k<n_lanes && k*width<32;k++){
+    orc_sse_emit_movdqa (p, dest, tmp);
+    if (k > 0) {
+      orc_sse_emit_psrlq_imm (p, k * width, tmp);
+    }
+    orc_sse_emit_pand (p, orc_compiler_get_constant_long (p,
+          (1u << width) - 1, 0, (1u << width) - 1, 0), tmp);
+    if (k > 0) {
+      orc_sse_emit_psllq_imm (p, k * lane_bits, tmp);
+      orc_sse_emit_por (p, tmp, acc);
+    } else {
+      orc_sse_emit_movdqa (p, tmp, acc);
+    }
+  }
+  orc_sse_emit_movdqa (p, acc, dest);
+}
+
+/* Narrow fields are combined pairwise with pmaddubsw and pmaddwd, and
+ * the two halves of each element with a shift; wider fields are each
+ * masked and shifted into place. */
+static void
+sse_rule_packX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int n_lanes = ORC_PTR_TO_INT(user);
+  int lane_bits = 64 / n_lanes;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int width;
+  int tmp, acc;
+  int k;
+
+  width = sse_get_field_width (p, insn, lane_bits);
+  if (width == 0) return;
+
+  if ((lane_bits == 16 && width <= 14) || (lane_bits == 8 && width <= 6 &&
+        (p->target_flags & ORC_TARGET_SSE_SSSE3))) {
+    int pair_width = width;
+
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, lane_bits / 8,
+          (1 << width) - 1), dest);
+    if (lane_bits == 8) {
+      orc_sse_emit_pmaddubsw (p, orc_compiler_get_constant (p, 2,
+            1 | (1 << (width + 8))), dest);
+      pair_width = 2 * width;
+    }
+    orc_sse_emit_pmaddwd (p, orc_compiler_get_constant (p, 4,
+          1 | (1 << (pair_width + 16))), dest);
+    tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p, dest, tmp);
+    orc_sse_emit_psrlq_imm (p, 32, tmp);
+    orc_sse_emit_psllq_imm (p, 2 * pair_width, tmp);
+    orc_sse_emit_por (p, tmp, dest);
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,0,2,0), dest, dest);
+    return;
+  }
+
+  tmp = orc_compiler_get_temp_reg (p);
+  acc = orc_compiler_get_temp_reg (p);
+  for(k=0;k<n_lanes && k*width<32;k++){
+    orc_sse_emit_movdqa (p, dest, tmp);
+    if (k > 0) {
+      orc_sse_emit_psrlq_imm (p, k * lane_bits, tmp);
+    }
+    orc_sse_emit_pand (p, orc_compiler_get_constant_long (p,
+          (1u << width) - 1, 0, (1u << width) - 1, 0), tmp);
+    if (k > 0) {
+      orc_sse_emit_psllq_imm (p, k * width, tmp);
+      orc_sse_emit_por (p, tmp, acc);
+    } else {
+      orc_sse_emit_movdqa (p, tmp, acc);
+    }
+  }
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,0,2,0), acc, dest);
+}
+
+/* Counts the bits of each byte of reg, by looking up both nibbles
+ * with pshufb where available. */
+static void
+sse_emit_popcount_bytes (OrcCompiler *p, int reg)
+{
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  if (p->target_flags & ORC_TARGET_SSE_SSSE3) {
+    int lut = orc_compiler_get_constant_long (p, 0x02010100, 0x03020201,
+        0x03020201, 0x04030302);
+    int tmp2 = orc_compiler_get_temp_reg (p);
+
+    orc_sse_emit_movdqa (p, reg, tmp);
+    orc_sse_emit_psrlw_imm (p, 4, tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x0f), tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x0f), reg);
+    orc_sse_emit_movdqa (p, lut, tmp2);
+    orc_sse_emit_pshufb (p, reg, tmp2);
+    orc_sse_emit_movdqa (p, lut, reg);
+    orc_sse_emit_pshufb (p, tmp, reg);
+    orc_sse_emit_paddb (p, tmp2, reg);
+  } else {
+    orc_sse_emit_movdqa (p, reg, tmp);
+    orc_sse_emit_psrlw_imm (p, 1, tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x55), tmp);
+    orc_sse_emit_psubb (p, tmp, reg);
+    orc_sse_emit_movdqa (p, reg, tmp);
+    orc_sse_emit_psrlw_imm (p, 2, tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x33), tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x33), reg);
+    orc_sse_emit_paddb (p, tmp, reg);
+    orc_sse_emit_movdqa (p, reg, tmp);
+    orc_sse_emit_psrlw_imm (p, 4, tmp);
+    orc_sse_emit_paddb (p, tmp, reg);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x0f), reg);
+  }
+}
+
+static void
+sse_rule_popcntX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = p->vars[insn->dest_args[0]].size;
+
+  sse_emit_popcount_bytes (p, dest);
+  if (size == 1) return;
 
+  if (p->target_flags & ORC_TARGET_SSE_SSSE3) {
+    orc_sse_emit_pmaddubsw (p, orc_compiler_get_constant (p, 1, 1), dest);
+  } else {
+    int tmp = orc_compiler_get_temp_reg (p);
+
+    orc_sse_emit_movdqa (p, dest, tmp);
+    orc_sse_emit_psrlw_imm (p, 8, tmp);
+    orc_sse_emit_paddb (p, tmp, dest);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 2, 0x00ff), dest);
+  }
+  if (size == 4) {
+    orc_sse_emit_pmaddwd (p, orc_compiler_get_constant (p, 2, 1), dest);
+  }
+}
+
+/* Leading zeros of the dwords of reg, from the exponent of the value
+ * converted to float.  Clearing every bit that has a one directly above
+ * it keeps the leading one and clears the bit below it, so the value is
+ * less than 1.5 times its leading power of two.  The conversion may
+ * round, but never up to the next power of two, so the exponent still
+ * gives the position of the leading one.  Zero converts to a zero
+ * exponent and is patched to give zero_count, and lanes with the top
+ * bit set, which convert as negative, give 0. */
+static void
+sse_emit_clz_dwords (OrcCompiler *p, int reg, int tmp, int tmp2,
+    int zero_count)
+{
+  orc_sse_emit_movdqa (p, reg, tmp);
+  orc_sse_emit_psrld_imm (p, 1, tmp);
+  orc_sse_emit_pandn (p, reg, tmp);
+  orc_sse_emit_cvtdq2ps (p, tmp, reg);
+  orc_sse_emit_psrld_imm (p, 23, reg);
+  orc_sse_emit_pand (p, orc_compiler_get_constant (p, 4, 0xff), reg);
+  orc_sse_emit_pxor (p, tmp2, tmp2);
+  orc_sse_emit_pcmpeqd (p, tmp, tmp2);
+  orc_sse_emit_pand (p, orc_compiler_get_constant (p, 4, 158 - zero_count),
+      tmp2);
+  orc_sse_emit_por (p, tmp2, reg);
+  /* 158 - exponent, as the exponent is at most 158 */
+  orc_sse_emit_pxor (p, orc_compiler_get_constant (p, 4, 0xff), reg);
+  orc_sse_emit_psubd (p, orc_compiler_get_constant (p, 4, 255 - 158), reg);
   orc_sse_emit_psrad_imm (p, 31, tmp);
-  orc_sse_emit_paddd (p, src, dest);
-  orc_sse_emit_por (p, tmp, dest);
+  orc_sse_emit_pandn (p, reg, tmp);
+  orc_sse_emit_movdqa (p, tmp, reg);
 }
 
+/* Words are counted as the top halves of dwords, one half at a time. */
 static void
-sse_rule_subusl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_clzX (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[1]].alloc;
   int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = p->vars[insn->dest_args[0]].size;
   int tmp = orc_compiler_get_temp_reg (p);
   int tmp2 = orc_compiler_get_temp_reg (p);
 
-  orc_sse_emit_movdqa (p, src, tmp2);
-  orc_sse_emit_psrld_imm (p, 1, tmp2);
+  if (size == 4) {
+    sse_emit_clz_dwords (p, dest, tmp, tmp2, 32);
+  } else {
+    int lo = orc_compiler_get_temp_reg (p);
+
+    orc_sse_emit_movdqa (p, dest, lo);
+    orc_sse_emit_pslld_imm (p, 16, lo);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 4, 0xffff0000),
+        dest);
+    sse_emit_clz_dwords (p, lo, tmp, tmp2, 16);
+    sse_emit_clz_dwords (p, dest, tmp, tmp2, 16);
+    orc_sse_emit_pslld_imm (p, 16, dest);
+    orc_sse_emit_por (p, lo, dest);
+  }
+}
 
-  orc_sse_emit_movdqa (p, dest, tmp);
-  orc_sse_emit_psrld_imm (p, 1, tmp);
-  orc_sse_emit_psubd (p, tmp, tmp2);
+/* Swaps the nibbles through two pshufb tables where available,
+ * otherwise swaps nibbles, bit pairs and bits with masks. */
+static void
+sse_rule_bitrevb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int i;
 
-  /* turn overflow bit into mask */
-  orc_sse_emit_psrad_imm (p, 31, tmp2);
+  if (p->target_flags & ORC_TARGET_SSE_SSSE3) {
+    /* the reversed nibble, and the reversed nibble moved up */
+    int lut_lo = orc_compiler_get_constant_long (p, 0x0c040800, 0x0e060a02,
+        0x0d050901, 0x0f070b03);
+    int lut_hi = orc_compiler_get_constant_long (p, 0xc0408000, 0xe060a020,
+        0xd0509010, 0xf070b030);
+    int tmp2 = orc_compiler_get_temp_reg (p);
+
+    orc_sse_emit_movdqa (p, dest, tmp);
+    orc_sse_emit_psrlw_imm (p, 4, tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x0f), tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, 0x0f), dest);
+    orc_sse_emit_movdqa (p, lut_hi, tmp2);
+    orc_sse_emit_pshufb (p, dest, tmp2);
+    orc_sse_emit_movdqa (p, lut_lo, dest);
+    orc_sse_emit_pshufb (p, tmp, dest);
+    orc_sse_emit_por (p, tmp2, dest);
+    return;
+  }
 
-  /* compute the difference, then and over the mask */
-  orc_sse_emit_psubd (p, src, dest);
-  orc_sse_emit_pand (p, tmp2, dest);
+  for(i=4;i>0;i>>=1){
+    static const int masks[] = { 0, 0x55, 0x33, 0, 0x0f };
 
+    orc_sse_emit_movdqa (p, dest, tmp);
+    orc_sse_emit_psrlw_imm (p, i, tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, masks[i]), tmp);
+    orc_sse_emit_pand (p, orc_compiler_get_constant (p, 1, masks[i]), dest);
+    orc_sse_emit_psllw_imm (p, i, dest);
+    orc_sse_emit_por (p, tmp, dest);
+  }
 }
 
-#ifndef MMX
-/* float ops */
+/* One pshufb with the permutation repeated for each element.  Without
+ * SSSE3, the bytes that move by the same distance are shifted together
+ * within the element and masked. */
+static void
+sse_rule_shuffleX (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = p->vars[insn->dest_args[0]].size;
+  orc_uint8 bytes[16];
+  int perm;
+  int tmp, acc;
+  int first;
+  int d, i;
+
+  if (p->vars[insn->src_args[1]].vartype != ORC_VAR_TYPE_CONST) {
+    orc_compiler_error (p, "code generation rule for %s only works with constant permutation",
+        insn->opcode->name);
+    return;
+  }
+  perm = p->vars[insn->src_args[1]].value.i;
 
-#define UNARY_F(opcode,insn_name,code) \
-static void \
-sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
-{ \
-  orc_sse_emit_ ## insn_name (p, \
-      p->vars[insn->src_args[0]].alloc, \
-      p->vars[insn->dest_args[0]].alloc); \
+  if (p->target_flags & ORC_TARGET_SSE_SSSE3) {
+    for(i=0;i<16;i++){
+      int j = (perm >> (4 * (i % size))) & 0xf;
+
+      bytes[i] = (j < size) ? (i / size) * size + j : 0x80;
+    }
+    orc_sse_emit_pshufb (p, sse_get_constant_bytes (p, bytes), dest);
+    return;
+  }
+
+  tmp = orc_compiler_get_temp_reg (p);
+  acc = orc_compiler_get_temp_reg (p);
+  first = TRUE;
+  for(d=1-size;d<size;d++){
+    int used = FALSE;
+
+    for(i=0;i<16;i++){
+      int j = (perm >> (4 * (i % size))) & 0xf;
+
+      bytes[i] = (j < size && i % size - j == d) ? 0xff : 0;
+      if (bytes[i]) used = TRUE;
+    }
+    if (!used) continue;
+
+    orc_sse_emit_movdqa (p, dest, tmp);
+    if (d > 0) {
+      if (size == 4) orc_sse_emit_pslld_imm (p, 8 * d, tmp);
+      else orc_sse_emit_psllq_imm (p, 8 * d, tmp);
+    } else if (d < 0) {
+      if (size == 4) orc_sse_emit_psrld_imm (p, -8 * d, tmp);
+      else orc_sse_emit_psrlq_imm (p, -8 * d, tmp);
+    }
+    orc_sse_emit_pand (p, sse_get_constant_bytes (p, bytes), tmp);
+    if (first) {
+      orc_sse_emit_movdqa (p, tmp, acc);
+    } else {
+      orc_sse_emit_por (p, tmp, acc);
+    }
+    first = FALSE;
+  }
+  if (first) {
+    orc_sse_emit_pxor (p, dest, dest);
+  } else {
+    orc_sse_emit_movdqa (p, acc, dest);
+  }
 }
+#endif
 
-#define BINARY_F(opcode,insn_name,code) \
-static void \
-sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
-{ \
-  orc_sse_emit_ ## insn_name (p, \
-      p->vars[insn->src_args[1]].alloc, \
-      p->vars[insn->dest_args[0]].alloc); \
+/* slow rules */
+
+static void
+sse_rule_maxuw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
+
+  tmp = orc_compiler_get_constant (p, 2, 0x8000);
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+  orc_sse_emit_pmaxsw (p, src, dest);
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
 }
 
-BINARY_F(addf, addps, 0x58)
-BINARY_F(subf, subps, 0x5c)
-BINARY_F(mulf, mulps, 0x59)
-BINARY_F(divf, divps, 0x5e)
-UNARY_F(sqrtf, sqrtps, 0x51)
+static void
+sse_rule_minuw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
 
-#define UNARY_D(opcode,insn_name,code) \
-static void \
-sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
-{ \
-  orc_sse_emit_ ## insn_name (p, \
-      p->vars[insn->src_args[0]].alloc, \
-      p->vars[insn->dest_args[0]].alloc); \
+  tmp = orc_compiler_get_constant (p, 2, 0x8000);
+
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+  orc_sse_emit_pminsw (p, src, dest);
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+}
+
+static void
+sse_rule_avgsb_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
+
+  tmp = orc_compiler_get_constant (p, 1, 0x80);
+
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+  orc_sse_emit_pavgb (p, src, dest);
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+}
+
+static void
+sse_rule_avgsw_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
+
+  tmp = orc_compiler_get_constant (p, 2, 0x8000);
+
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+  orc_sse_emit_pavgw (p, src, dest);
+  orc_sse_emit_pxor(p, tmp, src);
+  orc_sse_emit_pxor(p, tmp, dest);
+}
+
+static void
+sse_rule_maxsb_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_pcmpgtb (p, src, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, src, tmp);
+  orc_sse_emit_por (p, tmp, dest);
+}
+
+static void
+sse_rule_minsb_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_pcmpgtb (p, dest, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, src, tmp);
+  orc_sse_emit_por (p, tmp, dest);
+}
+
+static void
+sse_rule_maxsl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_pcmpgtd (p, src, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, src, tmp);
+  orc_sse_emit_por (p, tmp, dest);
+}
+
+static void
+sse_rule_minsl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_pcmpgtd (p, dest, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, src, tmp);
+  orc_sse_emit_por (p, tmp, dest);
+}
+
+static void
+sse_rule_maxul_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int tmpc;
+
+  tmpc = orc_compiler_get_constant (p, 4, 0x80000000);
+  orc_sse_emit_pxor(p, tmpc, src);
+  orc_sse_emit_pxor(p, tmpc, dest);
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_pcmpgtd (p, src, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, src, tmp);
+  orc_sse_emit_por (p, tmp, dest);
+
+  orc_sse_emit_pxor(p, tmpc, src);
+  orc_sse_emit_pxor(p, tmpc, dest);
+}
+
+static void
+sse_rule_minul_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int tmpc;
+
+  tmpc = orc_compiler_get_constant (p, 4, 0x80000000);
+  orc_sse_emit_pxor(p, tmpc, src);
+  orc_sse_emit_pxor(p, tmpc, dest);
+
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_pcmpgtd (p, dest, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, src, tmp);
+  orc_sse_emit_por (p, tmp, dest);
+
+  orc_sse_emit_pxor(p, tmpc, src);
+  orc_sse_emit_pxor(p, tmpc, dest);
+}
+
+static void
+sse_rule_avgsl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  /* (a+b+1) >> 1 = (a|b) - ((a^b)>>1) */
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_pxor(p, src, tmp);
+  orc_sse_emit_psrad_imm(p, 1, tmp);
+
+  orc_sse_emit_por(p, src, dest);
+  orc_sse_emit_psubd(p, tmp, dest);
+}
+
+static void
+sse_rule_avgul (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  /* (a+b+1) >> 1 = (a|b) - ((a^b)>>1) */
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_pxor(p, src, tmp);
+  orc_sse_emit_psrld_imm(p, 1, tmp);
+
+  orc_sse_emit_por(p, src, dest);
+  orc_sse_emit_psubd(p, tmp, dest);
+}
+
+static void
+sse_rule_addssl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
+#if 0
+  int tmp2 = orc_compiler_get_temp_reg (p);
+  int tmp3 = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_pand (p, dest, tmp);
+
+  orc_sse_emit_movdqa (p, src, tmp2);
+  orc_sse_emit_pxor (p, dest, tmp2);
+  orc_sse_emit_psrad_imm (p, 1, tmp2);
+  orc_sse_emit_paddd (p, tmp2, tmp);
+
+  orc_sse_emit_psrad (p, 30, tmp);
+  orc_sse_emit_pslld (p, 30, tmp);
+  orc_sse_emit_movdqa (p, tmp, tmp2);
+  orc_sse_emit_pslld_imm (p, 1, tmp2);
+  orc_sse_emit_movdqa (p, tmp, tmp3);
+  orc_sse_emit_pxor (p, tmp2, tmp3);
+  orc_sse_emit_psrad_imm (p, 31, tmp3);
+
+  orc_sse_emit_psrad_imm (p, 31, tmp2);
+  tmp = orc_compiler_get_constant (p, 4, 0x80000000);
+  orc_sse_emit_pxor (p, tmp, tmp2); /*  clamped value */
+  orc_sse_emit_pand (p, tmp3, tmp2);
+
+  orc_sse_emit_paddd (p, src, dest);
+  orc_sse_emit_pandn (p, dest, tmp3); /*  tmp is mask: ~0 is for clamping */
+  orc_sse_emit_movdqa (p, tmp3, dest);
+
+  orc_sse_emit_por (p, tmp2, dest);
+#endif
+
+  int s = orc_compiler_get_temp_reg (p);
+  int t = orc_compiler_get_temp_reg (p);
+
+  /*
+     From Tim Terriberry: (slightly faster than above)
+
+     m=0xFFFFFFFF;
+     s=_a;
+     t=_a;
+     s^=_b;
+     _a+=_b;
+     t^=_a;
+     t^=m;
+     m>>=1;
+     s|=t;
+     t=_b;
+     s>>=31;
+     t>>=31;
+     _a&=s;
+     t^=m;
+     s=~s&t;
+     _a|=s; 
+  */
+
+  orc_sse_emit_movdqa (p, dest, s);
+  orc_sse_emit_movdqa (p, dest, t);
+  orc_sse_emit_pxor (p, src, s);
+  orc_sse_emit_paddd (p, src, dest);
+  orc_sse_emit_pxor (p, dest, t);
+  tmp = orc_compiler_get_constant (p, 4, 0xffffffff);
+  orc_sse_emit_pxor (p, tmp, t);
+  orc_sse_emit_por (p, t, s);
+  orc_sse_emit_movdqa (p, src, t);
+  orc_sse_emit_psrad_imm (p, 31, s);
+  orc_sse_emit_psrad_imm (p, 31, t);
+  orc_sse_emit_pand (p, s, dest);
+  tmp = orc_compiler_get_constant (p, 4, 0x7fffffff);
+  orc_sse_emit_pxor (p, tmp, t);
+  orc_sse_emit_pandn (p, t, s);
+  orc_sse_emit_por (p, s, dest);
+}
+
+static void
+sse_rule_subssl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
+  int tmp2 = orc_compiler_get_temp_reg (p);
+  int tmp3 = orc_compiler_get_temp_reg (p);
+
+  tmp = orc_compiler_get_temp_constant (p, 4, 0xffffffff);
+  orc_sse_emit_pxor (p, src, tmp);
+  orc_sse_emit_movdqa (p, tmp, tmp2);
+  orc_sse_emit_por (p, dest, tmp);
+
+  orc_sse_emit_pxor (p, dest, tmp2);
+  orc_sse_emit_psrad_imm (p, 1, tmp2);
+  orc_sse_emit_psubd (p, tmp2, tmp);
+
+  orc_sse_emit_psrad_imm (p, 30, tmp);
+  orc_sse_emit_pslld_imm (p, 30, tmp);
+  orc_sse_emit_movdqa (p, tmp, tmp2);
+  orc_sse_emit_pslld_imm (p, 1, tmp2);
+  orc_sse_emit_movdqa (p, tmp, tmp3);
+  orc_sse_emit_pxor (p, tmp2, tmp3);
+  orc_sse_emit_psrad_imm (p, 31, tmp3); /*  tmp3 is mask: ~0 is for clamping */
+
+  orc_sse_emit_psrad_imm (p, 31, tmp2);
+  tmp = orc_compiler_get_constant (p, 4, 0x80000000);
+  orc_sse_emit_pxor (p, tmp, tmp2); /*  clamped value */
+  orc_sse_emit_pand (p, tmp3, tmp2);
+
+  orc_sse_emit_psubd (p, src, dest);
+  orc_sse_emit_pandn (p, dest, tmp3);
+  orc_sse_emit_movdqa (p, tmp3, dest);
+
+  orc_sse_emit_por (p, tmp2, dest);
+
+}
+
+static void
+sse_rule_addusl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int tmp2 = orc_compiler_get_temp_reg (p);
+
+#if 0
+  /* an alternate version.  slower. */
+  /* Compute the bit that gets carried from bit 0 to bit 1 */
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_pand (p, dest, tmp);
+  orc_sse_emit_pslld_imm (p, 31, tmp);
+  orc_sse_emit_psrld_imm (p, 31, tmp);
+
+  /* Add in (src>>1) */
+  orc_sse_emit_movdqa (p, src, tmp2);
+  orc_sse_emit_psrld_imm (p, 1, tmp2);
+  orc_sse_emit_paddd (p, tmp2, tmp);
+
+  /* Add in (dest>>1) */
+  orc_sse_emit_movdqa (p, dest, tmp2);
+  orc_sse_emit_psrld_imm (p, 1, tmp2);
+  orc_sse_emit_paddd (p, tmp2, tmp);
+
+  /* turn overflow bit into mask */
+  orc_sse_emit_psrad_imm (p, 31, tmp);
+
+  /* compute the sum, then or over the mask */
+  orc_sse_emit_paddd (p, src, dest);
+  orc_sse_emit_por (p, tmp, dest);
+#endif
+
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_pand (p, dest, tmp);
+
+  orc_sse_emit_movdqa (p, src, tmp2);
+  orc_sse_emit_pxor (p, dest, tmp2);
+  orc_sse_emit_psrld_imm (p, 1, tmp2);
+  orc_sse_emit_paddd (p, tmp2, tmp);
+
+  orc_sse_emit_psrad_imm (p, 31, tmp);
+  orc_sse_emit_paddd (p, src, dest);
+  orc_sse_emit_por (p, tmp, dest);
+}
+
+static void
+sse_rule_subusl_slow (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int tmp2 = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_movdqa (p, src, tmp2);
+  orc_sse_emit_psrld_imm (p, 1, tmp2);
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_psrld_imm (p, 1, tmp);
+  orc_sse_emit_psubd (p, tmp, tmp2);
+
+  /* turn overflow bit into mask */
+  orc_sse_emit_psrad_imm (p, 31, tmp2);
+
+  /* compute the difference, then and over the mask */
+  orc_sse_emit_psubd (p, src, dest);
+  orc_sse_emit_pand (p, tmp2, dest);
+
+}
+
+#ifndef MMX
+/* float ops */
+
+#define UNARY_F(opcode,insn_name,code) \
+static void \
+sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  orc_sse_emit_ ## insn_name (p, \
+      p->vars[insn->src_args[0]].alloc, \
+      p->vars[insn->dest_args[0]].alloc); \
+}
+
+#define BINARY_F(opcode,insn_name,code) \
+static void \
+sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  orc_sse_emit_ ## insn_name (p, \
+      p->vars[insn->src_args[1]].alloc, \
+      p->vars[insn->dest_args[0]].alloc); \
+}
+
+BINARY_F(addf, addps, 0x58)
+BINARY_F(subf, subps, 0x5c)
+BINARY_F(mulf, mulps, 0x59)
+BINARY_F(divf, divps, 0x5e)
+UNARY_F(sqrtf, sqrtps, 0x51)
+
+#define UNARY_D(opcode,insn_name,code) \
+static void \
+sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  orc_sse_emit_ ## insn_name (p, \
+      p->vars[insn->src_args[0]].alloc, \
+      p->vars[insn->dest_args[0]].alloc); \
+}
+
+#define BINARY_D(opcode,insn_name,code) \
+static void \
+sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  orc_sse_emit_ ## insn_name (p, \
+      p->vars[insn->src_args[1]].alloc, \
+      p->vars[insn->dest_args[0]].alloc); \
+}
+
+BINARY_D(addd, addpd, 0x58)
+BINARY_D(subd, subpd, 0x5c)
+BINARY_D(muld, mulpd, 0x59)
+BINARY_D(divd, divpd, 0x5e)
+UNARY_D(sqrtd, sqrtpd, 0x51)
+
+static void
+sse_rule_minf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_FAST_NAN) {
+    orc_sse_emit_minps (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    int tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p,
+        p->vars[insn->src_args[1]].alloc,
+        tmp);
+    orc_sse_emit_minps (p,
+        p->vars[insn->dest_args[0]].alloc,
+        tmp);
+    orc_sse_emit_minps (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+    orc_sse_emit_por (p,
+        tmp,
+        p->vars[insn->dest_args[0]].alloc);
+  }
+}
+
+static void
+sse_rule_mind (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_FAST_NAN) {
+    orc_sse_emit_minpd (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    int tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p,
+        p->vars[insn->src_args[1]].alloc,
+        tmp);
+    orc_sse_emit_minpd (p,
+        p->vars[insn->dest_args[0]].alloc,
+        tmp);
+    orc_sse_emit_minpd (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+    orc_sse_emit_por (p,
+        tmp,
+        p->vars[insn->dest_args[0]].alloc);
+  }
+}
+
+static void
+sse_rule_maxf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_FAST_NAN) {
+    orc_sse_emit_maxps (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    int tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p,
+        p->vars[insn->src_args[1]].alloc,
+        tmp);
+    orc_sse_emit_maxps (p,
+        p->vars[insn->dest_args[0]].alloc,
+        tmp);
+    orc_sse_emit_maxps (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+    orc_sse_emit_por (p,
+        tmp,
+        p->vars[insn->dest_args[0]].alloc);
+  }
+}
+
+static void
+sse_rule_maxd (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_FAST_NAN) {
+    orc_sse_emit_maxpd (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    int tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p,
+        p->vars[insn->src_args[1]].alloc,
+        tmp);
+    orc_sse_emit_maxpd (p,
+        p->vars[insn->dest_args[0]].alloc,
+        tmp);
+    orc_sse_emit_maxpd (p,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+    orc_sse_emit_por (p,
+        tmp,
+        p->vars[insn->dest_args[0]].alloc);
+  }
+}
+
+static void
+sse_rule_cmpeqf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cmpeqps (p,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_cmpeqd (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cmpeqpd (p,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+
+static void
+sse_rule_cmpltf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cmpltps (p,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_cmpltd (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cmpltpd (p,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+
+static void
+sse_rule_cmplef (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cmpleps (p,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_cmpled (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cmplepd (p,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+
+static void
+sse_rule_convfl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmpc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  
+  tmpc = orc_compiler_get_temp_constant (p, 4, 0x80000000);
+  orc_sse_emit_movdqa (p, src, tmp);
+  orc_sse_emit_cvttps2dq (p, src, dest);
+  orc_sse_emit_psrad_imm (p, 31, tmp);
+  orc_sse_emit_pcmpeqd (p, dest, tmpc);
+  orc_sse_emit_pandn (p, tmpc, tmp);
+  orc_sse_emit_paddd (p, tmp, dest);
+
+}
+
+static void
+sse_rule_convdl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmpc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  
+  tmpc = orc_compiler_get_temp_constant (p, 4, 0x80000000);
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,1,3,1), src, tmp);
+  orc_sse_emit_cvttpd2dq (p, src, dest);
+  orc_sse_emit_psrad_imm (p, 31, tmp);
+  orc_sse_emit_pcmpeqd (p, dest, tmpc);
+  orc_sse_emit_pandn (p, tmpc, tmp);
+  orc_sse_emit_paddd (p, tmp, dest);
+}
+
+static void
+sse_rule_convlf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cvtdq2ps (p,
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_convld (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cvtdq2pd (p,
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_convfd (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cvtps2pd (p,
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_convdf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_cvtpd2ps (p,
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+#define SSE_FMA_ADD 0
+#define SSE_FMA_SUB 1
+#define SSE_FMA_NEG 2
+
+/* Without FMA3, two floats are computed at a time in double precision.
+ * The product of two floats is exact in a double, so the only
+ * difference from a fused result is the double rounding at the end. */
+static void
+sse_emit_fmaf_half (OrcCompiler *p, OrcInstruction *insn, int half,
+    int mode, int dest, int tmp)
+{
+  int i;
+
+  for(i=0;i<3;i++){
+    int src = p->vars[insn->src_args[i]].alloc;
+    int reg = (i == 0) ? dest : tmp;
+
+    if (half) {
+      orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,2,3,2), src, reg);
+      orc_sse_emit_cvtps2pd (p, reg, reg);
+    } else {
+      orc_sse_emit_cvtps2pd (p, src, reg);
+    }
+    if (i == 1) {
+      orc_sse_emit_mulpd (p, tmp, dest);
+    }
+  }
+
+  switch (mode) {
+    case SSE_FMA_ADD:
+      orc_sse_emit_addpd (p, tmp, dest);
+      break;
+    case SSE_FMA_SUB:
+      orc_sse_emit_subpd (p, tmp, dest);
+      break;
+    case SSE_FMA_NEG:
+      orc_sse_emit_subpd (p, dest, tmp);
+      orc_sse_emit_movdqa (p, tmp, dest);
+      break;
+  }
+  orc_sse_emit_cvtpd2ps (p, dest, dest);
+}
+
+static void
+sse_emit_fmaf_slow (OrcCompiler *p, OrcInstruction *insn, int mode)
+{
+  int lo = orc_compiler_get_temp_reg (p);
+  int hi = orc_compiler_get_temp_reg (p);
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  sse_emit_fmaf_half (p, insn, 0, mode, lo, tmp);
+  sse_emit_fmaf_half (p, insn, 1, mode, hi, tmp);
+  orc_sse_emit_punpcklqdq (p, hi, lo);
+  orc_sse_emit_movdqa (p, lo, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+sse_rule_fmaf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_SSE_FMA) {
+    orc_sse_emit_vfmadd213ps (p,
+        p->vars[insn->src_args[2]].alloc,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    sse_emit_fmaf_slow (p, insn, SSE_FMA_ADD);
+  }
+}
+
+static void
+sse_rule_fmsf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_SSE_FMA) {
+    orc_sse_emit_vfmsub213ps (p,
+        p->vars[insn->src_args[2]].alloc,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    sse_emit_fmaf_slow (p, insn, SSE_FMA_SUB);
+  }
+}
+
+static void
+sse_rule_fnmaf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->target_flags & ORC_TARGET_SSE_FMA) {
+    orc_sse_emit_vfnmadd213ps (p,
+        p->vars[insn->src_args[2]].alloc,
+        p->vars[insn->src_args[1]].alloc,
+        p->vars[insn->dest_args[0]].alloc);
+  } else {
+    sse_emit_fmaf_slow (p, insn, SSE_FMA_NEG);
+  }
+}
+
+/* There is no wider type for doubles, so this is only registered when
+ * FMA3 is available.  Other CPUs use emulation. */
+static void
+sse_rule_fmad (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_sse_emit_vfmadd213pd (p,
+      p->vars[insn->src_args[2]].alloc,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+/* Without F16C, half conversions are done with integer operations on
+ * the bit patterns.  Constants are reloaded into one register to keep
+ * the register pressure low on 32-bit x86. */
+static void
+sse_rule_convhf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int sign, exp, c;
+
+  if (p->target_flags & ORC_TARGET_SSE_F16C) {
+    orc_sse_emit_vcvtph2ps (p, dest, dest);
+    return;
+  }
+
+  sign = orc_compiler_get_temp_reg (p);
+  exp = orc_compiler_get_temp_reg (p);
+  c = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_pxor (p, c, c);
+  orc_sse_emit_punpcklwd (p, c, dest);
+  orc_sse_emit_movdqa (p, dest, sign);
+  orc_sse_emit_pslld_imm (p, 16, sign);
+  orc_sse_load_constant (p, c, 4, 0x80000000);
+  orc_sse_emit_pand (p, c, sign);
+
+  /* exponent and mantissa moved into place and rebiased */
+  orc_sse_emit_pslld_imm (p, 13, dest);
+  orc_sse_load_constant (p, c, 4, 0x0fffe000);
+  orc_sse_emit_pand (p, c, dest);
+  orc_sse_load_constant (p, c, 4, 0x0f800000);
+  orc_sse_emit_movdqa (p, dest, exp);
+  orc_sse_emit_pand (p, c, exp);
+  orc_sse_emit_pcmpeqd (p, exp, c);
+  orc_sse_emit_psrld_imm (p, 29, c);
+  orc_sse_emit_pslld_imm (p, 27, c);
+  orc_sse_emit_paddd (p, c, dest);
+  orc_sse_load_constant (p, c, 4, 0x38000000);
+  orc_sse_emit_paddd (p, c, dest);
+
+  /* subnormals are normalized by subtracting 2^-14 as a float */
+  orc_sse_emit_pxor (p, c, c);
+  orc_sse_emit_pcmpeqd (p, c, exp);
+  orc_sse_emit_movdqa (p, exp, c);
+  orc_sse_emit_psrld_imm (p, 31, c);
+  orc_sse_emit_pslld_imm (p, 23, c);
+  orc_sse_emit_paddd (p, c, dest);
+  orc_sse_load_constant (p, c, 4, 0x38800000);
+  orc_sse_emit_pand (p, c, exp);
+  orc_sse_emit_subps (p, exp, dest);
+
+  orc_sse_emit_por (p, sign, dest);
+}
+
+static void
+sse_rule_convfh (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int sign, small, normal, c;
+
+  if (p->target_flags & ORC_TARGET_SSE_F16C) {
+    orc_sse_emit_vcvtps2ph (p, 0, dest, dest);
+    return;
+  }
+
+  sign = orc_compiler_get_temp_reg (p);
+  small = orc_compiler_get_temp_reg (p);
+  normal = orc_compiler_get_temp_reg (p);
+  c = orc_compiler_get_temp_reg (p);
+
+  orc_sse_load_constant (p, c, 4, 0x80000000);
+  orc_sse_emit_movdqa (p, dest, sign);
+  orc_sse_emit_pand (p, c, sign);
+  orc_sse_emit_pxor (p, sign, dest);
+
+  /* below 2^-14, adding 0.5 rounds to the half subnormal */
+  orc_sse_emit_movdqa (p, dest, small);
+  orc_sse_load_constant (p, c, 4, 0x3f000000);
+  orc_sse_emit_addps (p, c, small);
+  orc_sse_emit_psubd (p, c, small);
+
+  /* otherwise rebias and round to nearest even */
+  orc_sse_emit_movdqa (p, dest, normal);
+  orc_sse_emit_psrld_imm (p, 13, normal);
+  orc_sse_emit_pslld_imm (p, 31, normal);
+  orc_sse_emit_psrld_imm (p, 31, normal);
+  orc_sse_emit_paddd (p, dest, normal);
+  orc_sse_load_constant (p, c, 4, 0xc8000fff);
+  orc_sse_emit_paddd (p, c, normal);
+  orc_sse_emit_psrld_imm (p, 13, normal);
+
+  orc_sse_load_constant (p, c, 4, 0x38800000);
+  orc_sse_emit_pcmpgtd (p, dest, c);
+  orc_sse_emit_pand (p, c, small);
+  orc_sse_emit_pandn (p, normal, c);
+  orc_sse_emit_por (p, small, c);
+
+  /* infinity, or NaN with the quiet bit set */
+  orc_sse_emit_movdqa (p, dest, small);
+  orc_sse_load_constant (p, normal, 4, 0x7f800000);
+  orc_sse_emit_pcmpgtd (p, normal, small);
+  orc_sse_emit_movdqa (p, dest, normal);
+  orc_sse_emit_psrld_imm (p, 13, normal);
+  orc_sse_emit_pand (p, small, normal);
+  orc_sse_emit_psrld_imm (p, 31, small);
+  orc_sse_emit_pslld_imm (p, 9, small);
+  orc_sse_emit_por (p, small, normal);
+  orc_sse_load_constant (p, small, 4, 0x7c00);
+  orc_sse_emit_por (p, small, normal);
+
+  orc_sse_load_constant (p, small, 4, 0x477fffff);
+  orc_sse_emit_pcmpgtd (p, small, dest);
+  orc_sse_emit_pand (p, dest, normal);
+  orc_sse_emit_pandn (p, c, dest);
+  orc_sse_emit_por (p, normal, dest);
+
+  orc_sse_load_constant (p, c, 4, 0x7fff);
+  orc_sse_emit_pand (p, c, dest);
+  orc_sse_emit_pslld_imm (p, 16, dest);
+  orc_sse_emit_por (p, sign, dest);
+  orc_sse_emit_psrad_imm (p, 16, dest);
+  orc_sse_emit_packssdw (p, dest, dest);
+}
+
+/* Clears the mantissa of float denormals, keeping the sign. */
+static void
+sse_emit_flush_denormals (OrcCompiler *p, int reg, int tmp, int c)
+{
+  orc_sse_load_constant (p, c, 4, 0x7f800000);
+  orc_sse_emit_movdqa (p, reg, tmp);
+  orc_sse_emit_pand (p, c, tmp);
+  orc_sse_emit_pxor (p, c, c);
+  orc_sse_emit_pcmpeqd (p, c, tmp);
+  orc_sse_emit_psrld_imm (p, 1, tmp);
+  orc_sse_emit_pandn (p, reg, tmp);
+  orc_sse_emit_movdqa (p, tmp, reg);
+}
+
+static void
+sse_rule_convbf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+
+  orc_sse_emit_pxor (p, tmp, tmp);
+  orc_sse_emit_punpcklwd (p, dest, tmp);
+  orc_sse_emit_movdqa (p, tmp, dest);
+  sse_emit_flush_denormals (p, dest, tmp, c);
+}
+
+static void
+sse_rule_convfb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int nan = orc_compiler_get_temp_reg (p);
+  int tmp = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+
+  sse_emit_flush_denormals (p, dest, tmp, c);
+
+  orc_sse_load_constant (p, c, 4, 0x7fffffff);
+  orc_sse_emit_movdqa (p, dest, nan);
+  orc_sse_emit_pand (p, c, nan);
+  orc_sse_load_constant (p, c, 4, 0x7f800000);
+  orc_sse_emit_pcmpgtd (p, c, nan);
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_psrad_imm (p, 16, tmp);
+  orc_sse_load_constant (p, c, 4, 0x0040);
+  orc_sse_emit_por (p, c, tmp);
+  orc_sse_emit_pand (p, nan, tmp);
+
+  /* round to nearest even */
+  orc_sse_emit_movdqa (p, dest, c);
+  orc_sse_emit_psrld_imm (p, 16, c);
+  orc_sse_emit_pslld_imm (p, 31, c);
+  orc_sse_emit_psrld_imm (p, 31, c);
+  orc_sse_emit_paddd (p, c, dest);
+  orc_sse_load_constant (p, c, 4, 0x7fff);
+  orc_sse_emit_paddd (p, c, dest);
+  orc_sse_emit_psrad_imm (p, 16, dest);
+
+  orc_sse_emit_pandn (p, dest, nan);
+  orc_sse_emit_por (p, tmp, nan);
+  orc_sse_emit_packssdw (p, nan, nan);
+  orc_sse_emit_movdqa (p, nan, dest);
+}
+
+#define SSE_ROUND_NEAREST 0
+#define SSE_ROUND_FLOOR 1
+#define SSE_ROUND_CEIL 2
+#define SSE_ROUND_TRUNC 3
+
+/* Without SSE4.1, adding and subtracting 2^23 rounds the magnitude to
+ * an integer, which is then corrected by one for floor, ceil and
+ * trunc.  Magnitudes of 2^23 and above (and infinities and NaNs) are
+ * already integers and are passed through. */
+static void
+sse_emit_roundf_slow (OrcCompiler *p, OrcInstruction *insn, int mode)
+{
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int sign = orc_compiler_get_temp_reg (p);
+  int r = orc_compiler_get_temp_reg (p);
+  int tmp = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+
+  orc_sse_load_constant (p, c, 4, 0x80000000);
+  orc_sse_emit_movdqa (p, dest, sign);
+  orc_sse_emit_pand (p, c, sign);
+  orc_sse_emit_movdqa (p, dest, r);
+  orc_sse_emit_pxor (p, sign, r);
+  orc_sse_load_constant (p, c, 4, 0x4b000000);
+  orc_sse_emit_addps (p, c, r);
+  orc_sse_emit_subps (p, c, r);
+
+  switch (mode) {
+    case SSE_ROUND_FLOOR:
+      orc_sse_emit_por (p, sign, r);
+      orc_sse_emit_movdqa (p, dest, tmp);
+      orc_sse_emit_cmpltps (p, r, tmp);
+      orc_sse_load_constant (p, c, 4, 0x3f800000);
+      orc_sse_emit_pand (p, c, tmp);
+      orc_sse_emit_subps (p, tmp, r);
+      break;
+    case SSE_ROUND_CEIL:
+      orc_sse_emit_por (p, sign, r);
+      orc_sse_emit_movdqa (p, r, tmp);
+      orc_sse_emit_cmpltps (p, dest, tmp);
+      orc_sse_load_constant (p, c, 4, 0x3f800000);
+      orc_sse_emit_pand (p, c, tmp);
+      orc_sse_emit_addps (p, tmp, r);
+      break;
+    case SSE_ROUND_TRUNC:
+      orc_sse_emit_movdqa (p, dest, tmp);
+      orc_sse_emit_pxor (p, sign, tmp);
+      orc_sse_emit_cmpltps (p, r, tmp);
+      orc_sse_load_constant (p, c, 4, 0x3f800000);
+      orc_sse_emit_pand (p, c, tmp);
+      orc_sse_emit_subps (p, tmp, r);
+      orc_sse_emit_por (p, sign, r);
+      break;
+    default:
+      orc_sse_emit_por (p, sign, r);
+      break;
+  }
+
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_pxor (p, sign, tmp);
+  orc_sse_load_constant (p, c, 4, 0x4affffff);
+  orc_sse_emit_pcmpgtd (p, c, tmp);
+  orc_sse_emit_pand (p, tmp, dest);
+  orc_sse_emit_pandn (p, r, tmp);
+  orc_sse_emit_por (p, tmp, dest);
 }
 
-#define BINARY_D(opcode,insn_name,code) \
+#define ROUND_SSE(opcode,mode) \
 static void \
 sse_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
 { \
-  orc_sse_emit_ ## insn_name (p, \
-      p->vars[insn->src_args[1]].alloc, \
-      p->vars[insn->dest_args[0]].alloc); \
+  if (p->target_flags & ORC_TARGET_SSE_SSE4_1) { \
+    orc_sse_emit_roundps (p, mode, \
+        p->vars[insn->src_args[0]].alloc, \
+        p->vars[insn->dest_args[0]].alloc); \
+  } else { \
+    sse_emit_roundf_slow (p, insn, mode); \
+  } \
 }
 
-BINARY_D(addd, addpd, 0x58)
-BINARY_D(subd, subpd, 0x5c)
-BINARY_D(muld, mulpd, 0x59)
-BINARY_D(divd, divpd, 0x5e)
-UNARY_D(sqrtd, sqrtpd, 0x51)
-
+ROUND_SSE(roundf, SSE_ROUND_NEAREST)
+ROUND_SSE(floorf, SSE_ROUND_FLOOR)
+ROUND_SSE(ceilf, SSE_ROUND_CEIL)
+ROUND_SSE(truncf, SSE_ROUND_TRUNC)
+
+/* The 12-bit estimates from rcpps and rsqrtps are refined with
+ * Newton-Raphson steps.  Within the normal range the results are
+ * within 2 ulp of the correctly rounded value, except that rcpf of
+ * inputs with a magnitude of 2^126 gives zero.  Inputs of zero and
+ * infinity would make the steps produce NaN; for those lanes the
+ * estimate, which is exact, is kept. */
 static void
-sse_rule_minf (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_keep_estimate (OrcCompiler *p, int estimate, int dest, int tmp)
 {
-  if (p->target_flags & ORC_TARGET_FAST_NAN) {
-    orc_sse_emit_minps (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-  } else {
-    int tmp = orc_compiler_get_temp_reg (p);
-    orc_sse_emit_movdqa (p,
-        p->vars[insn->src_args[1]].alloc,
-        tmp);
-    orc_sse_emit_minps (p,
-        p->vars[insn->dest_args[0]].alloc,
-        tmp);
-    orc_sse_emit_minps (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-    orc_sse_emit_por (p,
-        tmp,
-        p->vars[insn->dest_args[0]].alloc);
-  }
+  orc_sse_emit_movdqa (p, dest, tmp);
+  orc_sse_emit_cmpunordps (p, dest, tmp);
+  orc_sse_emit_pand (p, tmp, estimate);
+  orc_sse_emit_pandn (p, dest, tmp);
+  orc_sse_emit_por (p, estimate, tmp);
+  orc_sse_emit_movdqa (p, tmp, dest);
 }
 
 static void
-sse_rule_mind (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_rcpf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  if (p->target_flags & ORC_TARGET_FAST_NAN) {
-    orc_sse_emit_minpd (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int x0 = orc_compiler_get_temp_reg (p);
+  int a = orc_compiler_get_temp_reg (p);
+  int tmp = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+  int i;
+
+  orc_sse_emit_movdqa (p, dest, a);
+  orc_sse_emit_rcpps (p, a, x0);
+  orc_sse_emit_movdqa (p, x0, dest);
+
+  if (p->target_flags & ORC_TARGET_SSE_FMA) {
+    /* x + x * (1 - a * x), one step is enough when the error term
+     * is computed without rounding */
+    orc_sse_load_constant (p, c, 4, 0x3f800000);
+    orc_sse_emit_movdqa (p, a, tmp);
+    orc_sse_emit_vfnmadd213ps (p, c, dest, tmp);
+    orc_sse_emit_vfmadd213ps (p, dest, dest, tmp);
+    orc_sse_emit_movdqa (p, tmp, dest);
   } else {
-    int tmp = orc_compiler_get_temp_reg (p);
-    orc_sse_emit_movdqa (p,
-        p->vars[insn->src_args[1]].alloc,
-        tmp);
-    orc_sse_emit_minpd (p,
-        p->vars[insn->dest_args[0]].alloc,
-        tmp);
-    orc_sse_emit_minpd (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-    orc_sse_emit_por (p,
-        tmp,
-        p->vars[insn->dest_args[0]].alloc);
+    /* x * (2 - a * x).  The shorter x + x * (1 - a * x) loses the
+     * correction to flush-to-zero for small results. */
+    int two = orc_compiler_get_temp_reg (p);
+
+    orc_sse_load_constant (p, two, 4, 0x40000000);
+    for(i=0;i<2;i++){
+      orc_sse_emit_movdqa (p, a, tmp);
+      orc_sse_emit_mulps (p, dest, tmp);
+      orc_sse_emit_movdqa (p, two, c);
+      orc_sse_emit_subps (p, tmp, c);
+      orc_sse_emit_mulps (p, c, dest);
+    }
   }
+
+  sse_emit_keep_estimate (p, x0, dest, tmp);
 }
 
 static void
-sse_rule_maxf (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_rsqrtf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  if (p->target_flags & ORC_TARGET_FAST_NAN) {
-    orc_sse_emit_maxps (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-  } else {
-    int tmp = orc_compiler_get_temp_reg (p);
-    orc_sse_emit_movdqa (p,
-        p->vars[insn->src_args[1]].alloc,
-        tmp);
-    orc_sse_emit_maxps (p,
-        p->vars[insn->dest_args[0]].alloc,
-        tmp);
-    orc_sse_emit_maxps (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-    orc_sse_emit_por (p,
-        tmp,
-        p->vars[insn->dest_args[0]].alloc);
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int y0 = orc_compiler_get_temp_reg (p);
+  int a = orc_compiler_get_temp_reg (p);
+  int tmp = orc_compiler_get_temp_reg (p);
+  int three = orc_compiler_get_temp_reg (p);
+  int neg_half = orc_compiler_get_temp_reg (p);
+  int i;
+
+  orc_sse_emit_movdqa (p, dest, a);
+  orc_sse_emit_rsqrtps (p, a, y0);
+  orc_sse_emit_movdqa (p, y0, dest);
+  orc_sse_load_constant (p, three, 4, 0x40400000);
+  orc_sse_load_constant (p, neg_half, 4, 0xbf000000);
+
+  /* y * (a * y * y - 3) * -0.5 */
+  for(i=0;i<2;i++){
+    orc_sse_emit_movdqa (p, a, tmp);
+    orc_sse_emit_mulps (p, dest, tmp);
+    orc_sse_emit_mulps (p, dest, tmp);
+    orc_sse_emit_subps (p, three, tmp);
+    orc_sse_emit_mulps (p, tmp, dest);
+    orc_sse_emit_mulps (p, neg_half, dest);
   }
+
+  sse_emit_keep_estimate (p, y0, dest, tmp);
 }
 
-static void
-sse_rule_maxd (OrcCompiler *p, void *user, OrcInstruction *insn)
+/* The transcendental opcodes follow the C backend step by step, so
+ * the results match emulation. */
+
+/* A register holding value in each lane.  This is a constant register
+ * loaded before the loop if one was free, otherwise value is loaded
+ * into c. */
+static int
+sse_get_constant (OrcCompiler *p, int c, orc_uint32 value)
 {
-  if (p->target_flags & ORC_TARGET_FAST_NAN) {
-    orc_sse_emit_maxpd (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-  } else {
-    int tmp = orc_compiler_get_temp_reg (p);
-    orc_sse_emit_movdqa (p,
-        p->vars[insn->src_args[1]].alloc,
-        tmp);
-    orc_sse_emit_maxpd (p,
-        p->vars[insn->dest_args[0]].alloc,
-        tmp);
-    orc_sse_emit_maxpd (p,
-        p->vars[insn->src_args[1]].alloc,
-        p->vars[insn->dest_args[0]].alloc);
-    orc_sse_emit_por (p,
-        tmp,
-        p->vars[insn->dest_args[0]].alloc);
-  }
+  int reg;
+
+  reg = orc_compiler_try_get_constant_long (p, value, value, value, value);
+  if (reg != ORC_REG_INVALID) return reg;
+
+  orc_sse_load_constant (p, c, 4, value);
+  return c;
+}
+
+static int
+sse_get_constant_f (OrcCompiler *p, int c, float value)
+{
+  orc_union32 u;
+
+  u.f = value;
+  return sse_get_constant (p, c, u.i);
+}
+
+static int
+sse_get_constant_d (OrcCompiler *p, int c, double value)
+{
+  orc_union64 u;
+  int reg;
+
+  u.f = value;
+  reg = orc_compiler_try_get_constant_long (p, u.x2[0], u.x2[1],
+      u.x2[0], u.x2[1]);
+  if (reg != ORC_REG_INVALID) return reg;
+
+  orc_sse_load_constant (p, c, 8, u.i);
+  return c;
 }
 
 static void
-sse_rule_cmpeqf (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_load_constant_f (OrcCompiler *p, int reg, float value)
 {
-  orc_sse_emit_cmpeqps (p,
-      p->vars[insn->src_args[1]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  orc_union32 u;
+
+  u.f = value;
+  orc_sse_load_constant (p, reg, 4, u.i);
 }
 
 static void
-sse_rule_cmpeqd (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_load_constant_d (OrcCompiler *p, int reg, double value)
 {
-  orc_sse_emit_cmpeqpd (p,
-      p->vars[insn->src_args[1]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  orc_union64 u;
+
+  u.f = value;
+  orc_sse_load_constant (p, reg, 8, u.i);
 }
 
+/* dest = dest * x + coeff[0], then the same for the rest of coeff */
+static void
+sse_emit_horner_f (OrcCompiler *p, int dest, int x, int c,
+    const float *coeff, int n)
+{
+  int i;
+
+  for(i=0;i<n;i++){
+    orc_sse_emit_mulps (p, x, dest);
+    orc_sse_emit_addps (p, sse_get_constant_f (p, c, coeff[i]), dest);
+  }
+}
 
 static void
-sse_rule_cmpltf (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_horner_d (OrcCompiler *p, int dest, int x, int c,
+    const double *coeff, int n)
 {
-  orc_sse_emit_cmpltps (p,
-      p->vars[insn->src_args[1]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  int i;
+
+  for(i=0;i<n;i++){
+    orc_sse_emit_mulpd (p, x, dest);
+    orc_sse_emit_addpd (p, sse_get_constant_d (p, c, coeff[i]), dest);
+  }
 }
 
+/* Multiplies dest by 2^n, in two steps since both 2^128 and 2^-126
+ * are needed.  Clobbers n. */
 static void
-sse_rule_cmpltd (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_scale2 (OrcCompiler *p, int dest, int n, int tmp, int c)
 {
-  orc_sse_emit_cmpltpd (p,
-      p->vars[insn->src_args[1]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  int bias;
+
+  orc_sse_emit_movdqa (p, n, tmp);
+  orc_sse_emit_psrad_imm (p, 1, tmp);
+  orc_sse_emit_psubd (p, tmp, n);
+  bias = sse_get_constant (p, c, 127);
+  orc_sse_emit_paddd (p, bias, tmp);
+  orc_sse_emit_paddd (p, bias, n);
+  orc_sse_emit_pslld_imm (p, 23, tmp);
+  orc_sse_emit_pslld_imm (p, 23, n);
+  orc_sse_emit_mulps (p, tmp, dest);
+  orc_sse_emit_mulps (p, n, dest);
 }
 
+/* Splits the floats in x into m * 2^e, with m in [sqrt(1/2),sqrt(2)),
+ * replacing x by m and leaving e as a float.  Lanes that are not
+ * positive, normal and finite get m = 1 and e = 0, and special is set
+ * to log(x) there and to 0 elsewhere. */
+static void
+sse_emit_log_reduce (OrcCompiler *p, int x, int e, int special, int b,
+    int c)
+{
+  int a = special;
+
+  /* a = mask of valid lanes */
+  orc_sse_emit_movdqa (p, x, e);
+  orc_sse_emit_paddd (p, sse_get_constant (p, c, 0x7f800000), e);
+  orc_sse_load_constant (p, a, 4, 0xff000000);
+  orc_sse_emit_pcmpgtd (p, e, a);
+
+  /* b = -inf for zero, NaN for negative, otherwise x */
+  orc_sse_emit_pxor (p, b, b);
+  orc_sse_emit_movdqa (p, x, c);
+  orc_sse_emit_cmpltps (p, b, c);
+  orc_sse_emit_cmpeqps (p, x, b);
+  orc_sse_emit_movdqa (p, b, e);
+  orc_sse_emit_pandn (p, x, b);
+  orc_sse_emit_por (p, c, b);
+  orc_sse_load_constant (p, c, 4, 0xff800000);
+  orc_sse_emit_pand (p, c, e);
+  orc_sse_emit_por (p, e, b);
+
+  /* x = 1.0 in invalid lanes, b = special value only there */
+  orc_sse_emit_movdqa (p, a, e);
+  orc_sse_emit_pandn (p, sse_get_constant_f (p, c, 1.0f), e);
+  orc_sse_emit_pand (p, a, x);
+  orc_sse_emit_por (p, e, x);
+  orc_sse_emit_pandn (p, b, a);
+
+  orc_sse_emit_psubd (p, sse_get_constant (p, c, 0x3f3504f3), x);
+  orc_sse_emit_movdqa (p, x, e);
+  orc_sse_emit_psrad_imm (p, 23, e);
+  orc_sse_emit_cvtdq2ps (p, e, e);
+  orc_sse_emit_pand (p, sse_get_constant (p, c, 0x007fffff), x);
+  orc_sse_emit_paddd (p, sse_get_constant (p, c, 0x3f3504f3), x);
+}
 
 static void
-sse_rule_cmplef (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_expf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  orc_sse_emit_cmpleps (p,
-      p->vars[insn->src_args[1]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  static const float coeff[] = { 1.3981999507e-3f, 8.3334519073e-3f,
+    4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f };
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int n = orc_compiler_get_temp_reg (p);
+  int k = orc_compiler_get_temp_reg (p);
+  int r = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+
+  /* clamp to [-104,89], keeping NaN */
+  sse_load_constant_f (p, n, 89.0f);
+  orc_sse_emit_minps (p, dest, n);
+  sse_load_constant_f (p, dest, -104.0f);
+  orc_sse_emit_maxps (p, n, dest);
+
+  /* n = round(x / ln(2)), as float in k and integer in n */
+  orc_sse_emit_movdqa (p, dest, n);
+  orc_sse_emit_mulps (p, sse_get_constant_f (p, c, 1.44269504f), n);
+  orc_sse_emit_addps (p, sse_get_constant_f (p, c, 12582912.0f), n);
+  orc_sse_emit_movdqa (p, n, k);
+  orc_sse_emit_subps (p, sse_get_constant_f (p, c, 12582912.0f), k);
+  orc_sse_emit_psubd (p, sse_get_constant (p, c, 0x4b400000), n);
+
+  /* r = x - n * ln(2) */
+  orc_sse_emit_movdqa (p, k, r);
+  orc_sse_emit_mulps (p, sse_get_constant_f (p, c, 0.693359375f), r);
+  orc_sse_emit_subps (p, r, dest);
+  orc_sse_emit_mulps (p, sse_get_constant_f (p, c, -2.12194440e-4f), k);
+  orc_sse_emit_subps (p, k, dest);
+
+  orc_sse_emit_movdqa (p, dest, k);
+  orc_sse_emit_mulps (p, dest, k);
+  sse_load_constant_f (p, r, 1.9875691500e-4f);
+  sse_emit_horner_f (p, r, dest, c, coeff, 5);
+  orc_sse_emit_mulps (p, k, r);
+  orc_sse_emit_addps (p, dest, r);
+  orc_sse_emit_addps (p, sse_get_constant_f (p, c, 1.0f), r);
+
+  sse_emit_scale2 (p, r, n, k, c);
+  orc_sse_emit_movdqa (p, r, dest);
 }
 
 static void
-sse_rule_cmpled (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_logf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  orc_sse_emit_cmplepd (p,
-      p->vars[insn->src_args[1]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  static const float coeff[] = { -1.1514610310e-1f, 1.1676998740e-1f,
+    -1.2420140846e-1f, 1.4249322787e-1f, -1.6668057665e-1f,
+    2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f };
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int e = orc_compiler_get_temp_reg (p);
+  int special = orc_compiler_get_temp_reg (p);
+  int y = orc_compiler_get_temp_reg (p);
+  int z = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+
+  sse_emit_log_reduce (p, dest, e, special, y, c);
+
+  /* f = m - 1 */
+  orc_sse_emit_subps (p, sse_get_constant_f (p, c, 1.0f), dest);
+  orc_sse_emit_movdqa (p, dest, z);
+  orc_sse_emit_mulps (p, dest, z);
+  sse_load_constant_f (p, y, 7.0376836292e-2f);
+  sse_emit_horner_f (p, y, dest, c, coeff, 8);
+  orc_sse_emit_mulps (p, dest, y);
+  orc_sse_emit_mulps (p, z, y);
+
+  sse_load_constant_f (p, c, -2.12194440e-4f);
+  orc_sse_emit_mulps (p, e, c);
+  orc_sse_emit_addps (p, c, y);
+  orc_sse_emit_mulps (p, sse_get_constant_f (p, c, 0.5f), z);
+  orc_sse_emit_subps (p, z, y);
+  orc_sse_emit_addps (p, y, dest);
+  orc_sse_emit_mulps (p, sse_get_constant_f (p, c, 0.693359375f), e);
+  orc_sse_emit_addps (p, e, dest);
+  orc_sse_emit_addps (p, special, dest);
 }
 
+/* Reduces the two doubles in x to x - k * pi/2, in [-pi/4,pi/4], and
+ * converts them to float.  The low 32 bits of k are put in q. */
+static void
+sse_emit_sin_reduce (OrcCompiler *p, int x, int q, int k, int tmp, int c)
+{
+  orc_sse_emit_movdqa (p, x, k);
+  orc_sse_emit_mulpd (p, sse_get_constant_d (p, c, 0.63661977236758134), k);
+  orc_sse_emit_addpd (p, sse_get_constant_d (p, c, 6755399441055744.0), k);
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,0,2,0), k, q);
+  orc_sse_emit_subpd (p, sse_get_constant_d (p, c, 6755399441055744.0), k);
+  orc_sse_emit_movdqa (p, k, tmp);
+  orc_sse_emit_mulpd (p, sse_get_constant_d (p, c, 1.5707963267341256), tmp);
+  orc_sse_emit_subpd (p, tmp, x);
+  orc_sse_emit_mulpd (p, sse_get_constant_d (p, c, 6.077100506506192e-11), k);
+  orc_sse_emit_subpd (p, k, x);
+  orc_sse_emit_cvtpd2ps (p, x, x);
+}
 
 static void
-sse_rule_convfl (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_sinf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  int src = p->vars[insn->src_args[0]].alloc;
+  static const float sin_coeff[] = { 8.3321608736e-3f, -1.6666654611e-1f };
+  static const float cos_coeff[] = { -1.388731625493765e-3f,
+    4.166664568298827e-2f };
   int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmpc;
+  int y = orc_compiler_get_temp_reg (p);
+  int a = orc_compiler_get_temp_reg (p);
+  int b = orc_compiler_get_temp_reg (p);
   int tmp = orc_compiler_get_temp_reg (p);
-  
-  tmpc = orc_compiler_get_temp_constant (p, 4, 0x80000000);
-  orc_sse_emit_movdqa (p, src, tmp);
-  orc_sse_emit_cvttps2dq (p, src, dest);
-  orc_sse_emit_psrad_imm (p, 31, tmp);
-  orc_sse_emit_pcmpeqd (p, dest, tmpc);
-  orc_sse_emit_pandn (p, tmpc, tmp);
-  orc_sse_emit_paddd (p, tmp, dest);
+  int c = orc_compiler_get_temp_reg (p);
+
+  /* high half first, keeping y and q together in one register */
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,2,3,2), dest, a);
+  orc_sse_emit_cvtps2pd (p, a, a);
+  sse_emit_sin_reduce (p, a, y, b, tmp, c);
+  orc_sse_emit_punpcklqdq (p, y, a);
+  orc_sse_emit_movdqa (p, a, y);
+
+  /* the low half puts q in the high half of dest */
+  orc_sse_emit_cvtps2pd (p, dest, a);
+  sse_emit_sin_reduce (p, a, dest, b, tmp, c);
+  orc_sse_emit_punpcklqdq (p, y, a);
+  orc_sse_emit_punpckhqdq (p, y, dest);
+
+  /* tmp = sin(y), a = cos(y) */
+  orc_sse_emit_movdqa (p, a, b);
+  orc_sse_emit_mulps (p, a, b);
+  sse_load_constant_f (p, tmp, -1.9515295891e-4f);
+  sse_emit_horner_f (p, tmp, b, c, sin_coeff, 2);
+  orc_sse_emit_mulps (p, b, tmp);
+  orc_sse_emit_mulps (p, a, tmp);
+  orc_sse_emit_addps (p, a, tmp);
+  sse_load_constant_f (p, a, 2.443315711809948e-5f);
+  sse_emit_horner_f (p, a, b, c, cos_coeff, 2);
+  orc_sse_emit_mulps (p, b, a);
+  orc_sse_emit_mulps (p, b, a);
+  orc_sse_emit_mulps (p, sse_get_constant_f (p, c, 0.5f), b);
+  orc_sse_emit_subps (p, b, a);
+  orc_sse_emit_addps (p, sse_get_constant_f (p, c, 1.0f), a);
+
+  if (user) {
+    orc_sse_emit_paddd (p, sse_get_constant (p, c, 1), dest);
+  }
 
+  /* select by bit 0 of the quadrant, negate by bit 1 */
+  orc_sse_emit_movdqa (p, dest, b);
+  orc_sse_emit_pslld_imm (p, 31, b);
+  orc_sse_emit_psrad_imm (p, 31, b);
+  orc_sse_emit_pand (p, b, a);
+  orc_sse_emit_pandn (p, tmp, b);
+  orc_sse_emit_por (p, b, a);
+  orc_sse_emit_psrld_imm (p, 1, dest);
+  orc_sse_emit_pslld_imm (p, 31, dest);
+  orc_sse_emit_pxor (p, a, dest);
 }
 
+/* One half of powf: the doubles in m, e and y give 2^n * f, with the
+ * floats f in the low half of dest and the integers n in the low half
+ * of n.  dest may be the same register as y or e. */
 static void
-sse_rule_convdl (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_emit_powf_half (OrcCompiler *p, int m, int e, int y, int dest, int n,
+    int t, int c)
 {
-  int src = p->vars[insn->src_args[0]].alloc;
-  int dest = p->vars[insn->dest_args[0]].alloc;
-  int tmpc;
-  int tmp = orc_compiler_get_temp_reg (p);
-  
-  tmpc = orc_compiler_get_temp_constant (p, 4, 0x80000000);
-  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,1,3,1), src, tmp);
-  orc_sse_emit_cvttpd2dq (p, src, dest);
-  orc_sse_emit_psrad_imm (p, 31, tmp);
-  orc_sse_emit_pcmpeqd (p, dest, tmpc);
-  orc_sse_emit_pandn (p, tmpc, tmp);
-  orc_sse_emit_paddd (p, tmp, dest);
+  static const double log_coeff[] = { 1.0/11, 1.0/9, 1.0/7, 1.0/5, 1.0/3,
+    1.0 };
+  static const double exp_coeff[] = { 1.525273380405984e-05,
+    1.5403530393381608e-04, 1.3333558146428443e-03, 9.618129107628477e-03,
+    5.550410866482158e-02, 2.402265069591007e-01, 6.931471805599453e-01,
+    1.0 };
+
+  /* log2(m * 2^e) = 2 atanh((m-1)/(m+1)) / ln(2) + e */
+  orc_sse_emit_movdqa (p, m, n);
+  orc_sse_emit_subpd (p, sse_get_constant_d (p, c, 1.0), n);
+  orc_sse_emit_addpd (p, sse_get_constant_d (p, c, 1.0), m);
+  orc_sse_emit_divpd (p, m, n);
+  orc_sse_emit_movdqa (p, n, m);
+  orc_sse_emit_mulpd (p, n, m);
+  sse_load_constant_d (p, t, 1.0/13);
+  sse_emit_horner_d (p, t, m, c, log_coeff, 6);
+  orc_sse_emit_mulpd (p, n, t);
+  orc_sse_emit_mulpd (p, sse_get_constant_d (p, c, 2.8853900817779268), t);
+  orc_sse_emit_addpd (p, e, t);
+
+  /* t = y * log2(x), clamped to [-160,130] keeping NaN */
+  orc_sse_emit_mulpd (p, y, t);
+  sse_load_constant_d (p, m, 130.0);
+  orc_sse_emit_minpd (p, t, m);
+  sse_load_constant_d (p, t, -160.0);
+  orc_sse_emit_maxpd (p, m, t);
+
+  /* 2^t = 2^n * 2^(t-n) */
+  orc_sse_emit_movdqa (p, t, n);
+  orc_sse_emit_addpd (p, sse_get_constant_d (p, c, 6755399441055744.0), n);
+  orc_sse_emit_subpd (p, sse_get_constant_d (p, c, 6755399441055744.0), n);
+  orc_sse_emit_subpd (p, n, t);
+  orc_sse_emit_cvttpd2dq (p, n, n);
+  sse_load_constant_d (p, dest, 1.3215486790144307e-06);
+  sse_emit_horner_d (p, dest, t, c, exp_coeff, 8);
+  orc_sse_emit_cvtpd2ps (p, dest, dest);
 }
 
 static void
-sse_rule_convlf (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_powf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  orc_sse_emit_cvtdq2ps (p,
-      p->vars[insn->src_args[0]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int src2 = p->vars[insn->src_args[1]].alloc;
+  int e = orc_compiler_get_temp_reg (p);
+  int hi = orc_compiler_get_temp_reg (p);
+  int n = orc_compiler_get_temp_reg (p);
+  int a = orc_compiler_get_temp_reg (p);
+  int b = orc_compiler_get_temp_reg (p);
+  int t = orc_compiler_get_temp_reg (p);
+  int c = orc_compiler_get_temp_reg (p);
+
+  if (src2 == dest) {
+    src2 = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_movdqa (p, dest, src2);
+  }
+
+  sse_emit_log_reduce (p, dest, e, a, b, c);
+  orc_sse_emit_addps (p, a, e);
+
+  /* high half, keeping f and n together in one register */
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,2,3,2), dest, a);
+  orc_sse_emit_cvtps2pd (p, a, a);
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,2,3,2), e, b);
+  orc_sse_emit_cvtps2pd (p, b, b);
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,2,3,2), src2, hi);
+  orc_sse_emit_cvtps2pd (p, hi, hi);
+  sse_emit_powf_half (p, a, b, hi, hi, n, t, c);
+  orc_sse_emit_punpcklqdq (p, n, hi);
+
+  orc_sse_emit_cvtps2pd (p, dest, a);
+  orc_sse_emit_cvtps2pd (p, e, b);
+  orc_sse_emit_cvtps2pd (p, src2, e);
+  sse_emit_powf_half (p, a, b, e, dest, n, t, c);
+  orc_sse_emit_punpcklqdq (p, hi, dest);
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(1,0,1,0), n, n);
+  orc_sse_emit_punpckhqdq (p, hi, n);
+
+  sse_emit_scale2 (p, dest, n, b, c);
 }
 
+/* Each register holds two complex numbers.  The real and imaginary
+ * parts of b are broadcast with movsldup and movshdup and multiplied
+ * with a and with a with its parts swapped; addsubps then combines the
+ * products.  Without SSE3 pshufd does the broadcasts, and there, or
+ * for the conjugate, the sum and the difference are blended, which
+ * keeps the sign of a NaN the same as with a plain subtraction. */
 static void
-sse_rule_convld (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_mulcf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  orc_sse_emit_cvtdq2pd (p,
-      p->vars[insn->src_args[0]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  int conj = ORC_PTR_TO_INT(user);
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int src2 = p->vars[insn->src_args[1]].alloc;
+  int re = orc_compiler_get_temp_reg (p);
+  int im = orc_compiler_get_temp_reg (p);
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  if (p->target_flags & ORC_TARGET_SSE_SSE3) {
+    orc_sse_emit_movsldup (p, src2, re);
+    orc_sse_emit_movshdup (p, src2, im);
+  } else {
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,2,0,0), src2, re);
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,3,1,1), src2, im);
+  }
+  /* (ar*br, ai*br) and (ai*bi, ar*bi) */
+  orc_sse_emit_mulps (p, dest, re);
+  orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,3,0,1), dest, tmp);
+  orc_sse_emit_mulps (p, tmp, im);
+
+  if (!conj && (p->target_flags & ORC_TARGET_SSE_SSE3)) {
+    orc_sse_emit_addsubps (p, im, re);
+    orc_sse_emit_movdqa (p, re, dest);
+  } else {
+    /* take the difference in the real lanes for a * b, in the imaginary
+     * lanes for a * conj(b), and the sum in the others */
+    orc_sse_emit_movdqa (p, re, tmp);
+    orc_sse_emit_addps (p, im, re);
+    orc_sse_emit_subps (p, im, tmp);
+    orc_sse_emit_pcmpeqd (p, im, im);
+    if (conj) {
+      orc_sse_emit_psllq_imm (p, 32, im);
+    } else {
+      orc_sse_emit_psrlq_imm (p, 32, im);
+    }
+    orc_sse_emit_pand (p, im, tmp);
+    orc_sse_emit_pandn (p, re, im);
+    orc_sse_emit_por (p, im, tmp);
+    orc_sse_emit_movdqa (p, tmp, dest);
+  }
 }
 
 static void
-sse_rule_convfd (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_magsqcf (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  orc_sse_emit_cvtps2pd (p,
-      p->vars[insn->src_args[0]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp;
+
+  orc_sse_emit_mulps (p, dest, dest);
+  if (p->target_flags & ORC_TARGET_SSE_SSE3) {
+    orc_sse_emit_haddps (p, dest, dest);
+  } else {
+    tmp = orc_compiler_get_temp_reg (p);
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,3,0,1), dest, tmp);
+    orc_sse_emit_addps (p, tmp, dest);
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,1,2,0), dest, dest);
+  }
 }
 
+/* Byte 0 of each pixel is replaced by 4 and the pixels are widened to
+ * words, which lines them up with the row (offset, c1, c2, c3) held in
+ * each quadword, so pmaddwd leaves two partial sums per pixel. */
 static void
-sse_rule_convdf (OrcCompiler *p, void *user, OrcInstruction *insn)
+sse_rule_matrowlb (OrcCompiler *p, void *user, OrcInstruction *insn)
 {
-  orc_sse_emit_cvtpd2ps (p,
-      p->vars[insn->src_args[0]].alloc,
-      p->vars[insn->dest_args[0]].alloc);
+  OrcVariable *src = p->vars + insn->src_args[1];
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int row;
+  int lo = orc_compiler_get_temp_reg (p);
+  int hi = orc_compiler_get_temp_reg (p);
+  int tmp;
+
+  if (src->vartype == ORC_VAR_TYPE_CONST) {
+    row = orc_compiler_get_constant_long (p, src->value.x2[0],
+        src->value.x2[1], src->value.x2[0], src->value.x2[1]);
+  } else {
+    row = orc_compiler_get_temp_reg (p);
+    orc_x86_emit_mov_memoffset_sse (p, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[1]]),
+        p->exec_reg, row, FALSE);
+    orc_sse_emit_movhps_load_memoffset (p,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor,
+          params[insn->src_args[1] + (ORC_VAR_T1 - ORC_VAR_P1)]),
+        p->exec_reg, row);
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(2,0,2,0), row, row);
+  }
+
+  orc_sse_emit_psrld_imm (p, 8, dest);
+  orc_sse_emit_pslld_imm (p, 8, dest);
+  tmp = orc_compiler_get_constant (p, 4, 4);
+  orc_sse_emit_por (p, tmp, dest);
+
+  tmp = orc_compiler_get_constant (p, 4, 0);
+  orc_sse_emit_movdqa (p, dest, lo);
+  orc_sse_emit_punpcklbw (p, tmp, lo);
+  orc_sse_emit_movdqa (p, dest, hi);
+  orc_sse_emit_punpckhbw (p, tmp, hi);
+  orc_sse_emit_pmaddwd (p, row, lo);
+  orc_sse_emit_pmaddwd (p, row, hi);
+
+  if (p->target_flags & ORC_TARGET_SSE_SSSE3) {
+    orc_sse_emit_phaddd (p, hi, lo);
+  } else {
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,1,2,0), lo, lo);
+    orc_sse_emit_pshufd (p, ORC_SSE_SHUF(3,1,2,0), hi, hi);
+    orc_sse_emit_movdqa (p, lo, dest);
+    orc_sse_emit_punpcklqdq (p, hi, lo);
+    orc_sse_emit_punpckhqdq (p, hi, dest);
+    orc_sse_emit_paddd (p, dest, lo);
+  }
+
+  orc_sse_emit_psrad_imm (p, 8, lo);
+  orc_sse_emit_packssdw (p, lo, lo);
+  orc_sse_emit_packuswb (p, lo, lo);
+  orc_sse_emit_movdqa (p, lo, dest);
 }
 #endif
 
@@ -2766,6 +5090,9 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   orc_rule_register (rule_set, "loadpq", sse_rule_loadpX, (void *)8);
   orc_rule_register (rule_set, "ldresnearl", sse_rule_ldresnearl, NULL);
   orc_rule_register (rule_set, "ldreslinl", sse_rule_ldreslinl, NULL);
+#ifndef MMX
+  orc_rule_register (rule_set, "ldresbilinl", sse_rule_ldresbilinl, NULL);
+#endif
 
   orc_rule_register (rule_set, "storeb", sse_rule_storeX, NULL);
   orc_rule_register (rule_set, "storew", sse_rule_storeX, NULL);
@@ -2815,6 +5142,7 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   REG(orl);
   REG(subl);
   REG(xorl);
+  REG(maddswl);
 
   REG(andq);
   REG(andnq);
@@ -2870,6 +5198,11 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   orc_rule_register (rule_set, "accw", sse_rule_accw, NULL);
   orc_rule_register (rule_set, "accl", sse_rule_accl, NULL);
   orc_rule_register (rule_set, "accsadubl", sse_rule_accsadubl, NULL);
+#ifndef MMX
+  orc_rule_register (rule_set, "findb", sse_rule_findX, NULL);
+  orc_rule_register (rule_set, "findw", sse_rule_findX, NULL);
+  orc_rule_register (rule_set, "findl", sse_rule_findX, NULL);
+#endif
 
 #ifndef MMX
   /* These require the SSE2 flag, although could be used with MMX.
@@ -2906,6 +5239,66 @@ orc_compiler_sse_register_rules (OrcTarget *target)
 
   orc_rule_register (rule_set, "convfd", sse_rule_convfd, NULL);
   orc_rule_register (rule_set, "convdf", sse_rule_convdf, NULL);
+
+  orc_rule_register (rule_set, "fmaf", sse_rule_fmaf, NULL);
+  orc_rule_register (rule_set, "fmsf", sse_rule_fmsf, NULL);
+  orc_rule_register (rule_set, "fnmaf", sse_rule_fnmaf, NULL);
+
+  orc_rule_register (rule_set, "convhf", sse_rule_convhf, NULL);
+  orc_rule_register (rule_set, "convfh", sse_rule_convfh, NULL);
+  orc_rule_register (rule_set, "convbf", sse_rule_convbf, NULL);
+  orc_rule_register (rule_set, "convfb", sse_rule_convfb, NULL);
+
+  orc_rule_register (rule_set, "roundf", sse_rule_roundf, NULL);
+  orc_rule_register (rule_set, "floorf", sse_rule_floorf, NULL);
+  orc_rule_register (rule_set, "ceilf", sse_rule_ceilf, NULL);
+  orc_rule_register (rule_set, "truncf", sse_rule_truncf, NULL);
+  orc_rule_register (rule_set, "rcpf", sse_rule_rcpf, NULL);
+  orc_rule_register (rule_set, "rsqrtf", sse_rule_rsqrtf, NULL);
+  orc_rule_register (rule_set, "expf", sse_rule_expf, NULL);
+  orc_rule_register (rule_set, "logf", sse_rule_logf, NULL);
+  orc_rule_register (rule_set, "sinf", sse_rule_sinf, (void *)0);
+  orc_rule_register (rule_set, "cosf", sse_rule_sinf, (void *)1);
+  orc_rule_register (rule_set, "powf", sse_rule_powf, NULL);
+  orc_rule_register (rule_set, "mulcf", sse_rule_mulcf, (void *)0);
+  orc_rule_register (rule_set, "mulconjcf", sse_rule_mulcf, (void *)1);
+  orc_rule_register (rule_set, "magsqcf", sse_rule_magsqcf, NULL);
+  orc_rule_register (rule_set, "matrowlb", sse_rule_matrowlb, NULL);
+
+  orc_rule_register (rule_set, "loadstrb", sse_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "loadstrw", sse_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "loadstrl", sse_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "loadstrq", sse_rule_loadstrX, NULL);
+  orc_rule_register (rule_set, "storestrb", sse_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "storestrw", sse_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "storestrl", sse_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "storestrq", sse_rule_storestrX, NULL);
+  orc_rule_register (rule_set, "loadtrb", sse_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "loadtrw", sse_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "loadtrl", sse_rule_loadtrX, NULL);
+  orc_rule_register (rule_set, "loadtrq", sse_rule_loadtrX, NULL);
+
+  orc_rule_register (rule_set, "scanaddw", sse_rule_scanaddX, NULL);
+  orc_rule_register (rule_set, "scanaddl", sse_rule_scanaddX, NULL);
+  orc_rule_register (rule_set, "scanaddf", sse_rule_scanaddX, NULL);
+
+  orc_rule_register (rule_set, "selectb", sse_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectw", sse_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectl", sse_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectf", sse_rule_selectX, NULL);
+  orc_rule_register (rule_set, "selectd", sse_rule_selectX, NULL);
+  orc_rule_register (rule_set, "unpacklb", sse_rule_unpackX, (void *)8);
+  orc_rule_register (rule_set, "unpacklw", sse_rule_unpackX, (void *)4);
+  orc_rule_register (rule_set, "packbl", sse_rule_packX, (void *)8);
+  orc_rule_register (rule_set, "packwl", sse_rule_packX, (void *)4);
+  orc_rule_register (rule_set, "popcntb", sse_rule_popcntX, NULL);
+  orc_rule_register (rule_set, "popcntw", sse_rule_popcntX, NULL);
+  orc_rule_register (rule_set, "popcntl", sse_rule_popcntX, NULL);
+  orc_rule_register (rule_set, "clzw", sse_rule_clzX, NULL);
+  orc_rule_register (rule_set, "clzl", sse_rule_clzX, NULL);
+  orc_rule_register (rule_set, "bitrevb", sse_rule_bitrevb, NULL);
+  orc_rule_register (rule_set, "shufflel", sse_rule_shuffleX, NULL);
+  orc_rule_register (rule_set, "shuffleq", sse_rule_shuffleX, NULL);
 #endif
 
   /* slow rules */
@@ -2946,6 +5339,7 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   orc_rule_register (rule_set, "mullb", sse_rule_mullb, NULL);
   orc_rule_register (rule_set, "mulhsb", sse_rule_mulhsb, NULL);
   orc_rule_register (rule_set, "mulhub", sse_rule_mulhub, NULL);
+  orc_rule_register (rule_set, "maddusbw", sse_rule_maddusbw_slow, NULL);
   orc_rule_register (rule_set, "addssl", sse_rule_addssl_slow, NULL);
   orc_rule_register (rule_set, "subssl", sse_rule_subssl_slow, NULL);
   orc_rule_register (rule_set, "addusl", sse_rule_addusl_slow, NULL);
@@ -2972,6 +5366,7 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   REG(absb);
   REG(absw);
   REG(absl);
+  REG(maddusbw);
 #ifndef MMX
   orc_rule_register (rule_set, "swapw", sse_rule_swapw_ssse3, NULL);
   orc_rule_register (rule_set, "swapl", sse_rule_swapl_ssse3, NULL);
@@ -2983,6 +5378,12 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   orc_rule_register (rule_set, "select1lw", sse_rule_select1lw_ssse3, NULL);
   orc_rule_register (rule_set, "select0wb", sse_rule_select0wb_ssse3, NULL);
   orc_rule_register (rule_set, "select1wb", sse_rule_select1wb_ssse3, NULL);
+  orc_rule_register (rule_set, "loadch3b", sse_rule_loadchX, (void *)3);
+  orc_rule_register (rule_set, "loadch4b", sse_rule_loadchX, (void *)4);
+  orc_rule_register (rule_set, "loadch3w", sse_rule_loadchX, (void *)3);
+  orc_rule_register (rule_set, "loadch4w", sse_rule_loadchX, (void *)4);
+  orc_rule_register (rule_set, "storech3b", sse_rule_storechX, (void *)3);
+  orc_rule_register (rule_set, "storech3w", sse_rule_storechX, (void *)3);
 #endif
 
   /* SSE 4.1 */
@@ -3008,6 +5409,11 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   orc_rule_register (rule_set, "mulslq", sse_rule_mulslq, NULL);
 #ifndef MMX
   orc_rule_register (rule_set, "mulhsl", sse_rule_mulhsl, NULL);
+  orc_rule_register (rule_set, "selectb", sse_rule_selectX_sse41, NULL);
+  orc_rule_register (rule_set, "selectw", sse_rule_selectX_sse41, NULL);
+  orc_rule_register (rule_set, "selectl", sse_rule_selectX_sse41, NULL);
+  orc_rule_register (rule_set, "selectf", sse_rule_selectX_sse41, NULL);
+  orc_rule_register (rule_set, "selectd", sse_rule_selectX_sse41, NULL);
 #endif
   REG(cmpeqq);
 
@@ -3018,5 +5424,13 @@ orc_compiler_sse_register_rules (OrcTarget *target)
   REG(cmpgtsq);
 
   /* SSE 4a -- no rules */
+
+#ifndef MMX
+  /* FMA3 */
+  rule_set = orc_rule_set_new (orc_opcode_set_get("sys"), target,
+      ORC_TARGET_SSE_FMA);
+
+  orc_rule_register (rule_set, "fmad", sse_rule_fmad, NULL);
+#endif
 }
 
@@ -44,7 +44,8 @@ typedef enum {
   ORC_TARGET_MMX_SSE4_2 = (1<<6),
   ORC_TARGET_MMX_FRAME_POINTER = (1<<7),
   ORC_TARGET_MMX_SHORT_JUMPS = (1<<8),
-  ORC_TARGET_MMX_64BIT = (1<<9)
+  ORC_TARGET_MMX_64BIT = (1<<9),
+  ORC_TARGET_MMX_SMALL_N = (1<<12)
 } OrcTargetMMXFlags;
 
 typedef enum {
@@ -57,7 +58,10 @@ typedef enum {
   ORC_TARGET_SSE_SSE5 = (1<<6),
   ORC_TARGET_SSE_FRAME_POINTER = (1<<7),
   ORC_TARGET_SSE_SHORT_JUMPS = (1<<8),
-  ORC_TARGET_SSE_64BIT = (1<<9)
+  ORC_TARGET_SSE_64BIT = (1<<9),
+  ORC_TARGET_SSE_FMA = (1<<10),
+  ORC_TARGET_SSE_F16C = (1<<11),
+  ORC_TARGET_SSE_SMALL_N = (1<<12)
 }OrcTargetSSEFlags;
 
 
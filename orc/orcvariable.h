@@ -73,6 +73,14 @@ struct _OrcVariable {
 
   int has_parameter;
   int parameter;
+
+  int element_stride;
+  int transposed;
+  int ring;
+  int inplace;
+  int inplace_dest;
+  int need_stride_reg;
+  int stride_register;
 };
 
 ORC_END_DECLS
@@ -444,6 +444,19 @@ orc_x86_do_fixups (OrcCompiler *compiler)
   }
 }
 
+void
+orc_x86_emit_push_saved_regs (OrcCompiler *compiler)
+{
+  int i;
+
+  for(i=0;i<16;i++){
+    if (compiler->used_regs[ORC_GP_REG_BASE+i] &&
+        compiler->save_regs[ORC_GP_REG_BASE+i]) {
+      orc_x86_emit_push (compiler, 8, ORC_GP_REG_BASE+i);
+    }
+  }
+}
+
 void
 orc_x86_emit_prologue (OrcCompiler *compiler)
 {
@@ -451,16 +464,9 @@ orc_x86_emit_prologue (OrcCompiler *compiler)
   orc_compiler_append_code(compiler,".p2align 4\n");
   orc_compiler_append_code(compiler,"%s:\n", compiler->program->name);
   if (compiler->is_64bit) {
-    int i;
-
     orc_x86_emit_cpuinsn_none (compiler, ORC_X86_endbr64);
 
-    for(i=0;i<16;i++){
-      if (compiler->used_regs[ORC_GP_REG_BASE+i] &&
-          compiler->save_regs[ORC_GP_REG_BASE+i]) {
-        orc_x86_emit_push (compiler, 8, ORC_GP_REG_BASE+i);
-      }
-    }
+    orc_x86_emit_push_saved_regs (compiler);
   } else {
     orc_x86_emit_cpuinsn_none (compiler, ORC_X86_endbr32);
     orc_x86_emit_push (compiler, 4, X86_EBP);
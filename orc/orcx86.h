@@ -96,8 +96,12 @@ ORC_API void orc_x86_emit_pop (OrcCompiler *compiler, int size, int reg);
   orc_x86_emit_cpuinsn_size(p, ORC_X86_sub_r_rm, size, src, dest)
 #define orc_x86_emit_sub_memoffset_reg(p,size,offset,src,dest) \
   orc_x86_emit_cpuinsn_memoffset_reg(p, ORC_X86_sub_rm_r, size, offset, src, dest)
+#define orc_x86_emit_sub_reg_memoffset(p,size,src,offset,dest) \
+  orc_x86_emit_cpuinsn_reg_memoffset_s(p, ORC_X86_sub_r_rm, size, src, offset, dest)
 #define orc_x86_emit_imul_memoffset_reg(p,size,offset,src,dest) \
   orc_x86_emit_cpuinsn_memoffset_reg(p, ORC_X86_imul_rm_r, size, offset, src, dest)
+#define orc_x86_emit_bsf_reg_reg(p,size,src,dest) \
+  orc_x86_emit_cpuinsn_size(p, ORC_X86_bsf, size, src, dest)
 
 #define orc_x86_emit_cmp_reg_memoffset(p,size,src,offset,dest) \
   orc_x86_emit_cpuinsn_reg_memoffset_s(p, ORC_X86_cmp_r_rm, size, src, offset, dest)
@@ -108,6 +112,10 @@ ORC_API void orc_x86_emit_pop (OrcCompiler *compiler, int size, int reg);
   orc_x86_emit_cpuinsn_branch (p, ORC_X86_jg, label)
 #define orc_x86_emit_jle(p,label) \
   orc_x86_emit_cpuinsn_branch (p, ORC_X86_jle, label)
+#define orc_x86_emit_jge(p,label) \
+  orc_x86_emit_cpuinsn_branch (p, ORC_X86_jge, label)
+#define orc_x86_emit_jl(p,label) \
+  orc_x86_emit_cpuinsn_branch (p, ORC_X86_jl, label)
 #define orc_x86_emit_je(p,label) \
   orc_x86_emit_cpuinsn_branch (p, ORC_X86_jz, label)
 #define orc_x86_emit_jne(p,label) \
@@ -137,6 +145,7 @@ ORC_API void orc_x86_emit_add_reg_reg_shift (OrcCompiler *compiler, int size, in
 ORC_API void orc_x86_emit_cmp_imm_memoffset (OrcCompiler *compiler, int size, int value, int offset, int reg);
 ORC_API void orc_x86_emit_cmp_imm_reg (OrcCompiler *compiler, int size, int value, int reg);
 ORC_API void orc_x86_emit_rep_movs (OrcCompiler *compiler, int size);
+ORC_API void orc_x86_emit_push_saved_regs (OrcCompiler *compiler);
 ORC_API void orc_x86_emit_prologue (OrcCompiler *compiler);
 ORC_API void orc_x86_emit_epilogue (OrcCompiler *compiler);
 
@@ -163,6 +172,8 @@ ORC_API void orc_x86_emit_cpuinsn_size (OrcCompiler *p, int opcode, int size,
     int src, int dest);
 ORC_API void orc_x86_emit_cpuinsn_imm (OrcCompiler *p, int opcode, int imm,
     int src, int dest);
+ORC_API void orc_x86_emit_cpuinsn_vex (OrcCompiler *p, int opcode, int src,
+    int src2, int dest);
 ORC_API void orc_x86_emit_cpuinsn_load_memoffset (OrcCompiler *p, int size, int index,
     int offset, int src, int dest, int imm);
 ORC_API void orc_x86_emit_cpuinsn_store_memoffset (OrcCompiler *p, int size, int index,
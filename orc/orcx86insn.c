@@ -256,11 +256,32 @@ static const OrcSysOpcode orc_x86_opcodes[] = {
   { "movq", ORC_X86_INSN_TYPE_MMXM_MMX_REV, 0, 0x00, 0x0f7f },
   { "endbr32", ORC_X86_INSN_TYPE_NONE, 0, 0xf3, 0x0f1efb },
   { "endbr64", ORC_X86_INSN_TYPE_NONE, 0, 0xf3, 0x0f1efa },
+  { "vfmadd213ps", ORC_X86_INSN_TYPE_VEX_SSEM_SSE, 0, 0x66, 0x0f38a8, 0 },
+  { "vfmadd213pd", ORC_X86_INSN_TYPE_VEX_SSEM_SSE, 0, 0x66, 0x0f38a8, 1 },
+  { "vfmsub213ps", ORC_X86_INSN_TYPE_VEX_SSEM_SSE, 0, 0x66, 0x0f38aa, 0 },
+  { "vfmsub213pd", ORC_X86_INSN_TYPE_VEX_SSEM_SSE, 0, 0x66, 0x0f38aa, 1 },
+  { "vfnmadd213ps", ORC_X86_INSN_TYPE_VEX_SSEM_SSE, 0, 0x66, 0x0f38ac, 0 },
+  { "vfnmadd213pd", ORC_X86_INSN_TYPE_VEX_SSEM_SSE, 0, 0x66, 0x0f38ac, 1 },
+  { "vcvtph2ps", ORC_X86_INSN_TYPE_VEX2_SSEM_SSE, 0, 0x66, 0x0f3813, 0 },
+  { "vcvtps2ph", ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM, 0, 0x66, 0x0f3a1d, 0 },
+  { "roundps", ORC_X86_INSN_TYPE_IMM8_MMXM_MMX, 0, 0x66, 0x0f3a08 },
+  { "rcpps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x00, 0x0f53 },
+  { "rsqrtps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x00, 0x0f52 },
+  { "cmpunordps", ORC_X86_INSN_TYPE_SSEM_SSE, 0, 0x00, 0x0fc2, 3 },
+  { "pblendvb", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x66, 0x0f3810 },
+  { "blendvps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x66, 0x0f3814 },
+  { "blendvpd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x66, 0x0f3815 },
+  { "pmovmskb", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0fd7 },
+  { "bsf", ORC_X86_INSN_TYPE_REGM_REG, 0, 0x00, 0x0fbc },
+  { "movsldup", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0xf3, 0x0f12 },
+  { "movshdup", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0xf3, 0x0f16 },
+  { "addsubps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0xf2, 0x0fd0 },
+  { "haddps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0xf2, 0x0f7c },
 };
 
 static void
 output_opcode (OrcCompiler *p, const OrcSysOpcode *opcode, int size,
-    int src, int dest, int is_sse)
+    int src, int dest, int index, int is_sse)
 {
   ORC_ASSERT(opcode->code != 0);
 
@@ -273,7 +294,7 @@ output_opcode (OrcCompiler *p, const OrcSysOpcode *opcode, int size,
       *p->codeptr++ = opcode->prefix;
     }
   }
-  orc_x86_emit_rex (p, size, dest, 0, src);
+  orc_x86_emit_rex (p, size, dest, index, src);
   if (opcode->code & 0xff0000) {
     *p->codeptr++ = (opcode->code >> 16) & 0xff;
   }
@@ -283,6 +304,52 @@ output_opcode (OrcCompiler *p, const OrcSysOpcode *opcode, int size,
   *p->codeptr++ = (opcode->code >> 0) & 0xff;
 }
 
+/* Three-byte VEX prefix, 128-bit vector length.  code2 holds VEX.W,
+ * src2 goes in VEX.vvvv for three-operand forms. */
+static void
+output_vex_opcode (OrcCompiler *p, OrcX86Insn *xinsn)
+{
+  const OrcSysOpcode *opcode = xinsn->opcode;
+  int map;
+  int pp;
+  int byte1;
+  int reg = xinsn->dest;
+  int rm = xinsn->src;
+  int vvvv = 0;
+
+  switch (opcode->prefix) {
+    case 0x66: pp = 1; break;
+    case 0xf3: pp = 2; break;
+    case 0xf2: pp = 3; break;
+    default: pp = 0; break;
+  }
+  switch ((opcode->code >> 8) & 0xffff) {
+    case 0x0f38: map = 2; break;
+    case 0x0f3a: map = 3; break;
+    default: map = 1; break;
+  }
+
+  if (opcode->type == ORC_X86_INSN_TYPE_VEX_SSEM_SSE) {
+    vvvv = xinsn->src2;
+  } else if (opcode->type == ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM) {
+    reg = xinsn->src;
+    rm = xinsn->dest;
+  }
+
+  /* R, X and B are stored inverted */
+  byte1 = 0xe0 | map;
+  if (reg & 8) byte1 &= ~0x80;
+  if (xinsn->type == ORC_X86_RM_MEMINDEX && (xinsn->index_reg & 8)) {
+    byte1 &= ~0x40;
+  }
+  if (rm & 8) byte1 &= ~0x20;
+
+  *p->codeptr++ = 0xc4;
+  *p->codeptr++ = byte1;
+  *p->codeptr++ = (opcode->code2 << 7) | ((~vvvv & 0xf) << 3) | pp;
+  *p->codeptr++ = opcode->code & 0xff;
+}
+
 static const char *
 orc_x86_get_regname_mmxsse (int reg, int is_sse)
 {
@@ -315,6 +382,25 @@ orc_x86_insn_output_asm (OrcCompiler *p, OrcX86Insn *xinsn)
     ORC_ASM_CODE(p,"%d:\n", xinsn->label);
     return;
   }
+  if (xinsn->opcode->type == ORC_X86_INSN_TYPE_VEX_SSEM_SSE) {
+    ORC_ASM_CODE(p,"  %s %%%s, %%%s, %%%s\n", xinsn->opcode->name,
+        orc_x86_get_regname_sse (xinsn->src),
+        orc_x86_get_regname_sse (xinsn->src2),
+        orc_x86_get_regname_sse (xinsn->dest));
+    return;
+  }
+  if (xinsn->opcode->type == ORC_X86_INSN_TYPE_VEX2_SSEM_SSE) {
+    ORC_ASM_CODE(p,"  %s %%%s, %%%s\n", xinsn->opcode->name,
+        orc_x86_get_regname_sse (xinsn->src),
+        orc_x86_get_regname_sse (xinsn->dest));
+    return;
+  }
+  if (xinsn->opcode->type == ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM) {
+    ORC_ASM_CODE(p,"  %s $%d, %%%s, %%%s\n", xinsn->opcode->name, xinsn->imm,
+        orc_x86_get_regname_sse (xinsn->src),
+        orc_x86_get_regname_sse (xinsn->dest));
+    return;
+  }
 
   is_sse = FALSE;
   if (is_sse_reg (xinsn->src) || is_sse_reg (xinsn->dest)) {
@@ -437,8 +523,13 @@ orc_x86_insn_output_asm (OrcCompiler *p, OrcX86Insn *xinsn)
     case ORC_X86_INSN_TYPE_IMM8_REGM_MMX:
     case ORC_X86_INSN_TYPE_REGM_MMX:
     case ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT:
-      sprintf(op2_str, "%%%s",
+      if (xinsn->dest >= ORC_GP_REG_BASE && xinsn->dest < ORC_GP_REG_BASE + 16) {
+        /* pmovmskb */
+        sprintf(op2_str, "%%%s", orc_x86_get_regname (xinsn->dest));
+      } else {
+        sprintf(op2_str, "%%%s",
             orc_x86_get_regname_mmxsse (xinsn->dest, is_sse));
+      }
       break;
     case ORC_X86_INSN_TYPE_MMXM_MMX_REV:
     case ORC_X86_INSN_TYPE_SSEM_SSE_REV:
@@ -567,6 +658,11 @@ static void
 orc_x86_insn_output_opcode (OrcCompiler *p, OrcX86Insn *xinsn)
 {
   int is_sse;
+  int index = 0;
+
+  if (xinsn->type == ORC_X86_RM_MEMINDEX) {
+    index = xinsn->index_reg;
+  }
 
   is_sse = FALSE;
   if (is_sse_reg (xinsn->src) || is_sse_reg (xinsn->dest)) {
@@ -575,50 +671,55 @@ orc_x86_insn_output_opcode (OrcCompiler *p, OrcX86Insn *xinsn)
 
   switch (xinsn->opcode->type) {
     case ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT:
-      output_opcode (p, xinsn->opcode, 4, xinsn->dest, 0, is_sse);
+      output_opcode (p, xinsn->opcode, 4, xinsn->dest, 0, index, is_sse);
       break;
     case ORC_X86_INSN_TYPE_MMX_REGM_REV:
     case ORC_X86_INSN_TYPE_MMXM_MMX_REV:
     case ORC_X86_INSN_TYPE_SSEM_SSE_REV:
-      output_opcode (p, xinsn->opcode, 4, xinsn->dest, xinsn->src, is_sse);
+      output_opcode (p, xinsn->opcode, 4, xinsn->dest, xinsn->src, index, is_sse);
       break;
     case ORC_X86_INSN_TYPE_REG_REGM:
     case ORC_X86_INSN_TYPE_IMM8_REGM:
     case ORC_X86_INSN_TYPE_IMM32_REGM:
     case ORC_X86_INSN_TYPE_REG8_REGM:
     case ORC_X86_INSN_TYPE_REG16_REGM:
-      output_opcode (p, xinsn->opcode, xinsn->size, xinsn->dest, xinsn->src, FALSE);
+      output_opcode (p, xinsn->opcode, xinsn->size, xinsn->dest, xinsn->src, index, FALSE);
       break;
     case ORC_X86_INSN_TYPE_IMM8_MMXM_MMX:
     case ORC_X86_INSN_TYPE_MMXM_MMX:
     case ORC_X86_INSN_TYPE_SSEM_SSE:
     case ORC_X86_INSN_TYPE_REGM_MMX:
-      output_opcode (p, xinsn->opcode, 4, xinsn->src, xinsn->dest, is_sse);
+      output_opcode (p, xinsn->opcode, 4, xinsn->src, xinsn->dest, index, is_sse);
       break;
     case ORC_X86_INSN_TYPE_IMM8_REGM_MMX:
       output_opcode (p, xinsn->opcode, xinsn->size, xinsn->src, xinsn->dest,
-          is_sse);
+          index, is_sse);
       break;
     case ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV:
-      output_opcode (p, xinsn->opcode, 4, xinsn->dest, xinsn->src,
+      output_opcode (p, xinsn->opcode, 4, xinsn->dest, xinsn->src, index,
           is_sse);
       break;
     case ORC_X86_INSN_TYPE_MEM:
     case ORC_X86_INSN_TYPE_REGM_REG:
-      output_opcode (p, xinsn->opcode, xinsn->size, xinsn->src, xinsn->dest, FALSE);
+      output_opcode (p, xinsn->opcode, xinsn->size, xinsn->src, xinsn->dest, index, FALSE);
       break;
     case ORC_X86_INSN_TYPE_REGM:
-      output_opcode (p, xinsn->opcode, xinsn->size, xinsn->src, xinsn->dest, FALSE);
+      output_opcode (p, xinsn->opcode, xinsn->size, xinsn->src, xinsn->dest, index, FALSE);
       break;
     case ORC_X86_INSN_TYPE_IMM32_REGM_MOV:
       orc_x86_emit_rex (p, xinsn->size, 0, 0, xinsn->dest);
       *p->codeptr++ = xinsn->opcode->code + (xinsn->dest&7);
       break;
     case ORC_X86_INSN_TYPE_NONE:
-      output_opcode (p, xinsn->opcode, 4, 0, 0, FALSE);
+      output_opcode (p, xinsn->opcode, 4, 0, 0, index, FALSE);
       break;
     case ORC_X86_INSN_TYPE_IMM32_A:
-      output_opcode (p, xinsn->opcode, xinsn->size, 0, 0, FALSE);
+      output_opcode (p, xinsn->opcode, xinsn->size, 0, 0, index, FALSE);
+      break;
+    case ORC_X86_INSN_TYPE_VEX_SSEM_SSE:
+    case ORC_X86_INSN_TYPE_VEX2_SSEM_SSE:
+    case ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM:
+      output_vex_opcode (p, xinsn);
       break;
     case ORC_X86_INSN_TYPE_ALIGN:
       {
@@ -650,6 +751,8 @@ orc_x86_insn_output_modrm (OrcCompiler *p, OrcX86Insn *xinsn)
     case ORC_X86_INSN_TYPE_MMXM_MMX:
     case ORC_X86_INSN_TYPE_IMM8_REGM_MMX:
     case ORC_X86_INSN_TYPE_IMM8_MMXM_MMX:
+    case ORC_X86_INSN_TYPE_VEX_SSEM_SSE:
+    case ORC_X86_INSN_TYPE_VEX2_SSEM_SSE:
       if (xinsn->type == ORC_X86_RM_REG) {
         orc_x86_emit_modrm_reg (p, xinsn->src, xinsn->dest);
       } else if (xinsn->type == ORC_X86_RM_MEMOFFSET) {
@@ -669,6 +772,7 @@ orc_x86_insn_output_modrm (OrcCompiler *p, OrcX86Insn *xinsn)
     case ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV:
     case ORC_X86_INSN_TYPE_REG8_REGM:
     case ORC_X86_INSN_TYPE_REG16_REGM:
+    case ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM:
       if (xinsn->type == ORC_X86_RM_REG) {
         orc_x86_emit_modrm_reg (p, xinsn->dest, xinsn->src);
       } else if (xinsn->type == ORC_X86_RM_MEMOFFSET) {
@@ -778,12 +882,15 @@ orc_x86_insn_output_immediate (OrcCompiler *p, OrcX86Insn *xinsn)
     case ORC_X86_INSN_TYPE_MMX_REGM_REV:
     case ORC_X86_INSN_TYPE_REG8_REGM:
     case ORC_X86_INSN_TYPE_REG16_REGM:
+    case ORC_X86_INSN_TYPE_VEX_SSEM_SSE:
+    case ORC_X86_INSN_TYPE_VEX2_SSEM_SSE:
       break;
     case ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT:
     case ORC_X86_INSN_TYPE_IMM8_REGM_MMX:
     case ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV:
     case ORC_X86_INSN_TYPE_IMM8_MMXM_MMX:
     case ORC_X86_INSN_TYPE_IMM8_REGM:
+    case ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM:
       *p->codeptr++ = xinsn->imm;
       break;
     case ORC_X86_INSN_TYPE_IMM32_REGM_MOV:
@@ -944,6 +1051,23 @@ orc_x86_emit_cpuinsn_size (OrcCompiler *p, int index, int size, int src, int des
   xinsn->size = size;
 }
 
+/* dest = op (dest, src2, src), VEX encoded */
+void
+orc_x86_emit_cpuinsn_vex (OrcCompiler *p, int index, int src, int src2,
+    int dest)
+{
+  OrcX86Insn *xinsn = orc_x86_get_output_insn (p);
+  const OrcSysOpcode *opcode = orc_x86_opcodes + index;
+
+  xinsn->opcode_index = index;
+  xinsn->opcode = opcode;
+  xinsn->src = src;
+  xinsn->src2 = src2;
+  xinsn->dest = dest;
+  xinsn->type = ORC_X86_RM_REG;
+  xinsn->size = 16;
+}
+
 void
 orc_x86_emit_cpuinsn_imm (OrcCompiler *p, int index, int imm, int src, int dest)
 {
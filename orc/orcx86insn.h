@@ -35,6 +35,9 @@ typedef enum {
   ORC_X86_INSN_TYPE_REG16_REGM,
   ORC_X86_INSN_TYPE_IMM32_A,
   ORC_X86_INSN_TYPE_IMM8_REGM_MMX,
+  ORC_X86_INSN_TYPE_VEX_SSEM_SSE,	/* mem/sse, sse (vvvv), sse */
+  ORC_X86_INSN_TYPE_VEX2_SSEM_SSE,	/* mem/sse, sse */
+  ORC_X86_INSN_TYPE_VEX2_IMM8_SSE_SSEM,	/* imm8, sse, mem/sse */
 } OrcX86InsnType;
 
 typedef enum {
@@ -280,6 +283,27 @@ typedef enum {
   ORC_X86_movq_mmx_store,
   ORC_X86_endbr32,
   ORC_X86_endbr64,
+  ORC_X86_vfmadd213ps,
+  ORC_X86_vfmadd213pd,
+  ORC_X86_vfmsub213ps,
+  ORC_X86_vfmsub213pd,
+  ORC_X86_vfnmadd213ps,
+  ORC_X86_vfnmadd213pd,
+  ORC_X86_vcvtph2ps,
+  ORC_X86_vcvtps2ph,
+  ORC_X86_roundps,
+  ORC_X86_rcpps,
+  ORC_X86_rsqrtps,
+  ORC_X86_cmpunordps,
+  ORC_X86_pblendvb,
+  ORC_X86_blendvps,
+  ORC_X86_blendvpd,
+  ORC_X86_pmovmskb,
+  ORC_X86_bsf,
+  ORC_X86_movsldup,
+  ORC_X86_movshdup,
+  ORC_X86_addsubps,
+  ORC_X86_haddps,
 } OrcX86Opcode;
 
 enum {
@@ -302,6 +326,7 @@ struct _OrcX86Insn {
   int index_reg;
   int shift;
   int code_offset;
+  int src2;
 };
 
 ORC_API OrcX86Insn * orc_x86_get_output_insn (OrcCompiler *p);
@@ -451,7 +476,7 @@ ORC_API void orc_x86_calculate_offsets (OrcCompiler *p);
 #define orc_sse_emit_pshufd(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_pshufd, imm, a, b)
 #define orc_sse_emit_pshuflw(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_pshuflw, imm, a, b)
 #define orc_sse_emit_pshufhw(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_pshufhw, imm, a, b)
-#define orc_sse_emit_palignr(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_psalignr, imm, a, b)
+#define orc_sse_emit_palignr(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_palignr, imm, a, b)
 #define orc_sse_emit_movdqu(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_movdqu_load, 16, a, b)
 
 #define orc_sse_emit_pinsrw_memoffset(p,imm,offset,a,b) orc_x86_emit_cpuinsn_load_memoffset(p, ORC_X86_pinsrw, 4, imm, offset, a, b)
@@ -490,6 +515,27 @@ ORC_API void orc_x86_calculate_offsets (OrcCompiler *p);
 #define orc_sse_emit_movd_store_register(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_movd_store, 4, a, b)
 #define orc_sse_emit_movq_store_register(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_movq_sse_store, 4, a, b)
 
+#define orc_sse_emit_vfmadd213ps(p,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vfmadd213ps, a, b, c)
+#define orc_sse_emit_vfmadd213pd(p,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vfmadd213pd, a, b, c)
+#define orc_sse_emit_vfmsub213ps(p,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vfmsub213ps, a, b, c)
+#define orc_sse_emit_vfmsub213pd(p,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vfmsub213pd, a, b, c)
+#define orc_sse_emit_vfnmadd213ps(p,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vfnmadd213ps, a, b, c)
+#define orc_sse_emit_vfnmadd213pd(p,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vfnmadd213pd, a, b, c)
+#define orc_sse_emit_vcvtph2ps(p,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vcvtph2ps, a, 0, b)
+#define orc_sse_emit_vcvtps2ph(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_vcvtps2ph, imm, a, b)
+#define orc_sse_emit_roundps(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_roundps, imm, a, b)
+#define orc_sse_emit_rcpps(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_rcpps, 16, a, b)
+#define orc_sse_emit_rsqrtps(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_rsqrtps, 16, a, b)
+#define orc_sse_emit_cmpunordps(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_cmpunordps, 16, a, b)
+#define orc_sse_emit_pblendvb(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_pblendvb, 16, a, b)
+#define orc_sse_emit_blendvps(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_blendvps, 16, a, b)
+#define orc_sse_emit_blendvpd(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_blendvpd, 16, a, b)
+#define orc_sse_emit_pmovmskb(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_pmovmskb, 16, a, b)
+#define orc_sse_emit_movsldup(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_movsldup, 16, a, b)
+#define orc_sse_emit_movshdup(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_movshdup, 16, a, b)
+#define orc_sse_emit_addsubps(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_addsubps, 16, a, b)
+#define orc_sse_emit_haddps(p,a,b) orc_x86_emit_cpuinsn_size(p, ORC_X86_haddps, 16, a, b)
+
 
 
 
@@ -633,7 +679,7 @@ ORC_API void orc_x86_calculate_offsets (OrcCompiler *p);
 #define orc_mmx_emit_pshufd(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_pshufd, imm, a, b)
 #define orc_mmx_emit_pshuflw(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_pshuflw, imm, a, b)
 #define orc_mmx_emit_pshufhw(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_pshufhw, imm, a, b)
-#define orc_mmx_emit_palignr(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_psalignr, imm, a, b)
+#define orc_mmx_emit_palignr(p,imm,a,b) orc_x86_emit_cpuinsn_imm(p, ORC_X86_palignr, imm, a, b)
 
 #define orc_mmx_emit_pinsrw_memoffset(p,imm,offset,a,b) orc_x86_emit_cpuinsn_load_memoffset(p, ORC_X86_pinsrw, 4, imm, offset, a, b)
 #define orc_mmx_emit_movd_load_memoffset(p,offset,a,b) orc_x86_emit_cpuinsn_load_memoffset(p, ORC_X86_movd_load, 4, 0, offset, a, b)
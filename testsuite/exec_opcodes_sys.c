@@ -2,6 +2,7 @@
 #include "config.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include <orc/orc.h>
 #include <orc-test/orctest.h>
@@ -91,6 +92,31 @@ main (int argc, char *argv[])
   return 0;
 }
 
+/* Sources s1, s2 and, for opcodes such as fmaf, s3 */
+static void
+add_sources (OrcProgram *p, OrcStaticOpcode *opcode)
+{
+  orc_program_add_source (p, opcode->src_size[0], "s1");
+  if (opcode->src_size[1] != 0) {
+    orc_program_add_source (p, opcode->src_size[1], "s2");
+  }
+  if (opcode->src_size[2] != 0) {
+    orc_program_add_source (p, opcode->src_size[2], "s3");
+  }
+}
+
+static void
+append_opcode (OrcProgram *p, OrcStaticOpcode *opcode)
+{
+  if (opcode->dest_size[1] != 0) {
+    orc_program_append_dds_str (p, opcode->name, "d1", "d2", "s1");
+  } else if (opcode->src_size[2] != 0) {
+    orc_program_append_str_2 (p, opcode->name, 0, "d1", "s1", "s2", "s3");
+  } else {
+    orc_program_append_str (p, opcode->name, "d1", "s1", "s2");
+  }
+}
+
 void
 test_opcode_src (OrcStaticOpcode *opcode)
 {
@@ -112,10 +138,7 @@ test_opcode_src (OrcStaticOpcode *opcode)
   if (opcode->dest_size[1] != 0) {
     orc_program_add_destination (p, opcode->dest_size[1], "d2");
   }
-  orc_program_add_source (p, opcode->src_size[0], "s1");
-  if (opcode->src_size[1] != 0) {
-    orc_program_add_source (p, opcode->src_size[1], "s2");
-  }
+  add_sources (p, opcode);
 
   if (opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
     flags = ORC_TEST_FLAGS_FLOAT;
@@ -124,11 +147,7 @@ test_opcode_src (OrcStaticOpcode *opcode)
   sprintf(s, "test_s_%s", opcode->name);
   orc_program_set_name (p, s);
 
-  if (opcode->dest_size[1] != 0) {
-    orc_program_append_dds_str (p, opcode->name, "d1", "d2", "s1");
-  } else {
-    orc_program_append_str (p, opcode->name, "d1", "s1", "s2");
-  }
+  append_opcode (p, opcode);
 
   ret = orc_test_compare_output_full (p, flags);
   if (!ret) {
@@ -186,6 +205,10 @@ test_opcode_const (OrcStaticOpcode *opcode)
 
   sprintf(s, "test_const_%s", opcode->name);
   orc_program_set_name (p, s);
+  /* bilinear loads find the second row through the source stride */
+  if (strncmp (opcode->name, "ldresbilin", 10) == 0) {
+    orc_program_set_2d (p);
+  }
 
   orc_program_append_2 (p, opcode->name, 0, args[0], args[1],
       args[2], args[3]);
@@ -246,6 +269,10 @@ test_opcode_param (OrcStaticOpcode *opcode)
 
   sprintf(s, "test_p_%s", opcode->name);
   orc_program_set_name (p, s);
+  /* bilinear loads find the second row through the source stride */
+  if (strncmp (opcode->name, "ldresbilin", 10) == 0) {
+    orc_program_set_2d (p);
+  }
 
   orc_program_append_2 (p, opcode->name, 0, args[0], args[1],
       args[2], args[3]);
@@ -309,7 +336,8 @@ test_opcode_src_2d (OrcStaticOpcode *opcode)
   int ret;
   int flags = 0;
 
-  if (opcode->flags & ORC_STATIC_OPCODE_SCALAR) {
+  /* a find stops the whole program, there is no 2D form */
+  if (opcode->flags & (ORC_STATIC_OPCODE_SCALAR|ORC_STATIC_OPCODE_FIND)) {
     return;
   }
 
@@ -322,10 +350,7 @@ test_opcode_src_2d (OrcStaticOpcode *opcode)
   if (opcode->dest_size[1] != 0) {
     orc_program_add_destination (p, opcode->dest_size[1], "d2");
   }
-  orc_program_add_source (p, opcode->src_size[0], "s1");
-  if (opcode->src_size[1] != 0) {
-    orc_program_add_source (p, opcode->src_size[1], "s2");
-  }
+  add_sources (p, opcode);
 
   if (opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
     flags = ORC_TEST_FLAGS_FLOAT;
@@ -335,11 +360,7 @@ test_opcode_src_2d (OrcStaticOpcode *opcode)
   orc_program_set_name (p, s);
   orc_program_set_2d (p);
 
-  if (opcode->dest_size[1] != 0) {
-    orc_program_append_dds_str (p, opcode->name, "d1", "d2", "s1");
-  } else {
-    orc_program_append_str (p, opcode->name, "d1", "s1", "s2");
-  }
+  append_opcode (p, opcode);
 
   ret = orc_test_compare_output_full (p, flags);
   if (!ret) {
@@ -371,10 +392,7 @@ test_opcode_src_const_n (OrcStaticOpcode *opcode)
   if (opcode->dest_size[1] != 0) {
     orc_program_add_destination (p, opcode->dest_size[1], "d2");
   }
-  orc_program_add_source (p, opcode->src_size[0], "s1");
-  if (opcode->src_size[1] != 0) {
-    orc_program_add_source (p, opcode->src_size[1], "s2");
-  }
+  add_sources (p, opcode);
 
   if (opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
     flags = ORC_TEST_FLAGS_FLOAT;
@@ -384,11 +402,7 @@ test_opcode_src_const_n (OrcStaticOpcode *opcode)
   orc_program_set_name (p, s);
   orc_program_set_constant_n (p, 8);
 
-  if (opcode->dest_size[1] != 0) {
-    orc_program_append_dds_str (p, opcode->name, "d1", "d2", "s1");
-  } else {
-    orc_program_append_str (p, opcode->name, "d1", "s1", "s2");
-  }
+  append_opcode (p, opcode);
 
   ret = orc_test_compare_output_full (p, flags);
   if (!ret) {
@@ -407,7 +421,8 @@ test_opcode_src_const_n_2d (OrcStaticOpcode *opcode)
   int ret;
   int flags = 0;
 
-  if (opcode->flags & ORC_STATIC_OPCODE_SCALAR) {
+  /* a find stops the whole program, there is no 2D form */
+  if (opcode->flags & (ORC_STATIC_OPCODE_SCALAR|ORC_STATIC_OPCODE_FIND)) {
     return;
   }
 
@@ -420,10 +435,7 @@ test_opcode_src_const_n_2d (OrcStaticOpcode *opcode)
   if (opcode->dest_size[1] != 0) {
     orc_program_add_destination (p, opcode->dest_size[1], "d2");
   }
-  orc_program_add_source (p, opcode->src_size[0], "s1");
-  if (opcode->src_size[1] != 0) {
-    orc_program_add_source (p, opcode->src_size[1], "s2");
-  }
+  add_sources (p, opcode);
 
   if (opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
     flags = ORC_TEST_FLAGS_FLOAT;
@@ -434,11 +446,7 @@ test_opcode_src_const_n_2d (OrcStaticOpcode *opcode)
   orc_program_set_2d (p);
   orc_program_set_constant_n (p, 8);
 
-  if (opcode->dest_size[1] != 0) {
-    orc_program_append_dds_str (p, opcode->name, "d1", "d2", "s1");
-  } else {
-    orc_program_append_str (p, opcode->name, "d1", "s1", "s2");
-  }
+  append_opcode (p, opcode);
 
   ret = orc_test_compare_output_full (p, flags);
   if (!ret) {
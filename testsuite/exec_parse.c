@@ -44,8 +44,19 @@ main (int argc, char *argv[])
   n = orc_parse (code, &programs);
 
   for(i=0;i<n;i++){
+    int flags = 0;
+    int j;
+
     if (verbose) printf("%s\n", programs[i]->name);
-    orc_test_compare_output_full (programs[i], 0);
+    for(j=0;j<programs[i]->n_insns;j++){
+      if (programs[i]->insns[j].opcode->flags & ORC_STATIC_OPCODE_FLOAT) {
+        flags = ORC_TEST_FLAGS_FLOAT;
+      }
+    }
+    if (!orc_test_compare_output_full (programs[i], flags)) {
+      printf("%s: test failed\n", programs[i]->name);
+      error = TRUE;
+    }
     orc_program_free (programs[i]);
   }
 
@@ -238,6 +238,25 @@ struct a ops[] = {
   { "convld", "a", "convert integer to double point" },
   { "convfd", "a", "convert float to double" },
   { "convdf", "a", "convert double to float" },
+  { "fmaf", "a * b + c", "fused multiply-add" },
+  { "fmsf", "a * b - c", "fused multiply-subtract" },
+  { "fnmaf", "c - a * b", "fused negated multiply-add" },
+  { "fmad", "a * b + c", "fused multiply-add" },
+  { "convhf", "a", "convert half to float" },
+  { "convfh", "a", "convert float to half" },
+  { "convbf", "a", "convert bfloat16 to float" },
+  { "convfb", "a", "convert float to bfloat16" },
+  { "roundf", "rint(a)", "round to nearest integer, halfway cases to even" },
+  { "floorf", "floor(a)", "round toward negative infinity" },
+  { "ceilf", "ceil(a)", "round toward positive infinity" },
+  { "truncf", "trunc(a)", "round toward zero" },
+  { "rcpf", "1/a", "reciprocal, within 2 ulp" },
+  { "rsqrtf", "1/sqrt(a)", "reciprocal square root, within 2 ulp" },
+  { "expf", "exp(a)", "exponential, within 1 ulp" },
+  { "logf", "log(a)", "natural logarithm, within 1 ulp" },
+  { "sinf", "sin(a)", "sine, within 2 ulp for |a| < 2^22" },
+  { "cosf", "cos(a)", "cosine, within 2 ulp for |a| < 2^22" },
+  { "powf", "exp(b*log(a))", "power, within 1 ulp" },
   
   { "loadb", "array[i]", "load from memory" },
   { "loadw", "array[i]", "load from memory" },
@@ -262,6 +281,55 @@ struct a ops[] = {
   { "ldreslinb", "special", "load, bilinear resampled" },
   { "ldresnearl", "array[(b+c*i)>>8]", "load, nearest neighbor resampled" },
   { "ldreslinl", "special", "load, bilinear resampled" },
+  { "loadch3b", "array[3*i+b]", "load one channel of 3-channel array" },
+  { "loadch4b", "array[4*i+b]", "load one channel of 4-channel array" },
+  { "loadch3w", "array[3*i+b]", "load one channel of 3-channel array" },
+  { "loadch4w", "array[4*i+b]", "load one channel of 4-channel array" },
+  { "storech3b", "special", "store 3 channels interleaved" },
+  { "storech3w", "special", "store 3 channels interleaved" },
+  { "loadstrb", "array[b*i]", "load every b-th element of array" },
+  { "loadstrw", "array[b*i]", "load every b-th element of array" },
+  { "loadstrl", "array[b*i]", "load every b-th element of array" },
+  { "loadstrq", "array[b*i]", "load every b-th element of array" },
+  { "storestrb", "special", "store to every b-th element of array" },
+  { "storestrw", "special", "store to every b-th element of array" },
+  { "storestrl", "special", "store to every b-th element of array" },
+  { "storestrq", "special", "store to every b-th element of array" },
+  { "scanaddw", "special", "running sum of a along the row" },
+  { "scanaddl", "special", "running sum of a along the row" },
+  { "scanaddf", "special", "running sum of a along the row" },
+  { "maddswl", "a.0 * b.0 + a.1 * b.1", "multiply pairs of signed words and add" },
+  { "maddusbw", "clamp(a.0 * b.0 + a.1 * b.1)", "multiply pairs of unsigned and signed bytes, saturated add" },
+  { "ldresbilinb", "special", "load, bilinear resampled from two rows" },
+  { "ldresbilinl", "special", "load, bilinear resampled from two rows" },
+  { "selectb", "(a &lt; 0) ? b : c", "select b where the sign bit of a is set, else c" },
+  { "selectw", "(a &lt; 0) ? b : c", "select b where the sign bit of a is set, else c" },
+  { "selectl", "(a &lt; 0) ? b : c", "select b where the sign bit of a is set, else c" },
+  { "selectf", "(a &lt; 0) ? b : c", "select b where the sign bit of a is set, else c" },
+  { "selectd", "(a &lt; 0) ? b : c", "select b where the sign bit of a is set, else c" },
+  { "unpacklb", "special", "unpack b-bit fields of a to 8 bytes" },
+  { "unpacklw", "special", "unpack b-bit fields of a to 4 words" },
+  { "packbl", "special", "pack low b bits of 8 bytes of a" },
+  { "packwl", "special", "pack low b bits of 4 words of a" },
+  { "popcntb", "popcount(a)", "number of bits set" },
+  { "popcntw", "popcount(a)", "number of bits set" },
+  { "popcntl", "popcount(a)", "number of bits set" },
+  { "clzw", "clz(a)", "number of leading zero bits" },
+  { "clzl", "clz(a)", "number of leading zero bits" },
+  { "bitrevb", "special", "reverse the order of the bits" },
+  { "shufflel", "special", "byte k is byte (b &gt;&gt; 4k) &amp; 15 of a, or 0" },
+  { "shuffleq", "special", "byte k is byte (b &gt;&gt; 4k) &amp; 15 of a, or 0" },
+  { "loadtrb", "array[i][j]", "load element j of row i into row j" },
+  { "loadtrw", "array[i][j]", "load element j of row i into row j" },
+  { "loadtrl", "array[i][j]", "load element j of row i into row j" },
+  { "loadtrq", "array[i][j]", "load element j of row i into row j" },
+  { "findb", "first i with a != 0, or n", "find first nonzero element, stop" },
+  { "findw", "first i with a != 0, or n", "find first nonzero element, stop" },
+  { "findl", "first i with a != 0, or n", "find first nonzero element, stop" },
+  { "mulcf", "a * b", "complex multiply, real part first" },
+  { "mulconjcf", "a * conj(b)", "complex multiply by the conjugate" },
+  { "magsqcf", "re(a)*re(a) + im(a)*im(a)", "complex magnitude squared" },
+  { "matrowlb", "clamp((4*b.0 + b.1*a.1 + b.2*a.2 + b.3*a.3)&gt;&gt;8)", "fixed-point color matrix row" },
   { "div255w", "a/255", "divide by 255" },
   { "divluw", "clamp(a/(b &amp; 255),0,255)", "saturated unsigned divide 16-bit by 8-bit" },
   { "splatw3q", "special", "duplicates high 16-bits to lower 48 bits" },
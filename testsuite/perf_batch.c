@@ -0,0 +1,167 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+#include <orc-test/orcprofile.h>
+
+/* Checks orc_code_run_batch() against the emulator, one job at a time,
+ * and compares the time for a batch of short jobs against calling
+ * orc_executor_run() for each of them. */
+
+#define N_JOBS 64
+#define MAX_N 64
+#define N_ROUNDS 5000
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (void)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_name (p, "batch_scale_addw");
+  orc_program_add_destination (p, 2, "d1");
+  orc_program_add_source (p, 2, "s1");
+  orc_program_add_accumulator (p, 2, "a1");
+  orc_program_add_parameter (p, 2, "p1");
+  orc_program_add_constant (p, 2, 3, "c1");
+  orc_program_add_temporary (p, 2, "t1");
+
+  orc_program_append (p, "mullw", ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_P1);
+  orc_program_append (p, "addw", ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_C1);
+  orc_program_append_ds (p, "accw", ORC_VAR_A1, ORC_VAR_T1);
+
+  return p;
+}
+
+static void
+setup_jobs (OrcBatchJob *jobs, orc_int16 *d, orc_int16 *s)
+{
+  int i;
+  int offset = 0;
+
+  memset (jobs, 0, sizeof(OrcBatchJob) * N_JOBS);
+  for(i=0;i<N_JOBS;i++){
+    /* a mix of lengths and alignments */
+    jobs[i].n = (i * 7) % MAX_N;
+    jobs[i].arrays[ORC_VAR_D1] = d + offset;
+    jobs[i].arrays[ORC_VAR_S1] = s + offset + (i & 3);
+    offset += MAX_N + 4;
+  }
+}
+
+static void
+check_batch (OrcProgram *p, OrcBatchJob *jobs, orc_int16 *d, orc_int16 *s,
+    int total)
+{
+  OrcExecutor *ex;
+  orc_int16 *ref;
+  unsigned int acc = 0;
+  int i, j;
+
+  ref = malloc (sizeof(orc_int16) * total);
+  memset (ref, 0, sizeof(orc_int16) * total);
+  memset (d, 0, sizeof(orc_int16) * total);
+
+  ex = orc_executor_new (p);
+  orc_executor_set_param (ex, ORC_VAR_P1, 5);
+  for(j=0;j<N_JOBS;j++){
+    orc_executor_set_n (ex, jobs[j].n);
+    orc_executor_set_array (ex, ORC_VAR_S1, jobs[j].arrays[ORC_VAR_S1]);
+    orc_executor_set_array (ex, ORC_VAR_D1,
+        ref + ((orc_int16 *)jobs[j].arrays[ORC_VAR_D1] - d));
+    orc_executor_emulate (ex);
+    acc += orc_executor_get_accumulator (ex, ORC_VAR_A1);
+  }
+  acc &= 0xffff;
+
+  orc_code_run_batch (p->orccode, ex, jobs, N_JOBS);
+
+  for(i=0;i<total;i++){
+    if (d[i] != ref[i]) {
+      printf("mismatch at %d (%d != %d)\n", i, d[i], ref[i]);
+      error = TRUE;
+      break;
+    }
+  }
+  if ((unsigned int)orc_executor_get_accumulator (ex, ORC_VAR_A1) != acc) {
+    printf("accumulator mismatch (%d != %d)\n",
+        orc_executor_get_accumulator (ex, ORC_VAR_A1), acc);
+    error = TRUE;
+  }
+
+  orc_executor_free (ex);
+  free (ref);
+}
+
+int
+main (int argc, char *argv[])
+{
+  OrcProgram *p;
+  OrcCompileResult result;
+  OrcExecutor *ex;
+  OrcBatchJob jobs[N_JOBS];
+  orc_int16 *d, *s;
+  OrcProfile prof_single, prof_batch;
+  double t_single, t_batch;
+  double std;
+  int total;
+  int i, j;
+
+  orc_init ();
+  orc_test_init ();
+
+  total = N_JOBS * (MAX_N + 4);
+  d = malloc (sizeof(orc_int16) * total);
+  s = malloc (sizeof(orc_int16) * total);
+  for(i=0;i<total;i++){
+    s[i] = i * 37;
+  }
+
+  p = create_program ();
+  result = orc_program_compile (p);
+  if (!ORC_COMPILE_RESULT_IS_SUCCESSFUL (result)) {
+    printf("compile failed, measuring emulation\n");
+  }
+
+  setup_jobs (jobs, d, s);
+  check_batch (p, jobs, d, s, total);
+
+  ex = orc_executor_new (p);
+  orc_executor_set_param (ex, ORC_VAR_P1, 5);
+
+  orc_profile_init (&prof_single);
+  orc_profile_init (&prof_batch);
+  for(i=0;i<N_ROUNDS;i++){
+    orc_profile_start (&prof_single);
+    for(j=0;j<N_JOBS;j++){
+      orc_executor_set_n (ex, jobs[j].n);
+      orc_executor_set_array (ex, ORC_VAR_D1, jobs[j].arrays[ORC_VAR_D1]);
+      orc_executor_set_array (ex, ORC_VAR_S1, jobs[j].arrays[ORC_VAR_S1]);
+      orc_executor_run (ex);
+    }
+    orc_profile_stop (&prof_single);
+
+    orc_profile_start (&prof_batch);
+    orc_code_run_batch (p->orccode, ex, jobs, N_JOBS);
+    orc_profile_stop (&prof_batch);
+  }
+  orc_profile_get_ave_std (&prof_single, &t_single, &std);
+  orc_profile_get_ave_std (&prof_batch, &t_batch, &std);
+
+  printf("orc_executor_run:   %8.2f ticks/job\n", t_single / N_JOBS);
+  printf("orc_code_run_batch: %8.2f ticks/job\n", t_batch / N_JOBS);
+
+  orc_executor_free (ex);
+  orc_program_free (p);
+  free (d);
+  free (s);
+
+  if (error) return 1;
+  return 0;
+}
+
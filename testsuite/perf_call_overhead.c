@@ -0,0 +1,164 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+#include <orc-test/orcprofile.h>
+
+/* Measures the fixed per-call cost of compiled code for short arrays,
+ * next to the same program compiled without the small-n path, and
+ * checks both against the emulator for every n. */
+
+#define MAX_N 64
+#define N_ROUNDS 100
+#define N_CALLS 1000
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (void)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_name (p, "call_overhead_addw");
+  orc_program_add_destination (p, 2, "d1");
+  orc_program_add_source (p, 2, "s1");
+  orc_program_add_source (p, 2, "s2");
+
+  orc_program_append (p, "addw", ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_S2);
+
+  return p;
+}
+
+static void
+check_program (OrcProgram *p, orc_int16 *d, orc_int16 *s1, orc_int16 *s2)
+{
+  OrcExecutor *ex;
+  orc_int16 ref[MAX_N + 1];
+  int n;
+  int i;
+
+  ex = orc_executor_new (p);
+  for(n=1;n<=MAX_N;n++){
+    /* offset by one element to exercise the unaligned paths too */
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_S1, s1 + 1);
+    orc_executor_set_array (ex, ORC_VAR_S2, s2 + 1);
+
+    orc_executor_set_array (ex, ORC_VAR_D1, ref);
+    orc_executor_emulate (ex);
+
+    memset (d, 0, sizeof(orc_int16) * (MAX_N + 2));
+    orc_executor_set_array (ex, ORC_VAR_D1, d + 1);
+    orc_executor_run (ex);
+
+    for(i=0;i<n;i++){
+      if (d[i+1] != ref[i]) {
+        printf("n=%d: mismatch at %d (%d != %d)\n", n, i, d[i+1], ref[i]);
+        error = TRUE;
+        break;
+      }
+    }
+    if (d[n+1] != 0) {
+      printf("n=%d: wrote past end of array\n", n);
+      error = TRUE;
+    }
+  }
+  orc_executor_free (ex);
+}
+
+static double
+time_calls (OrcProgram *p, int n, orc_int16 *d, orc_int16 *s1, orc_int16 *s2)
+{
+  OrcExecutor *ex;
+  OrcProfile prof;
+  double ave, std;
+  int i, j;
+
+  ex = orc_executor_new (p);
+  orc_executor_set_n (ex, n);
+  orc_executor_set_array (ex, ORC_VAR_D1, d);
+  orc_executor_set_array (ex, ORC_VAR_S1, s1);
+  orc_executor_set_array (ex, ORC_VAR_S2, s2);
+
+  orc_profile_init (&prof);
+  for(i=0;i<N_ROUNDS;i++){
+    orc_profile_start (&prof);
+    for(j=0;j<N_CALLS;j++){
+      orc_executor_run (ex);
+    }
+    orc_profile_stop (&prof);
+  }
+  orc_profile_get_ave_std (&prof, &ave, &std);
+  orc_executor_free (ex);
+
+  return ave / N_CALLS;
+}
+
+int
+main (int argc, char *argv[])
+{
+  OrcProgram *p, *p_split;
+  OrcTarget *target;
+  unsigned int flags;
+  OrcCompileResult result;
+  orc_int16 *d, *s1, *s2;
+  int n;
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  d = malloc (sizeof(orc_int16) * (MAX_N + 2));
+  s1 = malloc (sizeof(orc_int16) * (MAX_N + 2));
+  s2 = malloc (sizeof(orc_int16) * (MAX_N + 2));
+  for(i=0;i<MAX_N+2;i++){
+    s1[i] = i * 37;
+    s2[i] = 1000 - i * 11;
+  }
+
+  target = orc_target_get_default ();
+  flags = orc_target_get_default_flags (target);
+
+  p = create_program ();
+  result = orc_program_compile_full (p, target, flags);
+  if (!ORC_COMPILE_RESULT_IS_SUCCESSFUL (result)) {
+    printf("compile failed, measuring emulation\n");
+  }
+
+  /* the same program, always going through the region split */
+  if (target && strcmp (orc_target_get_name (target), "sse") == 0) {
+    flags &= ~ORC_TARGET_SSE_SMALL_N;
+  } else if (target && strcmp (orc_target_get_name (target), "mmx") == 0) {
+    flags &= ~ORC_TARGET_MMX_SMALL_N;
+  }
+  p_split = create_program ();
+  orc_program_compile_full (p_split, target, flags);
+
+  check_program (p, d, s1, s2);
+  check_program (p_split, d, s1, s2);
+
+  printf("#   n  small-n ticks/call  split ticks/call\n");
+  for(n=1;n<=MAX_N;n++){
+    double t_small, t_split;
+
+    t_small = time_calls (p, n, d, s1, s2);
+    t_split = time_calls (p_split, n, d, s1, s2);
+
+    printf("%5d %19.2f %17.2f\n", n, t_small, t_split);
+    fflush (stdout);
+  }
+
+  orc_program_free (p);
+  orc_program_free (p_split);
+  free (d);
+  free (s1);
+  free (s2);
+
+  if (error) return 1;
+  return 0;
+}
+
@@ -0,0 +1,142 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ORC_ENABLE_UNSTABLE_API
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+#include <orc-test/orcprofile.h>
+
+/* Runs a long 1D program split across worker threads, and checks the
+ * destination and accumulator against the same program compiled with
+ * parallel execution disabled. */
+
+#define N (4*1024*1024 + 13)
+#define N_THREADS 4
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (void)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_name (p, "parallel_gain");
+  orc_program_add_destination (p, 2, "d1");
+  orc_program_add_source (p, 2, "s1");
+  orc_program_add_accumulator (p, 4, "a1");
+  orc_program_add_parameter (p, 2, "p1");
+  orc_program_add_temporary (p, 4, "t1");
+
+  orc_program_append (p, "mullw", ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_P1);
+  orc_program_append_ds (p, "convuwl", ORC_VAR_T1, ORC_VAR_D1);
+  orc_program_append_ds (p, "accl", ORC_VAR_A1, ORC_VAR_T1);
+
+  return p;
+}
+
+static double
+run (OrcProgram *p, orc_int16 *d, orc_int16 *s, int *acc)
+{
+  OrcExecutor *ex;
+  OrcProfile prof;
+  double ave, std;
+  int i;
+
+  ex = orc_executor_new (p);
+  orc_executor_set_n (ex, N);
+  orc_executor_set_array (ex, ORC_VAR_D1, d);
+  orc_executor_set_array (ex, ORC_VAR_S1, s + 1);
+  orc_executor_set_param (ex, ORC_VAR_P1, 3);
+
+  /* the first call faults in the destination pages */
+  orc_executor_run (ex);
+
+  orc_profile_init (&prof);
+  for(i=0;i<5;i++){
+    orc_profile_start (&prof);
+    orc_executor_run (ex);
+    orc_profile_stop (&prof);
+  }
+  orc_profile_get_ave_std (&prof, &ave, &std);
+  *acc = orc_executor_get_accumulator (ex, ORC_VAR_A1);
+  orc_executor_free (ex);
+
+  return ave;
+}
+
+int
+main (int argc, char *argv[])
+{
+  OrcProgram *serial, *parallel;
+  orc_int16 *d, *ref, *s;
+  int acc, ref_acc;
+  double t_serial, t_parallel;
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  d = malloc (sizeof(orc_int16) * N);
+  ref = malloc (sizeof(orc_int16) * N);
+  s = malloc (sizeof(orc_int16) * (N + 1));
+  for(i=0;i<N+1;i++){
+    s[i] = i * 37;
+  }
+
+  orc_parallel_set_n_threads (1);
+  serial = create_program ();
+  orc_program_compile (serial);
+
+  orc_parallel_set_n_threads (N_THREADS);
+  parallel = create_program ();
+  orc_program_compile (parallel);
+
+  t_serial = run (serial, ref, s, &ref_acc);
+  t_parallel = run (parallel, d, s, &acc);
+
+  if (memcmp (d, ref, sizeof(orc_int16) * N) != 0) {
+    printf("destination mismatch\n");
+    error = TRUE;
+  }
+  if (acc != ref_acc) {
+    printf("accumulator mismatch (%d != %d)\n", acc, ref_acc);
+    error = TRUE;
+  }
+
+  /* like the wrappers orcc generates without --code: the program is
+   * set, arrays[ORC_VAR_A2] is left uninitialized */
+  {
+    OrcExecutor _ex, *ex = &_ex;
+
+    memset (d, 0, sizeof(orc_int16) * N);
+    memset (ex, 0xaa, sizeof(OrcExecutor));
+    ex->program = parallel;
+    ex->n = N;
+    ex->arrays[ORC_VAR_D1] = d;
+    ex->arrays[ORC_VAR_S1] = s + 1;
+    ex->params[ORC_VAR_P1] = 3;
+    ((void (*)(OrcExecutor *))parallel->code_exec) (ex);
+    if (memcmp (d, ref, sizeof(orc_int16) * N) != 0) {
+      printf("destination mismatch without arrays[ORC_VAR_A2]\n");
+      error = TRUE;
+    }
+  }
+
+  printf("serial:   %12g ticks\n", t_serial);
+  printf("parallel: %12g ticks (%d threads)\n", t_parallel,
+      orc_parallel_get_n_threads ());
+
+  orc_program_free (serial);
+  orc_program_free (parallel);
+  free (d);
+  free (ref);
+  free (s);
+
+  if (error) return 1;
+  return 0;
+}
+
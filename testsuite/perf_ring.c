@@ -0,0 +1,146 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+#include <orc-test/orcprofile.h>
+
+/* Reads a short ring buffer over a long call, and compares the time
+ * against splitting the call at each wrap in the caller and running the
+ * same program without a ring once per range.  Both must give the same
+ * destination. */
+
+#define N 4096
+#define N_ROUNDS 200
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (int ring)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_name (p, ring ? "ring_addssw" : "split_addssw");
+  orc_program_add_destination (p, 2, "d1");
+  orc_program_add_source (p, 2, "s1");
+  orc_program_add_source (p, 2, "s2");
+  if (ring) orc_program_set_var_ring (p, ORC_VAR_S1);
+
+  orc_program_append (p, "addssw", ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_S2);
+
+  return p;
+}
+
+static double
+time_ring (OrcProgram *p, orc_int16 *d, orc_int16 *s1, orc_int16 *s2,
+    int size)
+{
+  OrcExecutor *ex;
+  OrcProfile prof;
+  double ave, std;
+  int i;
+
+  ex = orc_executor_new (p);
+  orc_profile_init (&prof);
+  for(i=0;i<N_ROUNDS;i++){
+    orc_executor_set_n (ex, N);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_S1, s1);
+    orc_executor_set_array (ex, ORC_VAR_S2, s2);
+    orc_executor_set_ring (ex, ORC_VAR_S1, size, size / 2);
+    orc_profile_start (&prof);
+    orc_executor_run (ex);
+    orc_profile_stop (&prof);
+  }
+  orc_profile_get_ave_std (&prof, &ave, &std);
+  orc_executor_free (ex);
+
+  return ave;
+}
+
+static double
+time_split (OrcProgram *p, orc_int16 *d, orc_int16 *s1, orc_int16 *s2,
+    int size)
+{
+  OrcExecutor *ex;
+  OrcProfile prof;
+  double ave, std;
+  int done, pos, n;
+  int i;
+
+  ex = orc_executor_new (p);
+  orc_profile_init (&prof);
+  for(i=0;i<N_ROUNDS;i++){
+    orc_profile_start (&prof);
+    pos = size / 2;
+    for(done=0;done<N;done+=n){
+      n = N - done;
+      if (n > size - pos) n = size - pos;
+      orc_executor_set_n (ex, n);
+      orc_executor_set_array (ex, ORC_VAR_D1, d + done);
+      orc_executor_set_array (ex, ORC_VAR_S1, s1 + pos);
+      orc_executor_set_array (ex, ORC_VAR_S2, s2 + done);
+      orc_executor_run (ex);
+      pos += n;
+      if (pos == size) pos = 0;
+    }
+    orc_profile_stop (&prof);
+  }
+  orc_profile_get_ave_std (&prof, &ave, &std);
+  orc_executor_free (ex);
+
+  return ave;
+}
+
+int
+main (int argc, char *argv[])
+{
+  OrcProgram *p_ring, *p_split;
+  orc_int16 *d, *ref, *s1, *s2;
+  int size;
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  d = malloc (sizeof(orc_int16) * N);
+  ref = malloc (sizeof(orc_int16) * N);
+  s1 = malloc (sizeof(orc_int16) * N);
+  s2 = malloc (sizeof(orc_int16) * N);
+  for(i=0;i<N;i++){
+    s1[i] = i * 1217;
+    s2[i] = i * 37;
+  }
+
+  p_ring = create_program (TRUE);
+  orc_program_compile (p_ring);
+  p_split = create_program (FALSE);
+  orc_program_compile (p_split);
+
+  printf("# size  ring ticks/call  split ticks/call\n");
+  for(size=13;size<=N;size*=3){
+    double t_ring, t_split;
+
+    t_ring = time_ring (p_ring, d, s1, s2, size);
+    t_split = time_split (p_split, ref, s1, s2, size);
+    if (memcmp (d, ref, sizeof(orc_int16) * N) != 0) {
+      printf("size %d: destination mismatch\n", size);
+      error = TRUE;
+    }
+
+    printf("%6d %16.0f %17.0f\n", size, t_ring, t_split);
+  }
+
+  orc_program_free (p_ring);
+  orc_program_free (p_split);
+  free (d);
+  free (ref);
+  free (s1);
+  free (s2);
+
+  if (error) return 1;
+  return 0;
+}
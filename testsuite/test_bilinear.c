@@ -0,0 +1,144 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Bilinear loads read the next row through the source stride, which a
+ * 1D program does not have, so they must not compile there.  In 2D the
+ * result is a horizontal pass on both rows followed by a vertical one,
+ * with the position restarting at each row. */
+
+#define N 67
+#define M 3
+#define WIDTH (2 * N + 4)
+
+int error = FALSE;
+
+static int
+lerp (int a, int b, int frac)
+{
+  return (a * (256 - frac) + b * frac) >> 8;
+}
+
+static void
+check (int size, int n, int x, int y, int inc)
+{
+  const char *opcode = (size == 1) ? "ldresbilinb" : "ldresbilinl";
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 s[WIDTH * 4 * (M + 1)];
+  orc_uint8 d[N * 4 * M];
+  int emulate;
+  int i, j;
+
+  p = orc_program_new ();
+  orc_program_set_2d (p);
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_parameter_int64 (p, 8, "p1");
+  orc_program_add_parameter (p, 4, "p2");
+  orc_program_append_2 (p, opcode, 0, ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_P1,
+      ORC_VAR_P2);
+  orc_program_compile (p);
+
+  /* one more row than the output, the last is only read as the next */
+  for(i=0;i<sizeof(s);i++){
+    s[i] = i * 89 + (i >> 7) * 31;
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, sizeof(d));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_m (ex, M);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_stride (ex, ORC_VAR_D1, N * size);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_stride (ex, ORC_VAR_S1, WIDTH * size);
+    orc_executor_set_param_int64 (ex, ORC_VAR_P1,
+        ((orc_int64)y << 32) | (orc_uint32)x);
+    orc_executor_set_param (ex, ORC_VAR_P2, inc);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(j=0;j<M;j++){
+      const orc_uint8 *row0 = s + j * WIDTH * size;
+      const orc_uint8 *row1 = row0 + WIDTH * size;
+
+      for(i=0;i<n*size;i++){
+        int tmp = x + (i / size) * inc;
+        int frac = (tmp >> 8) & 0xff;
+        int ix = (tmp >> 16) * size + i % size;
+        int h0 = lerp (row0[ix], row0[ix + size], frac);
+        int h1 = lerp (row1[ix], row1[ix + size], frac);
+        int expected = lerp (h0, h1, (y >> 8) & 0xff);
+
+        if (d[j * N * size + i] != expected) {
+          printf("%s n %d x 0x%x y 0x%x inc 0x%x: row %d byte %d is %d, "
+              "expected %d%s\n", opcode, n, x, y, inc, j, i,
+              d[j * N * size + i], expected, emulate ? " (emulated)" : "");
+          error = TRUE;
+          break;
+        }
+      }
+    }
+  }
+
+  orc_program_free (p);
+}
+
+static void
+check_1d (int size)
+{
+  const char *opcode = (size == 1) ? "ldresbilinb" : "ldresbilinl";
+  OrcProgram *p;
+  int result;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_parameter_int64 (p, 8, "p1");
+  orc_program_add_parameter (p, 4, "p2");
+  orc_program_append_2 (p, opcode, 0, ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_P1,
+      ORC_VAR_P2);
+  result = orc_program_compile (p);
+  if (ORC_COMPILE_RESULT_IS_SUCCESSFUL (result)) {
+    printf("%s: compiled in a 1D program\n", opcode);
+    error = TRUE;
+  }
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 8, 16, 17, 33, N };
+  static const int incs[] = { 0x10000, 0x8000, 0x5555, 0x18000, 0x1ff00 };
+  static const int ys[] = { 0, 0x80, 0x4000, 0xff00, 0x3c000 };
+  int i, j;
+
+  orc_init ();
+  orc_test_init ();
+
+  check_1d (1);
+  check_1d (4);
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(j=0;j<sizeof(incs)/sizeof(incs[0]);j++){
+      check (1, ns[i], 0x4000, ys[j], incs[j]);
+      check (4, ns[i], 0x4000, ys[j], incs[j]);
+      check (4, ns[i], 0x2ff80, ys[(j + 3) % 5], incs[j]);
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
+
@@ -0,0 +1,181 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Known popcount, leading zero count and bit reversal results,
+ * starting with zero, all ones and the top bit alone.  The 7 values
+ * repeat along the array, so each reaches every lane, and their
+ * popcounts also go through accl, where the total is the sum of the
+ * table entries. */
+
+#define N 100
+#define N_CASES 7
+
+int error = FALSE;
+
+static const struct {
+  const char *name;
+  int size;
+  orc_uint32 in[N_CASES];
+  orc_uint32 out[N_CASES];
+} ops[] = {
+  { "popcntb", 1, { 0, 0xff, 0x80, 0x81, 0x10, 0x7e, 0x55 },
+    { 0, 8, 1, 2, 1, 6, 4 } },
+  { "popcntw", 2, { 0, 0xffff, 0x8000, 0x8001, 0x1234, 0x00ff, 0xf0f0 },
+    { 0, 16, 1, 2, 5, 8, 8 } },
+  { "popcntl", 4, { 0, 0xffffffff, 0x80000000, 0x7fffffff, 0x55555555,
+      0x12345678, 0xff }, { 0, 32, 1, 31, 16, 13, 8 } },
+  { "clzw", 2, { 0, 0xffff, 0x8000, 1, 0x00ff, 0x0100, 0x7fff },
+    { 16, 0, 0, 15, 8, 7, 1 } },
+  { "clzl", 4, { 0, 0xffffffff, 0x80000000, 1, 0x10000, 0x800000, 0xffff },
+    { 32, 0, 0, 31, 15, 8, 16 } },
+  { "bitrevb", 1, { 0, 0xff, 0x80, 0x01, 0xf0, 0x12, 0x0b },
+    { 0, 0xff, 0x01, 0x80, 0x0f, 0x48, 0xd0 } }
+};
+
+static void
+fill (orc_uint8 *p, int size, const orc_uint32 *values)
+{
+  int i;
+
+  for(i=0;i<N;i++){
+    orc_uint32 x = values[i % N_CASES];
+
+    /* little endian, as the tests run */
+    memcpy (p + i * size, &x, size);
+  }
+}
+
+static void
+check (int op, int flags, int n)
+{
+  int size = ops[op].size;
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 s[N * 4], d[N * 4], ref[N * 4];
+  int emulate;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_append_ds_str (p, ops[op].name, "d1", "s1");
+  orc_program_compile_full (p, orc_target_get_default (), flags);
+
+  fill (s, size, ops[op].in);
+  fill (ref, size, ops[op].out);
+  memset (ref + n * size, 0, (N - n) * size);
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, sizeof(d));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (d, ref, N * size) != 0) {
+      printf("%s flags 0x%x n %d: mismatch%s\n", ops[op].name, flags, n,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  orc_program_free (p);
+}
+
+/* op is popcntb or popcntl */
+static void
+check_sum (int op, int flags, int n)
+{
+  int size = ops[op].size;
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 s[N * 4];
+  int total = 0;
+  int emulate;
+  int i;
+
+  p = orc_program_new ();
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_accumulator (p, 4, "a1");
+  orc_program_add_temporary (p, size, "t1");
+  orc_program_append_ds_str (p, ops[op].name, "t1", "s1");
+  if (size == 1) {
+    orc_program_add_temporary (p, 2, "t2");
+    orc_program_add_temporary (p, 4, "t3");
+    orc_program_append_ds_str (p, "convubw", "t2", "t1");
+    orc_program_append_ds_str (p, "convuwl", "t3", "t2");
+    orc_program_append_ds_str (p, "accl", "a1", "t3");
+  } else {
+    orc_program_append_ds_str (p, "accl", "a1", "t1");
+  }
+  orc_program_compile_full (p, orc_target_get_default (), flags);
+
+  fill (s, size, ops[op].in);
+  for(i=0;i<n;i++){
+    total += ops[op].out[i % N_CASES];
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    if (orc_executor_get_accumulator (ex, ORC_VAR_A1) != total) {
+      printf("%s sum flags 0x%x n %d: %d, expected %d%s\n", ops[op].name,
+          flags, n, orc_executor_get_accumulator (ex, ORC_VAR_A1), total,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+    orc_executor_free (ex);
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 6, 15, 16, 17, 33, N };
+  OrcTarget *target;
+  int flags[2];
+  int n_flags = 1;
+  int i, j, op;
+
+  orc_init ();
+  orc_test_init ();
+
+  target = orc_target_get_default ();
+  flags[0] = orc_target_get_default_flags (target);
+  /* also the rules without pshufb */
+  if (strcmp (orc_target_get_name (target), "sse") == 0 &&
+      (flags[0] & ORC_TARGET_SSE_SSSE3)) {
+    flags[n_flags++] = flags[0] & ~(ORC_TARGET_SSE_SSSE3 |
+        ORC_TARGET_SSE_SSE4_1 | ORC_TARGET_SSE_SSE4_2);
+  }
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(j=0;j<n_flags;j++){
+      for(op=0;op<sizeof(ops)/sizeof(ops[0]);op++){
+        check (op, flags[j], ns[i]);
+      }
+      check_sum (0, flags[j], ns[i]);
+      check_sum (2, flags[j], ns[i]);
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
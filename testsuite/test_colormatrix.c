@@ -0,0 +1,159 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* BT.601 AYUV to ARGB with one matrowlb per channel, against the usual
+ * integer formula
+ *   R = clamp ((298 (Y - 16) + 409 (V - 128) + 128) >> 8)
+ *   G = clamp ((298 (Y - 16) - 100 (U - 128) - 208 (V - 128) + 128) >> 8)
+ *   B = clamp ((298 (Y - 16) + 516 (U - 128) + 128) >> 8)
+ * which maps video black, white and red to 000000, ffffff and ff0000.
+ * d2 reads the same pixels as ARGB and computes the luma with one
+ * constant row. */
+
+#define N 100
+
+int error = FALSE;
+
+static orc_int64
+row (int offset, int c1, int c2, int c3)
+{
+  return (orc_uint16)offset | ((orc_uint64)(orc_uint16)c1 << 16) |
+    ((orc_uint64)(orc_uint16)c2 << 32) | ((orc_uint64)(orc_uint16)c3 << 48);
+}
+
+static int
+clamp (int x)
+{
+  return (x < 0) ? 0 : ((x > 255) ? 255 : x);
+}
+
+static void
+check (OrcProgram *p, int n)
+{
+  static const orc_uint8 known[3][2][4] = {
+    { { 0xff, 16, 128, 128 }, { 0xff, 0x00, 0x00, 0x00 } },
+    { { 0x80, 235, 128, 128 }, { 0x80, 0xff, 0xff, 0xff } },
+    { { 0x00, 81, 90, 240 }, { 0x00, 0xff, 0x00, 0x00 } }
+  };
+  OrcExecutor *ex;
+  orc_uint8 s[N * 4], d[N * 4], luma[N];
+  int emulate;
+  int i;
+
+  for(i=0;i<N*4;i++){
+    s[i] = i * 97 + (i >> 2) * 13;
+  }
+  for(i=0;i<3;i++){
+    memcpy (s + 4 * i, known[i][0], 4);
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, sizeof(d));
+    memset (luma, 0, sizeof(luma));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_D2, luma);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    /* offsets in 1/64, rounding included */
+    orc_executor_set_param_int64 (ex, ORC_VAR_P1, row (-14248, 298, 0, 409));
+    orc_executor_set_param_int64 (ex, ORC_VAR_P2, row (8696, 298, -100, -208));
+    orc_executor_set_param_int64 (ex, ORC_VAR_P3, row (-17672, 298, 516, 0));
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      const orc_uint8 *x = s + 4 * i;
+      int y = x[1] - 16, u = x[2] - 128, v = x[3] - 128;
+      orc_uint8 ref[4];
+      int ref_luma;
+
+      ref[0] = x[0];
+      ref[1] = clamp ((298 * y + 409 * v + 128) >> 8);
+      ref[2] = clamp ((298 * y - 100 * u - 208 * v + 128) >> 8);
+      ref[3] = clamp ((298 * y + 516 * u + 128) >> 8);
+      if (i < 3 && memcmp (d + 4 * i, known[i][1], 4) != 0) {
+        printf("n %d: known pixel %d wrong%s\n", n, i,
+            emulate ? " (emulated)" : "");
+        error = TRUE;
+      }
+      ref_luma = clamp ((66 * x[1] + 129 * x[2] + 25 * x[3] + 4224) >> 8);
+      if (memcmp (d + 4 * i, ref, 4) != 0 || luma[i] != ref_luma) {
+        printf("n %d, pixel %d: %02x%02x%02x%02x -> %02x%02x%02x%02x %d, "
+            "expected %02x%02x%02x%02x %d%s\n", n, i, x[0], x[1], x[2], x[3],
+            d[4*i], d[4*i+1], d[4*i+2], d[4*i+3], luma[i],
+            ref[0], ref[1], ref[2], ref[3], ref_luma,
+            emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+    if (n < N && (d[4 * n] != 0 || luma[n] != 0)) {
+      printf("n %d: pixel %d written%s\n", n, n,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 4, 8, 15, 16, 17, 33, N };
+  OrcProgram **programs;
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  /* the luma row is 16 + (66 r + 129 g + 25 b + 128) / 256, as
+   * (offset, r, g, b) */
+  if (orc_parse (".function ayuv_to_argb\n"
+      ".dest 4 d1\n"
+      ".dest 1 d2\n"
+      ".source 4 s1\n"
+      ".longparam 8 pr\n"
+      ".longparam 8 pg\n"
+      ".longparam 8 pb\n"
+      ".const 8 c1 0x0019008100420420\n"
+      ".temp 1 r\n"
+      ".temp 1 g\n"
+      ".temp 1 b\n"
+      ".temp 1 a\n"
+      ".temp 2 t\n"
+      ".temp 2 ar\n"
+      ".temp 2 gb\n"
+      "\n"
+      "matrowlb r, s1, pr\n"
+      "matrowlb g, s1, pg\n"
+      "matrowlb b, s1, pb\n"
+      "convlw t, s1\n"
+      "convwb a, t\n"
+      "mergebw ar, a, r\n"
+      "mergebw gb, g, b\n"
+      "mergewl d1, ar, gb\n"
+      "matrowlb d2, s1, c1\n", &programs) != 1) {
+    printf("failed to parse\n");
+    exit (1);
+  }
+  orc_program_compile (programs[0]);
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    check (programs[0], ns[i]);
+  }
+
+  orc_program_free (programs[0]);
+  free (programs);
+
+  if (error) return 1;
+  return 0;
+}
@@ -0,0 +1,130 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Known products of interleaved complex floats.  The parts are small
+ * binary fractions, so every product and sum is exact and the results
+ * must match to the bit, and a * conj(a) must be |a|^2 with a zero
+ * imaginary part. */
+
+#define N 100
+#define N_CASES 7
+
+int error = FALSE;
+
+static const struct {
+  float a[2], b[2];
+  float mul[2], mulconj[2];
+  float magsq;
+} cases[N_CASES] = {
+  { { 1, 2 }, { 3, 4 }, { -5, 10 }, { 11, 2 }, 5 },
+  { { 0, 1 }, { 0, 1 }, { -1, 0 }, { 1, 0 }, 1 },
+  { { -2, 0.5 }, { 4, -8 }, { -4, 18 }, { -12, -14 }, 4.25 },
+  { { 0, 0 }, { 5, -3 }, { 0, 0 }, { 0, 0 }, 0 },
+  { { 3, -4 }, { 3, 4 }, { 25, 0 }, { -7, -24 }, 25 },
+  { { -1.5, -2.5 }, { -2, 6 }, { 18, -4 }, { -12, 14 }, 8.5 },
+  { { 64, -0.25 }, { 0.5, 2 }, { 32.5, 127.875 }, { 31.5, -128.125 },
+    4096.0625 }
+};
+
+static void
+check (OrcProgram *p, int n)
+{
+  OrcExecutor *ex;
+  float a[2 * N], b[2 * N];
+  float mul[2 * N], mulconj[2 * N], magsq[N], self[2 * N];
+  int emulate;
+  int i;
+
+  for(i=0;i<N;i++){
+    memcpy (a + 2 * i, cases[i % N_CASES].a, 8);
+    memcpy (b + 2 * i, cases[i % N_CASES].b, 8);
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (mul, 0, sizeof(mul));
+    memset (mulconj, 0, sizeof(mulconj));
+    memset (magsq, 0, sizeof(magsq));
+    memset (self, 0, sizeof(self));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, mul);
+    orc_executor_set_array (ex, ORC_VAR_D2, mulconj);
+    orc_executor_set_array (ex, ORC_VAR_D3, magsq);
+    orc_executor_set_array (ex, ORC_VAR_D4, self);
+    orc_executor_set_array (ex, ORC_VAR_S1, a);
+    orc_executor_set_array (ex, ORC_VAR_S2, b);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      int c = i % N_CASES;
+
+      if (mul[2*i] != cases[c].mul[0] || mul[2*i+1] != cases[c].mul[1] ||
+          mulconj[2*i] != cases[c].mulconj[0] ||
+          mulconj[2*i+1] != cases[c].mulconj[1] ||
+          magsq[i] != cases[c].magsq ||
+          self[2*i] != cases[c].magsq || self[2*i+1] != 0) {
+        printf("n %d, element %d: (%g,%g) (%g,%g) %g (%g,%g), expected "
+            "(%g,%g) (%g,%g) %g (%g,0)%s\n", n, i, mul[2*i], mul[2*i+1],
+            mulconj[2*i], mulconj[2*i+1], magsq[i], self[2*i], self[2*i+1],
+            cases[c].mul[0], cases[c].mul[1], cases[c].mulconj[0],
+            cases[c].mulconj[1], cases[c].magsq, cases[c].magsq,
+            emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+    if (n < N && (mul[2*n] != 0 || magsq[n] != 0)) {
+      printf("n %d: element %d written%s\n", n, n,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 2, 3, 7, 8, 15, 16, 17, 33, N };
+  OrcProgram **programs;
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  if (orc_parse (".function complex_test\n"
+      ".dest 8 d1\n"
+      ".dest 8 d2\n"
+      ".dest 4 d3\n"
+      ".dest 8 d4\n"
+      ".source 8 s1\n"
+      ".source 8 s2\n"
+      "\n"
+      "mulcf d1, s1, s2\n"
+      "mulconjcf d2, s1, s2\n"
+      "magsqcf d3, s1\n"
+      "mulconjcf d4, s1, s1\n", &programs) != 1) {
+    printf("failed to parse\n");
+    exit (1);
+  }
+  orc_program_compile (programs[0]);
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    check (programs[0], ns[i]);
+  }
+
+  orc_program_free (programs[0]);
+  free (programs);
+
+  if (error) return 1;
+  return 0;
+}
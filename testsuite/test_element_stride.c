@@ -0,0 +1,98 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Gathers every stride'th element of a source into a packed
+ * destination, and scatters a packed source the same way.  Elements
+ * between the strided ones, and after the last, keep their fill. */
+
+#define N 130
+#define FILL 0xa5
+
+int error = FALSE;
+
+static void
+check (int size, int stride, int strided_dest, int n)
+{
+  static const char *opcodes[] = { "copyb", "copyw", "copyl", "copyq" };
+  int len = (N * stride + 1) * size;
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 *src, *dest, *ref;
+  int emulate;
+  int i;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_set_var_element_stride (p,
+      strided_dest ? ORC_VAR_D1 : ORC_VAR_S1, stride);
+  orc_program_append_ds_str (p, opcodes[size == 8 ? 3 : size / 2], "d1",
+      "s1");
+  orc_program_compile (p);
+
+  src = malloc (len);
+  dest = malloc (len);
+  ref = malloc (len);
+  for(i=0;i<len;i++){
+    src[i] = i * 7 + (i >> 8);
+  }
+  memset (ref, FILL, len);
+  for(i=0;i<n;i++){
+    int from = strided_dest ? i : i * stride;
+    int to = strided_dest ? i * stride : i;
+
+    memcpy (ref + to * size, src + from * size, size);
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (dest, FILL, len);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, dest);
+    orc_executor_set_array (ex, ORC_VAR_S1, src);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (dest, ref, len) != 0) {
+      printf("%s size %d stride %d n %d: mismatch%s\n",
+          strided_dest ? "scatter" : "gather", size, stride, n,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  free (src);
+  free (dest);
+  free (ref);
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 2, 7, 16, 17, 33, N };
+  int i, size, stride;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(size=1;size<=8;size*=2){
+      for(stride=1;stride<=8;stride++){
+        check (size, stride, FALSE, ns[i]);
+        check (size, stride, TRUE, ns[i]);
+      }
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
@@ -0,0 +1,170 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* A search returns the index of the first match, or n if there is
+ * none, for matches anywhere in the call, including the first and last
+ * element, compiled and emulated. */
+
+#define N 1031
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (const char *code)
+{
+  OrcProgram **programs;
+  int n;
+
+  n = orc_parse (code, &programs);
+  if (n != 1) {
+    printf("failed to parse\n");
+    exit (1);
+  }
+  return programs[0];
+}
+
+static void
+check (OrcProgram *p, const char *name, void *s, int n, int ref)
+{
+  OrcExecutor *ex;
+  int emulate;
+  int result;
+
+  for(emulate=0;emulate<2;emulate++){
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_param (ex, ORC_VAR_P1, 100);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    result = orc_executor_get_accumulator (ex, ORC_VAR_A1);
+    if (result != ref) {
+      printf("%s n %d: got %d, expected %d%s\n", name, n, result, ref,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+    orc_executor_free (ex);
+  }
+}
+
+/* first byte equal to 'x' */
+static void
+test_byte (int n, int pos)
+{
+  static OrcProgram *p;
+  orc_uint8 *s;
+  int i;
+
+  if (p == NULL) {
+    p = create_program (".function find_byte\n"
+        ".source 1 s1\n"
+        ".accumulator 4 a1\n"
+        ".temp 1 t1\n"
+        "\n"
+        "cmpeqb t1, s1, 120\n"
+        "findb a1, t1\n");
+    orc_program_compile (p);
+  }
+
+  s = malloc (N);
+  for(i=0;i<N;i++){
+    s[i] = 'a' + (i % 23);
+    if (s[i] == 'x') s[i] = 'y';
+  }
+  if (pos < N) s[pos] = 'x';
+  /* a later match doesn't count */
+  if (pos + 3 < N) s[pos + 3] = 'x';
+  check (p, "byte", s, n, pos < n ? pos : n);
+  free (s);
+}
+
+/* first sample above a threshold */
+static void
+test_threshold (int n, int pos)
+{
+  static OrcProgram *p;
+  orc_int16 *s;
+  int i;
+
+  if (p == NULL) {
+    p = create_program (".function find_threshold\n"
+        ".source 2 s1\n"
+        ".accumulator 4 a1\n"
+        ".param 2 p1\n"
+        ".temp 2 t1\n"
+        "\n"
+        "cmpgtsw t1, s1, p1\n"
+        "findw a1, t1\n");
+    orc_program_compile (p);
+  }
+
+  s = malloc (N * 2);
+  for(i=0;i<N;i++){
+    s[i] = (i * 37) % 200 - 100;
+  }
+  if (pos < N) s[pos] = 101;
+  check (p, "threshold", s, n, pos < n ? pos : n);
+  free (s);
+}
+
+/* length of a run of zeros */
+static void
+test_zero_run (int n, int pos)
+{
+  static OrcProgram *p;
+  orc_int32 *s;
+  int i;
+
+  if (p == NULL) {
+    p = create_program (".function find_zero_run\n"
+        ".source 4 s1\n"
+        ".accumulator 4 a1\n"
+        "\n"
+        "findl a1, s1\n");
+    orc_program_compile (p);
+  }
+
+  s = malloc (N * 4);
+  memset (s, 0, N * 4);
+  for(i=pos;i<N;i++){
+    s[i] = (i & 1) ? 0x10000 : 0;
+  }
+  if (pos < N) s[pos] = 1;
+  check (p, "zero run", s, n, pos < n ? pos : n);
+  free (s);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 2, 3, 5, 8, 15, 16, 17, 31, 33, 64, 100,
+    255, 256, 257, N };
+  int i;
+  int pos;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(pos=0;pos<=ns[i];pos+=(ns[i] > 40) ? 7 : 1){
+      test_byte (ns[i], pos);
+      test_threshold (ns[i], pos);
+      test_zero_run (ns[i], pos);
+    }
+    test_byte (ns[i], ns[i] - 1);
+    test_threshold (ns[i], ns[i] - 1);
+    test_zero_run (ns[i], ns[i] - 1);
+  }
+
+  if (error) return 1;
+  return 0;
+}
+
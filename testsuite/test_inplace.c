@@ -0,0 +1,216 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ORC_ENABLE_UNSTABLE_API
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* An in-place program writing over its source matches a scalar
+ * reference for n across the vector sizes and any element offset, in
+ * 1D and 2D and after a round trip through bytecode.  Programs that
+ * would read an element after it is written are rejected, and with
+ * debugging on, calls with different arrays are emulated. */
+
+#define M 7
+#define STRIDE 2100
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (int is_2d)
+{
+  OrcProgram **programs;
+  char code[400];
+  int n;
+
+  sprintf (code,
+      ".function inplace_test\n"
+      "%s"
+      ".dest 2 d1\n"
+      ".source 2 s1\n"
+      ".source 2 s2\n"
+      ".temp 2 t1\n"
+      ".inplace d1 s1\n"
+      "\n"
+      "mullw t1, s1, s2\n"
+      "addssw t1, t1, s1\n"
+      "subw d1, t1, s2\n",
+      is_2d ? ".flags 2d\n" : "");
+
+  n = orc_parse (code, &programs);
+  if (n != 1) {
+    printf("failed to parse\n");
+    exit (1);
+  }
+  return programs[0];
+}
+
+static orc_int16
+ref_op (orc_int16 a, orc_int16 b)
+{
+  int x = (orc_int16)(a * b) + a;
+  if (x < -32768) x = -32768;
+  if (x > 32767) x = 32767;
+  return x - b;
+}
+
+static void
+fill (orc_int16 *a, orc_int16 *b, int separate)
+{
+  int i;
+  for(i=0;i<STRIDE*M/2;i++){
+    a[i] = i * 1217 - 3000;
+    if (separate) a[i] ^= 0x5555;
+    if (b) b[i] = i * 73 + (i >> 3) - 40;
+  }
+}
+
+static void
+check (OrcProgram *p, const char *name, int n, int m, int offset,
+    int separate)
+{
+  OrcExecutor *ex;
+  orc_int16 *d, *s1, *s2, *ref;
+  int emulate;
+  int i, j;
+
+  d = malloc (STRIDE * M);
+  s1 = malloc (STRIDE * M);
+  s2 = malloc (STRIDE * M);
+  ref = malloc (STRIDE * M);
+
+  fill (ref, s2, FALSE);
+  fill (s1, NULL, separate);
+  for(j=0;j<m;j++){
+    orc_int16 *r = ORC_PTR_OFFSET (ref, j * STRIDE + offset * 2);
+    orc_int16 *a = ORC_PTR_OFFSET (s1, j * STRIDE + offset * 2);
+    orc_int16 *b = ORC_PTR_OFFSET (s2, j * STRIDE);
+    for(i=0;i<n;i++){
+      r[i] = ref_op (a[i], b[i]);
+    }
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    fill (d, NULL, FALSE);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_m (ex, m);
+    orc_executor_set_array (ex, ORC_VAR_D1, d + offset);
+    orc_executor_set_stride (ex, ORC_VAR_D1, STRIDE);
+    orc_executor_set_array (ex, ORC_VAR_S1, (separate ? s1 : d) + offset);
+    orc_executor_set_stride (ex, ORC_VAR_S1, STRIDE);
+    orc_executor_set_array (ex, ORC_VAR_S2, s2);
+    orc_executor_set_stride (ex, ORC_VAR_S2, STRIDE);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (d, ref, STRIDE * M) != 0) {
+      printf("%s n %d m %d offset %d%s: mismatch\n", name, n, m, offset,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  free (d);
+  free (s1);
+  free (s2);
+  free (ref);
+}
+
+static void
+test_rejected (void)
+{
+  OrcProgram **programs;
+  OrcProgram *p;
+  int n;
+
+  /* the source would be read after the destination is written */
+  n = orc_parse (".function inplace_late\n"
+      ".dest 2 d1\n"
+      ".dest 2 d2\n"
+      ".source 2 s1\n"
+      ".source 2 s2\n"
+      ".inplace d1 s1\n"
+      "\n"
+      "copyw d1, s2\n"
+      "addw d2, s1, s2\n", &programs);
+  if (n != 1) {
+    printf("failed to parse\n");
+    exit (1);
+  }
+  if (!ORC_COMPILE_RESULT_IS_FATAL (orc_program_compile (programs[0]))) {
+    printf("late read of in-place source not rejected\n");
+    error = TRUE;
+  }
+  orc_program_free (programs[0]);
+  free (programs);
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, 2, "d1");
+  orc_program_add_source (p, 1, "s1");
+  orc_program_set_inplace (p, ORC_VAR_D1, ORC_VAR_S1);
+  if (orc_program_get_error (p)[0] == 0) {
+    printf("in-place variables of different size not rejected\n");
+    error = TRUE;
+  }
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 8, 15, 16, 17, 33, 100, 1000 };
+  OrcProgram *p, *p2d, *pbc;
+  OrcBytecode *bytecode;
+  int level;
+  int i, k;
+
+  orc_init ();
+  orc_test_init ();
+
+  p = create_program (FALSE);
+  orc_program_compile (p);
+  p2d = create_program (TRUE);
+  orc_program_compile (p2d);
+
+  bytecode = orc_bytecode_from_program (p);
+  pbc = orc_program_new ();
+  orc_bytecode_parse_function (pbc, bytecode->bytecode);
+  orc_bytecode_free (bytecode);
+  orc_program_compile (pbc);
+  if (!pbc->vars[ORC_VAR_S1].inplace ||
+      pbc->vars[ORC_VAR_S1].inplace_dest != ORC_VAR_D1) {
+    printf("in-place declaration lost in bytecode\n");
+    error = TRUE;
+  }
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(k=0;k<8;k++){
+      check (p, "1d", ns[i], 1, k, FALSE);
+      check (pbc, "bytecode", ns[i], 1, k, FALSE);
+      check (p2d, "2d", ns[i], M, k, FALSE);
+    }
+  }
+
+  test_rejected ();
+
+  /* with debugging on, calls breaking the declaration are emulated */
+  level = orc_debug_get_level ();
+  if (level < ORC_DEBUG_WARNING) orc_debug_set_level (ORC_DEBUG_WARNING);
+  check (p, "separate", 100, 1, 1, TRUE);
+  check (p2d, "separate 2d", 100, M, 1, TRUE);
+  orc_debug_set_level (level);
+
+  orc_program_free (p);
+  orc_program_free (p2d);
+  orc_program_free (pbc);
+
+  if (error) return 1;
+  return 0;
+}
+
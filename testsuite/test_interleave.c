@@ -0,0 +1,163 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Splits packed 3- and 4-channel pixels into planes with loadch and
+ * packs three planes back with storech3, starting at an odd pixel so
+ * the vector loads are misaligned.  The bytes around the packed
+ * destination must be left alone. */
+
+#define N 100
+#define GUARD 16
+
+int error = FALSE;
+
+static void
+check_load (const char *opcode, int n_channels, int size, int n, int offset)
+{
+  int psize = n_channels * size;
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 *s, *d[4];
+  int emulate;
+  int i, k;
+
+  p = orc_program_new ();
+  orc_program_add_source (p, psize, "s1");
+  for(k=0;k<n_channels;k++){
+    char name[4];
+    int c;
+
+    sprintf (name, "d%d", k + 1);
+    orc_program_add_destination (p, size, name);
+    sprintf (name, "c%d", k + 1);
+    c = orc_program_add_constant (p, 4, k, name);
+    orc_program_append_2 (p, opcode, 0, ORC_VAR_D1 + k, ORC_VAR_S1, c, -1);
+  }
+  orc_program_compile (p);
+
+  s = malloc ((N + 1) * psize);
+  for(i=0;i<(N+1)*psize;i++){
+    s[i] = i * 29 + (i >> 8);
+  }
+  for(k=0;k<n_channels;k++){
+    d[k] = malloc (N * size);
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_S1, s + offset * psize);
+    for(k=0;k<n_channels;k++){
+      memset (d[k], 0, N * size);
+      orc_executor_set_array (ex, ORC_VAR_D1 + k, d[k]);
+    }
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(k=0;k<n_channels;k++){
+      for(i=0;i<n;i++){
+        if (memcmp (d[k] + i * size, s + (offset + i) * psize + k * size,
+              size) != 0) {
+          printf("%s n %d offset %d: channel %d of pixel %d wrong%s\n",
+              opcode, n, offset, k, i, emulate ? " (emulated)" : "");
+          error = TRUE;
+          break;
+        }
+      }
+    }
+  }
+
+  for(k=0;k<n_channels;k++){
+    free (d[k]);
+  }
+  free (s);
+  orc_program_free (p);
+}
+
+static void
+check_store (const char *opcode, int size, int n, int offset)
+{
+  orc_uint8 s[3][N * 2];
+  orc_uint8 d[GUARD + (N + 1) * 6 + GUARD], ref[sizeof(d)];
+  OrcProgram *p;
+  OrcExecutor *ex;
+  int emulate;
+  int i, k;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, 3 * size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_source (p, size, "s2");
+  orc_program_add_source (p, size, "s3");
+  orc_program_append_str_2 (p, opcode, 0, "d1", "s1", "s2", "s3");
+  orc_program_compile (p);
+
+  for(i=0;i<N*size;i++){
+    for(k=0;k<3;k++){
+      s[k][i] = i * 7 + k * 85;
+    }
+  }
+  memset (ref, 0xa5, sizeof(ref));
+  for(i=0;i<n;i++){
+    for(k=0;k<3;k++){
+      memcpy (ref + GUARD + (offset + i * 3 + k) * size, s[k] + i * size,
+          size);
+    }
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0xa5, sizeof(d));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, d + GUARD + offset * size);
+    orc_executor_set_array (ex, ORC_VAR_S1, s[0]);
+    orc_executor_set_array (ex, ORC_VAR_S2, s[1]);
+    orc_executor_set_array (ex, ORC_VAR_S3, s[2]);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (d, ref, sizeof(d)) != 0) {
+      printf("%s n %d offset %d: mismatch%s\n", opcode, n, offset,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 8, 15, 16, 17, 33, N };
+  int i, offset;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(offset=0;offset<2;offset++){
+      check_load ("loadch3b", 3, 1, ns[i], offset);
+      check_load ("loadch4b", 4, 1, ns[i], offset);
+      check_load ("loadch3w", 3, 2, ns[i], offset);
+      check_load ("loadch4w", 4, 2, ns[i], offset);
+      check_store ("storech3b", 1, ns[i], offset);
+      check_store ("storech3w", 2, ns[i], offset);
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
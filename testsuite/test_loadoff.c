@@ -0,0 +1,103 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* The offset of loadoff is an immediate, so it must not narrow the
+ * vector: byte and word loads with an offset run as wide as plain ones.
+ * Offsets that do or do not keep the alignment of the source must both
+ * read the right elements. */
+
+int error = FALSE;
+
+static void
+test_loadoff (int size, int offset)
+{
+  static const char *loadoff[] = { "loadoffb", "loadoffw", "", "loadoffl" };
+  static const char *add[] = { "addb", "addw", "", "addl" };
+  OrcProgram *p;
+  char name[40];
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_constant (p, 4, offset, "c1");
+  orc_program_add_temporary (p, size, "t1");
+  sprintf (name, "test_%s_%d", loadoff[size - 1], offset);
+  orc_program_set_name (p, name);
+
+  /* s1 is also read directly, so it gets aligned when d1 can be */
+  orc_program_append_str (p, loadoff[size - 1], "t1", "s1", "c1");
+  orc_program_append_str (p, add[size - 1], "d1", "s1", "t1");
+
+  if (!orc_test_compare_output_full (p, 0)) {
+    printf("%s offset %d: test failed\n", loadoff[size - 1], offset);
+    error = TRUE;
+  }
+
+  orc_program_free (p);
+}
+
+/* On SSE the loop steps over a whole 16-byte vector of each size */
+static void
+test_width (int size)
+{
+  static const char *loadoff[] = { "loadoffb", "loadoffw", "", "loadoffl" };
+  OrcTarget *target = orc_target_get_default ();
+  OrcCompileResult result;
+  OrcProgram *p;
+  char s[40];
+  int shift;
+
+  if (target == NULL || strcmp (orc_target_get_name (target), "sse") != 0 ||
+      !(orc_target_get_default_flags (target) & ORC_TARGET_SSE_SSE2)) {
+    return;
+  }
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_constant (p, 4, 1, "c1");
+  orc_program_append_str (p, loadoff[size - 1], "d1", "s1", "c1");
+
+  /* nothing to check when the code is emulated */
+  result = orc_program_compile (p);
+  if (ORC_COMPILE_RESULT_IS_FATAL (result)) {
+    printf("%s: failed to compile\n", loadoff[size - 1]);
+    error = TRUE;
+  } else if (ORC_COMPILE_RESULT_IS_SUCCESSFUL (result)) {
+    for(shift=0;(size<<shift)<16;shift++);
+    sprintf (s, "# LOOP SHIFT %d\n", shift);
+    if (strstr (orc_program_get_asm_code (p), s) == NULL) {
+      printf("%s: loop is narrower than %d elements\n", loadoff[size - 1],
+          1 << shift);
+      error = TRUE;
+    }
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int offsets[] = { -33, -16, -3, -1, 1, 3, 4, 15, 16, 17, 33 };
+  int i, size;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(size=1;size<=4;size*=2){
+    for(i=0;i<sizeof(offsets)/sizeof(offsets[0]);i++){
+      test_loadoff (size, offsets[i]);
+    }
+    test_width (size);
+  }
+
+  if (error) return 1;
+  return 0;
+}
+
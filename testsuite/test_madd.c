@@ -0,0 +1,181 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Known results of the pairwise multiply-adds at the edges of their
+ * ranges: maddswl wraps the one sum that does not fit in 32 bits, and
+ * maddusbw saturates to 16 bits.  The cases repeat along the array, so
+ * every lane of the vector loop and the tail sees each of them.  A
+ * 4-tap FIR checks maddswl with packed constant taps. */
+
+#define N 67
+
+int error = FALSE;
+
+static const struct {
+  orc_int16 a[2], b[2];
+  orc_int32 result;
+} maddswl_cases[] = {
+  { { -32768, -32768 }, { -32768, -32768 }, (orc_int32)0x80000000 },
+  { { 32767, 32767 }, { 32767, 32767 }, 2147352578 },
+  { { -32768, 32767 }, { 32767, -32768 }, -2147418112 },
+  { { -32768, -32768 }, { 32767, 32767 }, -2147418112 },
+  { { 1, -1 }, { 1, 1 }, 0 },
+  { { 100, 200 }, { 3, 4 }, 1100 },
+  { { -1, 0 }, { -1, 5 }, 1 }
+};
+
+static const struct {
+  orc_uint8 a[2];
+  orc_int8 b[2];
+  orc_int16 result;
+} maddusbw_cases[] = {
+  { { 255, 255 }, { 127, 127 }, 32767 },
+  { { 255, 255 }, { -128, -128 }, -32768 },
+  { { 255, 1 }, { -128, 127 }, -32513 },
+  { { 0, 255 }, { -128, 127 }, 32385 },
+  { { 200, 100 }, { -1, 2 }, 0 },
+  { { 128, 128 }, { 127, 1 }, 16384 }
+};
+
+#define N_SWL (sizeof(maddswl_cases)/sizeof(maddswl_cases[0]))
+#define N_USBW (sizeof(maddusbw_cases)/sizeof(maddusbw_cases[0]))
+
+static void
+check (const char *opcode, int dsize, int n)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_int16 a[2 * N], b[2 * N];
+  orc_uint8 ua[2 * N];
+  orc_int8 sb[2 * N];
+  orc_int32 d32[N];
+  orc_int16 d16[N];
+  int swl = (dsize == 4);
+  int emulate;
+  int i;
+
+  p = orc_program_new_dss (dsize, dsize, dsize);
+  orc_program_append_str (p, opcode, "d1", "s1", "s2");
+  orc_program_compile (p);
+
+  for(i=0;i<2*n;i++){
+    a[i] = maddswl_cases[(i / 2) % N_SWL].a[i & 1];
+    b[i] = maddswl_cases[(i / 2) % N_SWL].b[i & 1];
+    ua[i] = maddusbw_cases[(i / 2) % N_USBW].a[i & 1];
+    sb[i] = maddusbw_cases[(i / 2) % N_USBW].b[i & 1];
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d32, 0, sizeof(d32));
+    memset (d16, 0, sizeof(d16));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, swl ? (void *)d32 : (void *)d16);
+    orc_executor_set_array (ex, ORC_VAR_S1, swl ? (void *)a : (void *)ua);
+    orc_executor_set_array (ex, ORC_VAR_S2, swl ? (void *)b : (void *)sb);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      int result = swl ? d32[i] : d16[i];
+      int expected = swl ? maddswl_cases[i % N_SWL].result :
+        maddusbw_cases[i % N_USBW].result;
+
+      if (result != expected) {
+        printf("%s n %d, element %d: got %d, expected %d%s\n", opcode, n, i,
+            result, expected, emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+  }
+
+  orc_program_free (p);
+}
+
+/* d[i] = s[2i] * -1200 + s[2i+1] * 9000 + s[2i+2] * 9000 + s[2i+3] * -1200,
+ * with s2 two samples ahead of s1 */
+static void
+check_fir (int n)
+{
+  static const orc_int16 taps[4] = { -1200, 9000, 9000, -1200 };
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_int16 s[2 * N + 2];
+  orc_int32 d[N];
+  int emulate;
+  int i, k;
+
+  p = orc_program_new_dss (4, 4, 4);
+  orc_program_add_constant (p, 4, 0x2328fb50, "c1");
+  orc_program_add_constant (p, 4, 0xfb502328, "c2");
+  orc_program_add_temporary (p, 4, "t1");
+  orc_program_add_temporary (p, 4, "t2");
+  orc_program_append_str (p, "maddswl", "t1", "s1", "c1");
+  orc_program_append_str (p, "maddswl", "t2", "s2", "c2");
+  orc_program_append_str (p, "addl", "d1", "t1", "t2");
+  orc_program_compile (p);
+
+  for(i=0;i<2*N+2;i++){
+    s[i] = (i * 2654435761u) >> 16;
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, sizeof(d));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_array (ex, ORC_VAR_S2, s + 2);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      orc_int32 expected = 0;
+
+      for(k=0;k<4;k++){
+        expected += s[2 * i + k] * taps[k];
+      }
+      if (d[i] != expected) {
+        printf("fir n %d, element %d: got %d, expected %d%s\n", n, i, d[i],
+            expected, emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 7, 16, 17, 33, N };
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    check ("maddswl", 4, ns[i]);
+    check ("maddusbw", 2, ns[i]);
+    check_fir (ns[i]);
+  }
+
+  if (error) return 1;
+  return 0;
+}
@@ -0,0 +1,135 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Unpacks the b-bit fields of a 32-bit source into the 8 byte or 4 word
+ * lanes of the destination, zero past bit 31, and packs the low b bits
+ * of each lane back, for every field width.  The first source is
+ * 0x87654321, which unpacks to 1, 2, ... 8 with 4-bit fields. */
+
+#define N 40
+
+int error = FALSE;
+
+static orc_uint32
+field (orc_uint64 x, int k, int width)
+{
+  return (x >> (k * width)) & ((1u << width) - 1);
+}
+
+static void
+check (int lane_bits, int width, int flags, int n)
+{
+  int lanes = 64 / lane_bits;
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint32 s[N], packed[N];
+  orc_uint16 unpacked[N * 4], lanes_in[N * 4];
+  int emulate;
+  int i, k;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, 8, "d1");
+  orc_program_add_destination (p, 4, "d2");
+  orc_program_add_source (p, 4, "s1");
+  orc_program_add_source (p, 8, "s2");
+  orc_program_add_constant (p, 4, width, "c1");
+  orc_program_append_str (p, (lane_bits == 8) ? "unpacklb" : "unpacklw",
+      "d1", "s1", "c1");
+  orc_program_append_str (p, (lane_bits == 8) ? "packbl" : "packwl",
+      "d2", "s2", "c1");
+  orc_program_compile_full (p, orc_target_get_default (), flags);
+
+  for(i=0;i<N;i++){
+    s[i] = i ? i * 2654435761u : 0x87654321;
+  }
+  for(i=0;i<N*8;i++){
+    ((orc_uint8 *)lanes_in)[i] = i * 151 + (i >> 3) * 17;
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (unpacked, 0, sizeof(unpacked));
+    memset (packed, 0, sizeof(packed));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, unpacked);
+    orc_executor_set_array (ex, ORC_VAR_D2, packed);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_array (ex, ORC_VAR_S2, lanes_in);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      orc_uint64 x = 0;
+
+      for(k=0;k<lanes;k++){
+        orc_uint32 u, lane;
+
+        if (lane_bits == 8) {
+          u = ((orc_uint8 *)unpacked)[i * 8 + k];
+          lane = ((orc_uint8 *)lanes_in)[i * 8 + k];
+        } else {
+          u = unpacked[i * 4 + k];
+          lane = lanes_in[i * 4 + k];
+        }
+        if (u != field (s[i], k, width)) {
+          printf("unpack to %d lanes, width %d, flags 0x%x, n %d: "
+              "element %d lane %d is 0x%x%s\n", lanes, width, flags, n, i, k,
+              u, emulate ? " (emulated)" : "");
+          error = TRUE;
+        }
+        x |= (orc_uint64)field (lane, 0, width) << (k * width);
+      }
+      if (packed[i] != (orc_uint32)x) {
+        printf("pack from %d lanes, width %d, flags 0x%x, n %d: "
+            "element %d is 0x%08x, expected 0x%08x%s\n", lanes, width, flags,
+            n, i, packed[i], (orc_uint32)x, emulate ? " (emulated)" : "");
+        error = TRUE;
+      }
+    }
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 4, 5, 8, 17, N };
+  OrcTarget *target;
+  int flags[2];
+  int n_flags = 1;
+  int i, j, width;
+
+  orc_init ();
+  orc_test_init ();
+
+  target = orc_target_get_default ();
+  flags[0] = orc_target_get_default_flags (target);
+  /* also the rules without pshufb */
+  if (strcmp (orc_target_get_name (target), "sse") == 0 &&
+      (flags[0] & ORC_TARGET_SSE_SSSE3)) {
+    flags[n_flags++] = flags[0] & ~(ORC_TARGET_SSE_SSSE3 |
+        ORC_TARGET_SSE_SSE4_1 | ORC_TARGET_SSE_SSE4_2);
+  }
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(j=0;j<n_flags;j++){
+      for(width=1;width<=16;width++){
+        if (width <= 8) check (8, width, flags[j], ns[i]);
+        check (16, width, flags[j], ns[i]);
+      }
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
@@ -0,0 +1,142 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* A call reading and writing ring buffers must give the same results
+ * as a scalar loop that wraps the indexes, for any ring size, start and
+ * n, including calls that wrap more than once, compiled and emulated.
+ * Accumulators are summed over the whole call. */
+
+#define N 1031
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (int dest_ring, int src_ring)
+{
+  OrcProgram **programs;
+  char code[400];
+  int n;
+
+  sprintf (code,
+      ".function ring_test\n"
+      ".dest 2 d1%s\n"
+      ".source 2 s1%s\n"
+      ".source 2 s2\n"
+      ".accumulator 4 a1\n"
+      ".temp 4 t1\n"
+      "\n"
+      "addssw d1, s1, s2\n"
+      "convswl t1, s1\n"
+      "accl a1, t1\n",
+      dest_ring ? " ring" : "", src_ring ? " ring" : "");
+
+  n = orc_parse (code, &programs);
+  if (n != 1) {
+    printf("failed to parse\n");
+    exit (1);
+  }
+  return programs[0];
+}
+
+static void
+check (int dest_ring, int src_ring, int dsize, int dstart, int ssize,
+    int sstart, int n)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_int16 *d, *ref, *s1, *s2;
+  int ref_acc;
+  int mode;
+  int i;
+
+  p = create_program (dest_ring, src_ring);
+  orc_program_compile (p);
+
+  d = malloc (N * 2);
+  ref = malloc (N * 2);
+  s1 = malloc (N * 2);
+  s2 = malloc (N * 2);
+  for(i=0;i<N;i++){
+    s1[i] = i * 1217 - 3000;
+    s2[i] = i * 73 + (i >> 3);
+  }
+
+  memset (ref, 0, N * 2);
+  ref_acc = 0;
+  for(i=0;i<n;i++){
+    int a = s1[src_ring ? (sstart + i) % ssize : i];
+    int x = a + s2[i];
+    if (x < -32768) x = -32768;
+    if (x > 32767) x = 32767;
+    ref[dest_ring ? (dstart + i) % dsize : i] = x;
+    ref_acc += a;
+  }
+
+  for(mode=0;mode<3;mode++){
+    memset (d, 0, N * 2);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_S1, s1);
+    orc_executor_set_array (ex, ORC_VAR_S2, s2);
+    if (dest_ring) orc_executor_set_ring (ex, ORC_VAR_D1, dsize, dstart);
+    if (src_ring) orc_executor_set_ring (ex, ORC_VAR_S1, ssize, sstart);
+    if (mode == 1) {
+      orc_executor_emulate (ex);
+    } else {
+      /* orcc wrappers that set the program leave arrays[ORC_VAR_A2]
+       * uninitialized */
+      if (mode == 2) ex->arrays[ORC_VAR_A2] = s2;
+      orc_executor_run (ex);
+    }
+    if (memcmp (d, ref, N * 2) != 0 ||
+        orc_executor_get_accumulator (ex, ORC_VAR_A1) != ref_acc) {
+      printf("dest %d/%d source %d/%d n %d%s: mismatch\n",
+          dest_ring ? dsize : 0, dstart, src_ring ? ssize : 0, sstart, n,
+          (mode == 1) ? " (emulated)" : "");
+      error = TRUE;
+    }
+    orc_executor_free (ex);
+  }
+
+  free (d);
+  free (ref);
+  free (s1);
+  free (s2);
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 2, 3, 5, 8, 15, 16, 17, 31, 33, 64, 100 };
+  static const int sizes[] = { 1, 7, 16, 61, 100 };
+  int i, j, k;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(j=0;j<sizeof(sizes)/sizeof(sizes[0]);j++){
+      int size = sizes[j];
+
+      for(k=0;k<size;k+=(size > 8) ? size / 5 : 1){
+        check (FALSE, TRUE, 0, 0, size, k, ns[i]);
+        /* a destination written more than once keeps the last pass */
+        check (TRUE, FALSE, size, k, 0, 0, ns[i]);
+        check (TRUE, TRUE, 100, (k * 7) % 100, size, k, ns[i]);
+      }
+    }
+  }
+  /* a long call over a short delay line */
+  check (TRUE, TRUE, 997, 500, 61, 60, N);
+
+  if (error) return 1;
+  return 0;
+}
+
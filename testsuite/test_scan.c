@@ -0,0 +1,179 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* The running sum is carried from one vector to the next and restarts
+ * at each row, so n crosses the vector sizes here; adding the previous
+ * output row gives an integral image. */
+
+#define N 1031
+#define M 13
+#define STRIDE (N + 5)
+
+int error = FALSE;
+
+static void
+check_scan (const char *name, int size, int n)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  unsigned char *s, *d, *ref;
+  int emulate;
+  int i, j;
+
+  p = orc_program_new ();
+  orc_program_set_2d (p);
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_append_ds_str (p, name, "d1", "s1");
+  orc_program_compile (p);
+
+  s = malloc (STRIDE * size * M);
+  d = malloc (STRIDE * size * M);
+  ref = malloc (STRIDE * size * M);
+  memset (ref, 0, STRIDE * size * M);
+  for(j=0;j<M;j++){
+    orc_uint32 sum = 0;
+    float fsum = 0;
+
+    for(i=0;i<n;i++){
+      int x = j * STRIDE + i;
+
+      if (size == 2) {
+        ((orc_uint16 *)s)[x] = x * 997 + (x >> 3);
+        sum += ((orc_uint16 *)s)[x];
+        ((orc_uint16 *)ref)[x] = sum;
+      } else if (strcmp (name, "scanaddl") == 0) {
+        ((orc_uint32 *)s)[x] = x * 2654435761u;
+        sum += ((orc_uint32 *)s)[x];
+        ((orc_uint32 *)ref)[x] = sum;
+      } else {
+        ((float *)s)[x] = ((x * 37) % 201 - 100) * 0.01f;
+        fsum += ((float *)s)[x];
+        ((float *)ref)[x] = fsum;
+      }
+    }
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, STRIDE * size * M);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_m (ex, M);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_stride (ex, ORC_VAR_D1, STRIDE * size);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_stride (ex, ORC_VAR_S1, STRIDE * size);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (d, ref, STRIDE * size * M) != 0) {
+      printf("%s n %d%s: mismatch\n", name, n, emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  free (s);
+  free (d);
+  free (ref);
+  orc_program_free (p);
+}
+
+/* d[j][i] = sum of s over rows 0..j and columns 0..i */
+static void
+check_integral_image (int n)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 *s;
+  orc_uint32 *d, *ref;
+  int emulate;
+  int i, j;
+
+  p = orc_program_new ();
+  orc_program_set_2d (p);
+  orc_program_add_destination (p, 4, "d1");
+  orc_program_add_source (p, 1, "s1");
+  orc_program_add_source (p, 4, "s2");
+  orc_program_add_temporary (p, 2, "t1");
+  orc_program_add_temporary (p, 4, "t2");
+  orc_program_append_ds_str (p, "convubw", "t1", "s1");
+  orc_program_append_ds_str (p, "convuwl", "t2", "t1");
+  orc_program_append_ds_str (p, "scanaddl", "t2", "t2");
+  orc_program_append_str (p, "addl", "d1", "t2", "s2");
+  orc_program_compile (p);
+
+  /* all arrays share the stride */
+  s = malloc (STRIDE * 4 * M);
+  for(i=0;i<STRIDE*4*M;i++){
+    s[i] = (i * 73) ^ (i >> 5);
+  }
+  /* one row of zeros above the image */
+  d = malloc (STRIDE * 4 * (M + 1));
+  ref = malloc (STRIDE * 4 * (M + 1));
+  memset (ref, 0, STRIDE * 4 * (M + 1));
+  for(j=0;j<M;j++){
+    orc_uint32 sum = 0;
+    for(i=0;i<n;i++){
+      sum += s[j * STRIDE * 4 + i];
+      ref[(j + 1) * STRIDE + i] = ref[j * STRIDE + i] + sum;
+    }
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, STRIDE * 4 * (M + 1));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_m (ex, M);
+    orc_executor_set_array (ex, ORC_VAR_D1, d + STRIDE);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_array (ex, ORC_VAR_S2, d);
+    orc_executor_set_stride (ex, ORC_VAR_D1, STRIDE * 4);
+    orc_executor_set_stride (ex, ORC_VAR_S1, STRIDE * 4);
+    orc_executor_set_stride (ex, ORC_VAR_S2, STRIDE * 4);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (d, ref, STRIDE * 4 * (M + 1)) != 0) {
+      printf("integral image n %d%s: mismatch\n", n,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  free (s);
+  free (d);
+  free (ref);
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 2, 3, 5, 8, 15, 16, 17, 31, 33, 64, N };
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    check_scan ("scanaddw", 2, ns[i]);
+    check_scan ("scanaddl", 4, ns[i]);
+    check_scan ("scanaddf", 4, ns[i]);
+    check_integral_image (ns[i]);
+  }
+
+  if (error) return 1;
+  return 0;
+}
+
@@ -0,0 +1,166 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* One program per type selects by the sign bit of s1 into d1, with the
+ * mask also as the first or second source into d2 and d3, and takes
+ * the maximum of s1 and s2 through a comparison into d4.  On SSE it
+ * also runs without SSE4.1, where blends are built from and/andn/or. */
+
+#define N 100
+
+int error = FALSE;
+
+static const struct {
+  int size;
+  const char *select;
+  const char *compare;
+} types[] = {
+  { 1, "selectb", "cmpgtsb" },
+  { 2, "selectw", "cmpgtsw" },
+  { 4, "selectl", "cmpgtsl" },
+  { 4, "selectf", "cmpltf" },
+  { 8, "selectd", "cmpltd" }
+};
+
+static double
+get (const orc_uint8 *p, int type)
+{
+  switch (type) {
+    case 0: return *(const orc_int8 *)p;
+    case 1: return *(const orc_int16 *)p;
+    case 2: return *(const orc_int32 *)p;
+    case 3: return *(const float *)p;
+    default: return *(const double *)p;
+  }
+}
+
+static void
+check (int type, int flags, int n)
+{
+  const char *select = types[type].select;
+  int size = types[type].size;
+  int is_float = (type >= 3);
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 s[3][N * 8], d[4][N * 8];
+  int emulate;
+  int i, k;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_destination (p, size, "d2");
+  orc_program_add_destination (p, size, "d3");
+  orc_program_add_destination (p, size, "d4");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_source (p, size, "s2");
+  orc_program_add_source (p, size, "s3");
+  orc_program_add_temporary (p, size, "t1");
+  orc_program_append_str_2 (p, select, 0, "d1", "s1", "s2", "s3");
+  orc_program_append_str_2 (p, select, 0, "d2", "s1", "s1", "s3");
+  orc_program_append_str_2 (p, select, 0, "d3", "s1", "s2", "s1");
+  /* t1 = s1 > s2, written as s2 < s1 for floats */
+  orc_program_append_str (p, types[type].compare, "t1",
+      is_float ? "s2" : "s1", is_float ? "s1" : "s2");
+  orc_program_append_str_2 (p, select, 0, "d4", "t1", "s1", "s2");
+  orc_program_compile_full (p, orc_target_get_default (), flags);
+
+  for(i=0;i<N;i++){
+    /* whole numbers of either sign as floats, to keep NaNs out of the
+     * comparison; the first mask is -0 */
+    float fa = i ? ((i * 37) % 201 - 100) * 0.5f : -0.0f;
+    float fb = ((i * 53) % 199 - 99) * 0.5f;
+    double da = fa, db = fb;
+
+    if (type == 3) {
+      memcpy (s[0] + i * 4, &fa, 4);
+      memcpy (s[1] + i * 4, &fb, 4);
+    } else if (type == 4) {
+      memcpy (s[0] + i * 8, &da, 8);
+      memcpy (s[1] + i * 8, &db, 8);
+    } else {
+      /* the lower bytes of a mask have the other sign bit, little endian */
+      for(k=0;k<size;k++){
+        s[0][i * size + k] = (i * 37) ^ ((k == size - 1) ? 0 : 0x80 | k);
+        s[1][i * size + k] = i * 101 + k * 7;
+      }
+    }
+  }
+  for(i=0;i<N*8;i++){
+    s[2][i] = i * 59 + (i >> 5) * 3;
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, sizeof(d));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    for(k=0;k<4;k++){
+      orc_executor_set_array (ex, ORC_VAR_D1 + k, d[k]);
+    }
+    for(k=0;k<3;k++){
+      orc_executor_set_array (ex, ORC_VAR_S1 + k, s[k]);
+    }
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      const orc_uint8 *x1 = s[0] + i * size;
+      const orc_uint8 *x2 = s[1] + i * size;
+      const orc_uint8 *x3 = s[2] + i * size;
+      int negative = x1[size - 1] & 0x80;
+      const orc_uint8 *ref[4];
+
+      ref[0] = negative ? x2 : x3;
+      ref[1] = negative ? x1 : x3;
+      ref[2] = negative ? x2 : x1;
+      ref[3] = (get (x1, type) > get (x2, type)) ? x1 : x2;
+      for(k=0;k<4;k++){
+        if (memcmp (d[k] + i * size, ref[k], size) != 0) {
+          printf("%s flags 0x%x n %d: d%d element %d wrong%s\n",
+              select, flags, n, k + 1, i,
+              emulate ? " (emulated)" : "");
+          error = TRUE;
+          i = n;
+        }
+      }
+    }
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 15, 16, 17, 33, N };
+  OrcTarget *target;
+  int flags;
+  int i, type;
+
+  orc_init ();
+  orc_test_init ();
+
+  target = orc_target_get_default ();
+  flags = orc_target_get_default_flags (target);
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(type=0;type<sizeof(types)/sizeof(types[0]);type++){
+      check (type, flags, ns[i]);
+      if (strcmp (orc_target_get_name (target), "sse") == 0 &&
+          (flags & ORC_TARGET_SSE_SSE4_1)) {
+        check (type, flags & ~ORC_TARGET_SSE_SSE4_1, ns[i]);
+      }
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
@@ -0,0 +1,118 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Nibble k of the permutation picks the source byte for destination
+ * byte k, and an index past the element gives zero.  The permutations
+ * are the usual channel reorders and byte swaps, plus splats and
+ * cleared bytes. */
+
+#define N 100
+
+int error = FALSE;
+
+static void
+check (int size, orc_uint32 perm, int flags, int n)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 s[N * 8], d[N * 8];
+  int emulate;
+  int i, k;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_constant (p, 4, perm, "c1");
+  orc_program_append_str (p, (size == 4) ? "shufflel" : "shuffleq", "d1",
+      "s1", "c1");
+  orc_program_compile_full (p, orc_target_get_default (), flags);
+
+  for(i=0;i<N*size;i++){
+    s[i] = i * 73 + (i >> 6) + 1;
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, sizeof(d));
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n*size;i++){
+      int j = (perm >> (4 * (i % size))) & 0xf;
+      int expected = (j < size) ? s[i - i % size + j] : 0;
+
+      if (d[i] != expected) {
+        printf("size %d perm 0x%x flags 0x%x n %d: byte %d is 0x%02x, "
+            "expected 0x%02x%s\n", size, perm, flags, n, i, d[i], expected,
+            emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+    for(k=n*size;k<N*size;k++){
+      if (d[k] != 0) {
+        printf("size %d perm 0x%x n %d: byte %d written%s\n", size, perm, n,
+            k, emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+  }
+
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 3, 4, 15, 16, 17, N };
+  /* identity, RGBA to BGRA, to ARGB, to ABGR, splat, alpha cleared,
+   * all cleared */
+  static const orc_uint32 perms4[] = { 0x3210, 0x3012, 0x2103, 0x0123,
+    0x0000, 0xf210, 0xffff };
+  /* identity, swapq, swaplq, swapwl, every other byte cleared, splat */
+  static const orc_uint32 perms8[] = { 0x76543210, 0x01234567, 0x32107654,
+    0x54761032, 0xf6f4f2f0, 0x00000000 };
+  OrcTarget *target;
+  int flags[2];
+  int n_flags = 1;
+  int i, j, k;
+
+  orc_init ();
+  orc_test_init ();
+
+  target = orc_target_get_default ();
+  flags[0] = orc_target_get_default_flags (target);
+  /* also the rules without pshufb */
+  if (strcmp (orc_target_get_name (target), "sse") == 0 &&
+      (flags[0] & ORC_TARGET_SSE_SSSE3)) {
+    flags[n_flags++] = flags[0] & ~(ORC_TARGET_SSE_SSSE3 |
+        ORC_TARGET_SSE_SSE4_1 | ORC_TARGET_SSE_SSE4_2);
+  }
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(j=0;j<n_flags;j++){
+      for(k=0;k<sizeof(perms4)/sizeof(perms4[0]);k++){
+        check (4, perms4[k], flags[j], ns[i]);
+      }
+      for(k=0;k<sizeof(perms8)/sizeof(perms8[0]);k++){
+        check (8, perms8[k], flags[j], ns[i]);
+      }
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
@@ -0,0 +1,123 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Filters with 3 to 9 loadoff taps of one source, combined alternately
+ * with add and xor so that swapping two taps changes the result.  The
+ * sparse tap set repeats an offset and goes backwards, which a window
+ * built from consecutive offsets must still get right. */
+
+#define N 200
+#define PAD 16
+
+int error = FALSE;
+
+static void
+check (int size, int n_taps, const int *offsets, int n)
+{
+  static const char *types = "bw l";
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 *src, *dest;
+  char op[20], name[20];
+  int emulate;
+  int i, k;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_temporary (p, size, "t1");
+  orc_program_add_temporary (p, size, "t2");
+  for(k=0;k<n_taps;k++){
+    /* offset 0 is a plain load, which keeps 9 taps within 8 constants */
+    if (offsets[k] == 0) {
+      sprintf (op, "copy%c", types[size - 1]);
+      orc_program_append_ds_str (p, op, k ? "t2" : "t1", "s1");
+    } else {
+      sprintf (name, "c%d", k);
+      orc_program_add_constant (p, 4, offsets[k], name);
+      sprintf (op, "loadoff%c", types[size - 1]);
+      orc_program_append_str (p, op, k ? "t2" : "t1", "s1", name);
+    }
+    if (k > 0) {
+      sprintf (op, "%s%c", (k & 1) ? "add" : "xor", types[size - 1]);
+      orc_program_append_str (p, op, "t1", "t1", "t2");
+    }
+  }
+  sprintf (op, "copy%c", types[size - 1]);
+  orc_program_append_ds_str (p, op, "d1", "t1");
+  orc_program_compile (p);
+
+  src = malloc ((N + 2 * PAD) * size);
+  for(i=0;i<(N+2*PAD)*size;i++){
+    src[i] = i * 13 + (i >> 7);
+  }
+  dest = malloc (N * size);
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (dest, 0, N * size);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_array (ex, ORC_VAR_D1, dest);
+    orc_executor_set_array (ex, ORC_VAR_S1, src + PAD * size);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    for(i=0;i<n;i++){
+      orc_uint32 x = 0, y = 0;
+
+      for(k=0;k<n_taps;k++){
+        orc_uint32 v = 0;
+
+        memcpy (&v, src + (PAD + i + offsets[k]) * size, size);
+        x = (k == 0) ? v : (k & 1) ? x + v : x ^ v;
+      }
+      memcpy (&y, dest + i * size, size);
+      if (memcmp (&x, &y, size) != 0) {
+        printf("size %d, %d taps from %d, n %d: element %d is 0x%x, "
+            "expected 0x%x%s\n", size, n_taps, offsets[0], n, i, y, x,
+            emulate ? " (emulated)" : "");
+        error = TRUE;
+        break;
+      }
+    }
+  }
+
+  free (src);
+  free (dest);
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int ns[] = { 1, 5, 16, 17, 31, 64, N };
+  static const int taps3[] = { 0, 1, 2 };
+  static const int taps5[] = { -2, -1, 0, 1, 2 };
+  static const int taps9[] = { -4, -3, -2, -1, 0, 1, 2, 3, 4 };
+  static const int sparse[] = { 3, -1, 0, 3, 1 };
+  int i, size;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(ns)/sizeof(ns[0]);i++){
+    for(size=1;size<=4;size*=2){
+      check (size, 3, taps3, ns[i]);
+      check (size, 5, taps5, ns[i]);
+      check (size, 9, taps9, ns[i]);
+      check (size, 5, sparse, ns[i]);
+    }
+  }
+
+  if (error) return 1;
+  return 0;
+}
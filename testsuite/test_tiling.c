@@ -0,0 +1,125 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* 2D programs processed in column strips must give the same results as
+ * row-by-row processing, including when a source is the next row of
+ * another source, and for accumulators. */
+
+#define N 20011
+#define M 17
+#define STRIDE (N + 37)
+
+int error = FALSE;
+
+static OrcProgram *
+create_program (int tiling)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_name (p, "tiling_avg_sad");
+  orc_program_set_2d (p);
+  orc_program_set_2d_tiling (p, tiling);
+  orc_program_add_destination (p, 1, "d1");
+  orc_program_add_source (p, 1, "s1");
+  orc_program_add_source (p, 1, "s2");
+  orc_program_add_accumulator (p, 4, "a1");
+
+  orc_program_append (p, "avgub", ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_S2);
+  orc_program_append (p, "accsadubl", ORC_VAR_A1, ORC_VAR_S1, ORC_VAR_S2);
+
+  return p;
+}
+
+static void
+check (int tiling, int n)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 *d, *ref, *s;
+  int ref_acc;
+  int emulate;
+  int i, j;
+
+  d = malloc (STRIDE * M + 1);
+  ref = malloc (STRIDE * M + 1);
+  s = malloc (STRIDE * (M + 1) + 3);
+  for(i=0;i<STRIDE*(M+1)+3;i++){
+    s[i] = (i * 73) ^ (i >> 5);
+  }
+
+  memset (ref, 0, STRIDE * M + 1);
+  ref_acc = 0;
+  for(j=0;j<M;j++){
+    for(i=0;i<n;i++){
+      int a = s[3 + j*STRIDE + i];
+      int b = s[3 + (j+1)*STRIDE + i];
+      ref[1 + j*STRIDE + i] = (a + b + 1) >> 1;
+      ref_acc += (a > b) ? a - b : b - a;
+    }
+  }
+
+  p = create_program (tiling);
+  orc_program_compile (p);
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, STRIDE * M + 1);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_m (ex, M);
+    orc_executor_set_array (ex, ORC_VAR_D1, d + 1);
+    orc_executor_set_stride (ex, ORC_VAR_D1, STRIDE);
+    orc_executor_set_array (ex, ORC_VAR_S1, s + 3);
+    orc_executor_set_stride (ex, ORC_VAR_S1, STRIDE);
+    /* the next row of s1 */
+    orc_executor_set_array (ex, ORC_VAR_S2, s + 3 + STRIDE);
+    orc_executor_set_stride (ex, ORC_VAR_S2, STRIDE);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+
+    if (memcmp (d, ref, STRIDE * M + 1) != 0 ||
+        orc_executor_get_accumulator (ex, ORC_VAR_A1) != ref_acc) {
+      printf("tiling %d n %d: %s mismatch\n", tiling, n,
+          emulate ? "emulation" : "compiled");
+      error = TRUE;
+    }
+    /* n is restored after the last strip */
+    if (ex->n != n) {
+      printf("tiling %d n %d: n changed to %d\n", tiling, n, ex->n);
+      error = TRUE;
+    }
+    orc_executor_free (ex);
+  }
+
+  orc_program_free (p);
+  free (d);
+  free (ref);
+  free (s);
+}
+
+int
+main (int argc, char *argv[])
+{
+  orc_init ();
+  orc_test_init ();
+
+  check (ORC_TILING_NONE, N);
+  check (ORC_TILING_AUTO, N);
+  check (ORC_TILING_AUTO, 100);
+  check (64, N);
+  check (64, 64);
+  check (64, 65);
+  check (4096, N);
+
+  if (error) return 1;
+  return 0;
+}
+
@@ -0,0 +1,142 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* The polynomial approximations used by expf, logf, sinf, cosf and
+ * powf must stay within their documented error of the exact result,
+ * both compiled and emulated. */
+
+#define N 65536
+
+int error = FALSE;
+
+static double
+ulp_error (float x, double ref)
+{
+  float r = (float)ref;
+
+  if (fabs (ref) < 1.17549435e-38) return (fabsf (x) < 1.17549435e-38f) ? 0 : 1e9;
+  if (isinf (r)) return (x == r) ? 0 : 1e9;
+  return fabs (x - ref) / ldexp (1.0, ilogb (r) - 23);
+}
+
+static void
+check (const char *name, int n_src, double max_ulp, float *s1, float *s2)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  float *d;
+  double err, max_err;
+  int emulate;
+  int i;
+
+  p = orc_program_new ();
+  orc_program_add_destination (p, 4, "d1");
+  orc_program_add_source (p, 4, "s1");
+  if (n_src == 2) {
+    orc_program_add_source (p, 4, "s2");
+    orc_program_append (p, name, ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_S2);
+  } else {
+    orc_program_append_ds (p, name, ORC_VAR_D1, ORC_VAR_S1);
+  }
+  orc_program_compile (p);
+
+  d = malloc (N * sizeof(float));
+  for(emulate=0;emulate<2;emulate++){
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, N);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_array (ex, ORC_VAR_S1, s1);
+    orc_executor_set_array (ex, ORC_VAR_S2, s2);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+
+    max_err = 0;
+    for(i=0;i<N;i++){
+      double ref;
+
+      if (strcmp (name, "expf") == 0) ref = exp (s1[i]);
+      else if (strcmp (name, "logf") == 0) ref = log (s1[i]);
+      else if (strcmp (name, "sinf") == 0) ref = sin (s1[i]);
+      else if (strcmp (name, "cosf") == 0) ref = cos (s1[i]);
+      else ref = pow (s1[i], s2[i]);
+
+      err = ulp_error (d[i], ref);
+      if (err > max_err) max_err = err;
+      if (err > max_ulp) {
+        printf("%s%s: %g %g gives %g, expected %g (%g ulp)\n", name,
+            emulate ? " (emulated)" : "", s1[i], s2[i], d[i], ref, err);
+        error = TRUE;
+        break;
+      }
+    }
+    printf("%s%s: max error %g ulp\n", name, emulate ? " (emulated)" : "",
+        max_err);
+  }
+
+  free (d);
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  float *s1, *s2;
+  unsigned int seed = 1;
+  int i;
+
+  orc_init ();
+  orc_test_init ();
+
+  s1 = malloc (N * sizeof(float));
+  s2 = malloc (N * sizeof(float));
+
+  for(i=0;i<N;i++){
+    s1[i] = -87.0f + 175.0f * i / N;
+    s2[i] = 0;
+  }
+  check ("expf", 1, 1.0, s1, s2);
+
+  for(i=0;i<N;i++){
+    union { orc_uint32 i; float f; } u;
+    /* all positive normal floats */
+    u.i = 0x00800000 + i * (0x7f000000 / N);
+    s1[i] = u.f;
+  }
+  check ("logf", 1, 1.0, s1, s2);
+
+  for(i=0;i<N;i++){
+    s1[i] = ldexp (2.0 * i / N - 1.0, 22);
+  }
+  check ("sinf", 1, 2.0, s1, s2);
+  check ("cosf", 1, 2.0, s1, s2);
+  for(i=0;i<N;i++){
+    s1[i] = 10.0f * i / N;
+  }
+  check ("sinf", 1, 2.0, s1, s2);
+  check ("cosf", 1, 2.0, s1, s2);
+
+  for(i=0;i<N;i++){
+    seed = seed * 1664525 + 1013904223;
+    s1[i] = ((seed >> 8) + 1) * (4.0f / 16777216.0f);
+    seed = seed * 1664525 + 1013904223;
+    s2[i] = ((int)seed >> 8) * (20.0f / 8388608.0f);
+  }
+  check ("powf", 2, 1.0, s1, s2);
+
+  free (s1);
+  free (s2);
+
+  if (error) return 1;
+  return 0;
+}
+
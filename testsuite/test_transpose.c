@@ -0,0 +1,189 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <orc/orc.h>
+#include <orc-test/orctest.h>
+
+/* Row j of a 2D program reading a transposed source sees column j of
+ * the source, for any element size, n and m, in column strips or not,
+ * compiled and emulated.  The source is read both through an explicit
+ * loadtr and implicitly by an operation on a variable marked
+ * transposed.  On SSE, blocks of rows are transposed in registers next
+ * to sources that are not transposed. */
+
+#define N 77
+#define M 45
+#define STRIDE 1024
+
+int error = FALSE;
+
+static const char *loadtr_names[] = { "loadtrb", "loadtrw", NULL, "loadtrl",
+  NULL, NULL, NULL, "loadtrq" };
+static const char *copy_names[] = { "copyb", "copyw", NULL, "copyl",
+  NULL, NULL, NULL, "copyq" };
+static const char *add_names[] = { "addb", "addw", NULL, "addl",
+  NULL, NULL, NULL, "addq" };
+
+static OrcProgram *
+create_program (int size, int implicit, int tiling)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_2d (p);
+  orc_program_set_2d_tiling (p, tiling);
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  if (implicit) {
+    orc_program_set_var_transposed (p, ORC_VAR_S1);
+    orc_program_append_str (p, copy_names[size-1], "d1", "s1", NULL);
+  } else {
+    orc_program_add_temporary (p, size, "t1");
+    orc_program_append_str (p, loadtr_names[size-1], "t1", "s1", NULL);
+    orc_program_append_str (p, copy_names[size-1], "d1", "t1", NULL);
+  }
+
+  return p;
+}
+
+static void
+check (int size, int implicit, int tiling, int n, int m)
+{
+  OrcProgram *p;
+  OrcExecutor *ex;
+  orc_uint8 *s, *d, *ref;
+  int emulate;
+  int i, j, k;
+
+  p = create_program (size, implicit, tiling);
+  orc_program_compile (p);
+
+  /* n rows of at least m elements, read as m rows of n elements */
+  s = malloc (STRIDE * N);
+  d = malloc (STRIDE * N);
+  ref = malloc (STRIDE * N);
+  for(i=0;i<STRIDE*N;i++){
+    s[i] = i * 73 + (i >> 9) + 1;
+  }
+  memset (ref, 0, STRIDE * N);
+  for(j=0;j<m;j++){
+    for(i=0;i<n;i++){
+      for(k=0;k<size;k++){
+        ref[j * STRIDE + i * size + k] = s[i * STRIDE + j * size + k];
+      }
+    }
+  }
+
+  for(emulate=0;emulate<2;emulate++){
+    memset (d, 0, STRIDE * N);
+    ex = orc_executor_new (p);
+    orc_executor_set_n (ex, n);
+    orc_executor_set_m (ex, m);
+    orc_executor_set_array (ex, ORC_VAR_D1, d);
+    orc_executor_set_stride (ex, ORC_VAR_D1, STRIDE);
+    orc_executor_set_array (ex, ORC_VAR_S1, s);
+    orc_executor_set_stride (ex, ORC_VAR_S1, STRIDE);
+    if (emulate) {
+      orc_executor_emulate (ex);
+    } else {
+      orc_executor_run (ex);
+    }
+    orc_executor_free (ex);
+    if (memcmp (d, ref, STRIDE * N) != 0) {
+      printf("size %d%s tiling %d n %d m %d%s: mismatch\n", size,
+          implicit ? " implicit" : "", tiling, n, m,
+          emulate ? " (emulated)" : "");
+      error = TRUE;
+    }
+  }
+
+  free (s);
+  free (d);
+  free (ref);
+  orc_program_free (p);
+}
+
+static OrcProgram *
+create_block_program (int size)
+{
+  OrcProgram *p;
+
+  p = orc_program_new ();
+  orc_program_set_2d (p);
+  orc_program_add_destination (p, size, "d1");
+  orc_program_add_source (p, size, "s1");
+  orc_program_add_source (p, size, "s2");
+  orc_program_add_temporary (p, size, "t1");
+  orc_program_append_str (p, loadtr_names[size-1], "t1", "s1", NULL);
+  orc_program_append_str (p, add_names[size-1], "d1", "t1", "s2");
+
+  return p;
+}
+
+static void
+test_block (int size)
+{
+  OrcTarget *target = orc_target_get_default ();
+  OrcCompileResult result;
+  OrcProgram *p;
+  char s[40];
+
+  p = create_block_program (size);
+  if (!orc_test_compare_output_full (p, 0)) {
+    printf("size %d block: test failed\n", size);
+    error = TRUE;
+  }
+  orc_program_free (p);
+
+  /* the register transpose is SSE only, and not there when the code is
+   * emulated */
+  if (target == NULL || strcmp (orc_target_get_name (target), "sse") != 0 ||
+      !(orc_target_get_default_flags (target) & ORC_TARGET_SSE_SSE2)) {
+    return;
+  }
+
+  p = create_block_program (size);
+  result = orc_program_compile (p);
+  if (ORC_COMPILE_RESULT_IS_FATAL (result)) {
+    printf("size %d block: failed to compile\n", size);
+    error = TRUE;
+  } else if (ORC_COMPILE_RESULT_IS_SUCCESSFUL (result)) {
+    sprintf (s, "# TRANSPOSE %d ROWS\n", 16 / size);
+    if (strstr (orc_program_get_asm_code (p), s) == NULL) {
+      printf("size %d block: columns are gathered\n", size);
+      error = TRUE;
+    }
+  }
+  orc_program_free (p);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const int sizes[] = { 1, 2, 4, 8 };
+  static const int ns[] = { 1, 2, 3, 5, 8, 15, 16, 17, 31, 33, 64, N };
+  static const int ms[] = { 1, 4, 16, 17, M };
+  static const int tilings[] = { ORC_TILING_NONE, ORC_TILING_AUTO, 16 };
+  int i, j, k, l;
+
+  orc_init ();
+  orc_test_init ();
+
+  for(i=0;i<sizeof(sizes)/sizeof(sizes[0]);i++){
+    for(j=0;j<sizeof(ns)/sizeof(ns[0]);j++){
+      for(k=0;k<sizeof(ms)/sizeof(ms[0]);k++){
+        for(l=0;l<sizeof(tilings)/sizeof(tilings[0]);l++){
+          check (sizes[i], FALSE, tilings[l], ns[j], ms[k]);
+          check (sizes[i], TRUE, tilings[l], ns[j], ms[k]);
+        }
+      }
+    }
+    test_block (sizes[i]);
+  }
+
+  if (error) return 1;
+  return 0;
+}
+
@@ -580,6 +580,10 @@ output_prototype (OrcProgram *p, FILE *output, int backup)
       if (p->is_2d) {
         fprintf(output, ", int %s_stride", varnames[ORC_VAR_D1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, ", int %s_ring_size, int %s_ring_start",
+            varnames[ORC_VAR_D1 + i], varnames[ORC_VAR_D1 + i]);
+      }
       need_comma = TRUE;
     }
   }
@@ -602,16 +606,22 @@ output_prototype (OrcProgram *p, FILE *output, int backup)
     if (var->size) {
       if (need_comma) fprintf(output, ", ");
       if (var->type_name) {
-        fprintf(output, "const %s * ORC_RESTRICT %s",
+        fprintf(output, "const %s *%s %s",
             orcify_typename(var->type_name),
+            var->inplace ? "" : " ORC_RESTRICT",
             varnames[ORC_VAR_S1 + i]);
       } else {
-        fprintf(output, "const orc_uint%d * ORC_RESTRICT %s", var->size*8,
+        fprintf(output, "const orc_uint%d *%s %s", var->size*8,
+            var->inplace ? "" : " ORC_RESTRICT",
             varnames[ORC_VAR_S1 + i]);
       }
       if (p->is_2d) {
         fprintf(output, ", int %s_stride", varnames[ORC_VAR_S1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, ", int %s_ring_size, int %s_ring_start",
+            varnames[ORC_VAR_S1 + i], varnames[ORC_VAR_S1 + i]);
+      }
       need_comma = TRUE;
     }
   }
@@ -667,6 +677,11 @@ output_executor_backup_call (OrcProgram *p, FILE *output)
       if (p->is_2d) {
         fprintf(output, "ex->params[%s], ", enumnames[ORC_VAR_D1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, "ORC_EXECUTOR_RING_SIZE(ex, %s), "
+            "ORC_EXECUTOR_RING_START(ex, %s), ",
+            enumnames[ORC_VAR_D1 + i], enumnames[ORC_VAR_D1 + i]);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -676,6 +691,11 @@ output_executor_backup_call (OrcProgram *p, FILE *output)
       if (p->is_2d) {
         fprintf(output, "  ex->params[%s], ", enumnames[ORC_VAR_S1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, "ORC_EXECUTOR_RING_SIZE(ex, %s), "
+            "ORC_EXECUTOR_RING_START(ex, %s), ",
+            enumnames[ORC_VAR_S1 + i], enumnames[ORC_VAR_S1 + i]);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -729,6 +749,10 @@ output_backup_call (OrcProgram *p, FILE *output)
       if (p->is_2d) {
         fprintf(output, "%s_stride, ", varnames[ORC_VAR_D1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, "%s_ring_size, %s_ring_start, ",
+            varnames[ORC_VAR_D1 + i], varnames[ORC_VAR_D1 + i]);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -738,6 +762,10 @@ output_backup_call (OrcProgram *p, FILE *output)
       if (p->is_2d) {
         fprintf(output, "%s_stride, ", varnames[ORC_VAR_S1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, "%s_ring_size, %s_ring_start, ",
+            varnames[ORC_VAR_S1 + i], varnames[ORC_VAR_S1 + i]);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -948,6 +976,12 @@ output_code_execute (OrcProgram *p, FILE *output, int is_inline)
         fprintf(output, "  ex->params[%s] = %s_stride;\n",
             enumnames[ORC_VAR_D1 + i], varnames[ORC_VAR_D1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, "  ORC_EXECUTOR_RING_SIZE(ex, %s) = %s_ring_size;\n",
+            enumnames[ORC_VAR_D1 + i], varnames[ORC_VAR_D1 + i]);
+        fprintf(output, "  ORC_EXECUTOR_RING_START(ex, %s) = %s_ring_start;\n",
+            enumnames[ORC_VAR_D1 + i], varnames[ORC_VAR_D1 + i]);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -959,6 +993,12 @@ output_code_execute (OrcProgram *p, FILE *output, int is_inline)
         fprintf(output, "  ex->params[%s] = %s_stride;\n",
             enumnames[ORC_VAR_S1 + i], varnames[ORC_VAR_S1 + i]);
       }
+      if (var->ring) {
+        fprintf(output, "  ORC_EXECUTOR_RING_SIZE(ex, %s) = %s_ring_size;\n",
+            enumnames[ORC_VAR_S1 + i], varnames[ORC_VAR_S1 + i]);
+        fprintf(output, "  ORC_EXECUTOR_RING_START(ex, %s) = %s_ring_start;\n",
+            enumnames[ORC_VAR_S1 + i], varnames[ORC_VAR_S1 + i]);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -1133,6 +1173,16 @@ output_program_generation (OrcProgram *p, FILE *output, int is_inline)
         fprintf(output, "      orc_program_add_destination (p, %d, \"%s\");\n",
             var->size, varnames[ORC_VAR_D1 + i]);
       }
+      if (var->element_stride > 1) {
+        REQUIRE(0,4,29,1);
+        fprintf(output, "      orc_program_set_var_element_stride (p, ORC_VAR_D%d, %d);\n",
+            i + 1, var->element_stride);
+      }
+      if (var->ring) {
+        REQUIRE(0,4,29,1);
+        fprintf(output, "      orc_program_set_var_ring (p, ORC_VAR_D%d);\n",
+            i + 1);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -1147,6 +1197,26 @@ output_program_generation (OrcProgram *p, FILE *output, int is_inline)
         fprintf(output, "      orc_program_add_source (p, %d, \"%s\");\n",
             var->size, varnames[ORC_VAR_S1 + i]);
       }
+      if (var->element_stride > 1) {
+        REQUIRE(0,4,29,1);
+        fprintf(output, "      orc_program_set_var_element_stride (p, ORC_VAR_S%d, %d);\n",
+            i + 1, var->element_stride);
+      }
+      if (var->transposed) {
+        REQUIRE(0,4,29,1);
+        fprintf(output, "      orc_program_set_var_transposed (p, ORC_VAR_S%d);\n",
+            i + 1);
+      }
+      if (var->ring) {
+        REQUIRE(0,4,29,1);
+        fprintf(output, "      orc_program_set_var_ring (p, ORC_VAR_S%d);\n",
+            i + 1);
+      }
+      if (var->inplace) {
+        REQUIRE(0,4,29,1);
+        fprintf(output, "      orc_program_set_inplace (p, ORC_VAR_D%d, ORC_VAR_S%d);\n",
+            var->inplace_dest - ORC_VAR_D1 + 1, i + 1);
+      }
     }
   }
   for(i=0;i<4;i++){
@@ -1323,6 +1393,14 @@ output_code_test (OrcProgram *p, FILE *output)
     if (var->size) {
       fprintf(output, "    orc_program_add_destination (p, %d, \"%s\");\n",
           var->size, varnames[ORC_VAR_D1 + i]);
+      if (var->element_stride > 1) {
+        fprintf(output, "    orc_program_set_var_element_stride (p, ORC_VAR_D%d, %d);\n",
+            i + 1, var->element_stride);
+      }
+      if (var->ring) {
+        fprintf(output, "    orc_program_set_var_ring (p, ORC_VAR_D%d);\n",
+            i + 1);
+      }
     }
   }
   for(i=0;i<8;i++){
@@ -1330,6 +1408,22 @@ output_code_test (OrcProgram *p, FILE *output)
     if (var->size) {
       fprintf(output, "    orc_program_add_source (p, %d, \"%s\");\n",
           var->size, varnames[ORC_VAR_S1 + i]);
+      if (var->element_stride > 1) {
+        fprintf(output, "    orc_program_set_var_element_stride (p, ORC_VAR_S%d, %d);\n",
+            i + 1, var->element_stride);
+      }
+      if (var->transposed) {
+        fprintf(output, "    orc_program_set_var_transposed (p, ORC_VAR_S%d);\n",
+            i + 1);
+      }
+      if (var->ring) {
+        fprintf(output, "    orc_program_set_var_ring (p, ORC_VAR_S%d);\n",
+            i + 1);
+      }
+      if (var->inplace) {
+        fprintf(output, "    orc_program_set_inplace (p, ORC_VAR_D%d, ORC_VAR_S%d);\n",
+            var->inplace_dest - ORC_VAR_D1 + 1, i + 1);
+      }
     }
   }
   for(i=0;i<4;i++){